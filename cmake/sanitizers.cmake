@@ -1,5 +1,13 @@
+option(NCE_THREAD_SANITIZER "Build Debug targets with ThreadSanitizer instead of AddressSanitizer" OFF)
+
 function(nce_set_sanitizers
         TARGET)
-    target_compile_options(${TARGET} INTERFACE $<$<CONFIG:Debug>:-fsanitize=address -fsanitize=leak -fsanitize=undefined>)
-    target_link_options(${TARGET} INTERFACE $<$<CONFIG:Debug>:-fsanitize=address -fsanitize=leak -fsanitize=undefined>)
+    if(NCE_THREAD_SANITIZER)
+        # TSan cannot be combined with ASan or LSan
+        target_compile_options(${TARGET} INTERFACE $<$<CONFIG:Debug>:-fsanitize=thread>)
+        target_link_options(${TARGET} INTERFACE $<$<CONFIG:Debug>:-fsanitize=thread>)
+    else()
+        target_compile_options(${TARGET} INTERFACE $<$<CONFIG:Debug>:-fsanitize=address -fsanitize=leak -fsanitize=undefined>)
+        target_link_options(${TARGET} INTERFACE $<$<CONFIG:Debug>:-fsanitize=address -fsanitize=leak -fsanitize=undefined>)
+    endif()
 endfunction()
@@ -3,33 +3,107 @@
 #include <fmt/format.h>
 
 #include <nce/window.hxx>
+#include <nce/frame_scheduler.hxx>
+#include <nce/fixed_step.hxx>
+#include <nce/viewer_state.hxx>
 #include <nce/vke.hxx>
 #include <render_api/instance.hxx>
 
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <sys/resource.h>
+
+namespace {
+    /// @brief Looks at the origin from the viewer's orbit, z up like the scene.
+    auto orbit_camera(const nce::ViewerState& view) -> vke::Camera {
+        f32 distance = static_cast<f32>(view.distance);
+        glm::vec3 eye = distance * glm::vec3(
+                static_cast<f32>(std::cos(view.pitch) * std::cos(view.yaw)),
+                static_cast<f32>(std::cos(view.pitch) * std::sin(view.yaw)),
+                static_cast<f32>(std::sin(view.pitch)));
+        return vke::Camera{eye, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, glm::radians(45.0f), 0.1f, distance + 10.0f};
+    }
+}
+
 auto main() -> i32
 {
     fmt::println("Hello world!");
-    auto xwindow = window::WindowBuilder()
+    // NCE_RECORD_INPUT=file writes every handled event on exit, NCE_REPLAY_INPUT=file plays one back
+    // instead of live input and exits at its end, one recorded frame per frame with NCE_REPLAY_SPEED=fast
+    const char* record_path = std::getenv("NCE_RECORD_INPUT");
+    const char* replay_path = std::getenv("NCE_REPLAY_INPUT");
+    const char* replay_speed = std::getenv("NCE_REPLAY_SPEED");
+    auto builder = window::WindowBuilder();
+    builder
         .with_name("N3DX")
         .with_bg_color(38, 38, 38)
         .with_resizable(true)
         .with_dimensions(1280, 720)
+        .with_input_thread(std::getenv("NCE_INPUT_THREAD") != nullptr)
         .with_position(1280/2, 720/2)
         .with_resize_callback([]([[maybe_unused]] u32 width, [[maybe_unused]] u32 height, void* user_data){
             fmt::println("Hello from resize callback");
             if (user_data) {
-                reinterpret_cast<vke::Instance*>(user_data)->frame_buffer_resized = true;
+                reinterpret_cast<vke::Viewport*>(user_data)->frame_buffer_resized = true;
             }
         })
-        .build();
+        .with_input_recording(record_path != nullptr);
+    if (replay_path) {
+        auto speed = replay_speed && std::strcmp(replay_speed, "fast") == 0 ? window::ReplaySpeed::fast : window::ReplaySpeed::realtime;
+        auto replay = window::InputReplay::open(replay_path, speed);
+        if (!replay) { fmt::println("Couldn't read the input log {}", replay_path); return 1; }
+        fmt::println("Replaying {} events over {} frames from {}", replay->size(), replay->recorded_frames(), replay_path);
+        builder.with_input_replay(std::move(*replay));
+    }
+    auto xwindow = builder.build();
+    fmt::println("window setup: {:.3f} ms (connect {:.3f}, requests {:.3f}, replies {:.3f}, keymap {:.3f})",
+            xwindow.setup_timings.total_ms, xwindow.setup_timings.connect_ms, xwindow.setup_timings.requests_ms,
+            xwindow.setup_timings.replies_ms, xwindow.setup_timings.keymap_ms);
     // render_api::create_instance(render_api::ENABLE_VALIDATION_LAYERS, { "VK_LAYER_KHRONOS_validation" }, window::Window::get_required_vulkan_extensions());
     // vke::Instance vkeinst(xwindow);
+    // a second window on the same device: vkeinst.add_window(other_xwindow).set_camera(...);
 
+    // what event handling costs the frame loop, e.g. while another window is dragged across this one
+    u64 frames = 0;
+    u64 exposes = 0;
+    u64 resizes = 0;
+    u64 round_trips = 0;
+    // pointer motion events and the frames they were coalesced into
+    u64 motion_events = 0;
+    u64 motion_frames = 0;
+    f64 poll_total_ms = 0.0;
+    f64 poll_max_ms = 0.0;
+    f64 frame_total_ms = 0.0;
+    f64 frame_max_ms = 0.0;
+    // only draw when something changed and sleep otherwise, NCE_CONTINUOUS=1 spins like before (and a replay always does)
+    nce::FrameScheduler scheduler(xwindow.wait_fd(), std::getenv("NCE_CONTINUOUS") != nullptr || replay_path != nullptr);
+    auto cpu_seconds = [] {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<f64>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + static_cast<f64>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    };
+    // scene updates run at a fixed 120 Hz on their own thread, frames blend the last two ticks
+    nce::SimulationThread<nce::ViewerState, nce::ViewerInput> simulation(nce::ViewerState{}, nce::step_viewer, {});
+    f64 cpu_begin = cpu_seconds();
+    auto loop_begin = std::chrono::steady_clock::now();
     while (!xwindow.should_close()) {
+        scheduler.wait(xwindow.has_pending_input());
+        auto frame_begin = std::chrono::steady_clock::now();
         xwindow.poll_events();
-        // vkeinst.draw_frame();
+        frames++;
+        exposes += xwindow.event_stats.exposes;
+        resizes += xwindow.event_stats.resizes;
+        round_trips += xwindow.event_stats.round_trips;
+        poll_total_ms += xwindow.event_stats.poll_ms;
+        poll_max_ms = std::max(poll_max_ms, xwindow.event_stats.poll_ms);
+        if (xwindow.event_stats.processed > xwindow.event_stats.exposes) { scheduler.damage(nce::Damage::input); }
+        if (xwindow.event_stats.resizes > 0) { scheduler.damage(nce::Damage::resize); }
+        if (xwindow.damaged) { scheduler.damage(nce::Damage::expose); }
+        nce::ViewerInput viewer_input;
         if (xwindow.keys.is_pressed(nce::KeyCode::space)) {
             fmt::println("Pressed space");
+            viewer_input.toggle_spin = true;
         }
         if (xwindow.keys.is_pressed(nce::KeyCode::q)) {
             fmt::println("q pressed");
@@ -60,7 +134,63 @@ auto main() -> i32
         if (xwindow.keys.is_down(nce::KeyCode::Control_L) && xwindow.keys.is_down(nce::KeyCode::Alt_L) && xwindow.keys.is_down(nce::KeyCode::Shift_L) && (xwindow.keys.is_pressed(nce::KeyCode::C) || xwindow.keys.is_pressed(nce::KeyCode::c))) {
             fmt::println("Ctrl + Alt + Shift + C");
         }
+        const auto& pointer = xwindow.pointer.frame();
+        if (pointer.motion_events > 0) {
+            motion_events += pointer.motion_events;
+            motion_frames++;
+        }
+        if (pointer.is_down(window::MouseButton::left) && (pointer.dx != 0 || pointer.dy != 0)) {
+            viewer_input.orbit_dx = pointer.dx;
+            viewer_input.orbit_dy = pointer.dy;
+        }
+        if (pointer.scroll_y != 0) {
+            viewer_input.zoom = pointer.scroll_y;
+        }
+        if (viewer_input.toggle_spin || viewer_input.orbit_dx != 0 || viewer_input.orbit_dy != 0 || viewer_input.zoom != 0) {
+            [[maybe_unused]] bool queued = simulation.submit(viewer_input);
+        }
+
+        const auto& tick = simulation.snapshot();
+        // a spinning scene changes every tick, refresh at the display rate while it does
+        if (tick.current.spin != 0.0 && !scheduler.animating()) { scheduler.start_animation(60.0); }
+        if (tick.current.spin == 0.0 && scheduler.animating()) { scheduler.stop_animation(); }
+        if (scheduler.begin_frame() != nce::Damage::none) {
+            const nce::ViewerState view = nce::blend_viewer(tick.previous, tick.current, tick.alpha(simulation.now_ns()));
+            [[maybe_unused]] f32 rotation = static_cast<f32>(view.rotation);
+            [[maybe_unused]] vke::Camera camera = orbit_camera(view);
+            // vkeinst.set_scene_rotation(rotation);
+            // vkeinst.set_camera(camera);
+            // vkeinst.draw_frame();
+            // presenting waits for replies on the window's connection
+            xwindow.notify_replies_read();
+            xwindow.damaged = false;
+        }
 
+        f64 frame_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - frame_begin).count();
+        frame_total_ms += frame_ms;
+        frame_max_ms = std::max(frame_max_ms, frame_ms);
+    }
+    f64 loop_s = std::chrono::duration<f64>(std::chrono::steady_clock::now() - loop_begin).count();
+    f64 cpu_s = cpu_seconds() - cpu_begin;
+    const auto& schedule = scheduler.stats();
+    fmt::println("frames: {}, mean {:.3f} ms, max {:.3f} ms", frames, frames > 0 ? frame_total_ms / static_cast<f64>(frames) : 0.0, frame_max_ms);
+    fmt::println("scheduler: {} drawn, {} skipped, {} wake-ups ({:.1f}/s), blocked {:.1f}% of the time, cpu {:.1f}% of a core",
+            schedule.frames, schedule.skipped, schedule.wakeups, loop_s > 0.0 ? static_cast<f64>(schedule.wakeups) / loop_s : 0.0,
+            loop_s > 0.0 ? schedule.blocked_ms / 10.0 / loop_s : 0.0, loop_s > 0.0 ? cpu_s * 100.0 / loop_s : 0.0);
+    fmt::println("simulation: {} ticks in {:.1f} s", simulation.ticks(), loop_s);
+    fmt::println("poll_events: {} frames, mean {:.4f} ms, max {:.3f} ms, {} exposes, {} resizes, {} round trips",
+            frames, frames > 0 ? poll_total_ms / static_cast<f64>(frames) : 0.0, poll_max_ms, exposes, resizes, round_trips);
+    fmt::println("pointer: {} motion events coalesced into {} frames", motion_events, motion_frames);
+    if (xwindow.input_thread) {
+        fmt::println("input latency: {} events, mean {:.3f} ms, max {:.3f} ms, {} dropped",
+                xwindow.input_latency.events, xwindow.input_latency.mean_ms(), xwindow.input_latency.max_ms, xwindow.input_thread->dropped());
+    }
+    if (xwindow.recorder) {
+        if (xwindow.recorder->write(record_path)) {
+            fmt::println("Recorded {} events over {} frames to {}", xwindow.recorder->events().size(), frames, record_path);
+        } else {
+            fmt::println("Couldn't write the input log {}", record_path);
+        }
     }
     // vkDeviceWaitIdle(vkeinst.logical_device.get());
     return 0;
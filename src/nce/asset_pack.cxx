@@ -0,0 +1,134 @@
+#include <nce/asset_pack.hxx>
+#include <nce/lz4_block.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+
+namespace {
+    auto align_up(u64 value, u64 alignment) -> u64 {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    template<typename T>
+    void append(std::vector<std::byte>& out, const T& value) {
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+namespace vke {
+    auto build_pack(std::vector<PackInput> inputs) -> std::vector<std::byte> {
+        std::ranges::sort(inputs, [](const PackInput& a, const PackInput& b) {
+            u64 hash_a = hash_asset_name(a.name), hash_b = hash_asset_name(b.name);
+            return hash_a != hash_b ? hash_a < hash_b : a.name < b.name;
+        });
+        for (size_t i = 1; i < inputs.size(); i++) {
+            if (inputs[i].name == inputs[i - 1].name) {
+                fmt::println("asset {} is packed twice", inputs[i].name);
+                std::abort();
+            }
+        }
+
+        std::vector<PackEntry> entries(inputs.size());
+        std::vector<std::vector<std::byte>> stored(inputs.size());
+        std::string names;
+        for (size_t i = 0; i < inputs.size(); i++) {
+            auto& input = inputs[i];
+            auto& entry = entries[i];
+            entry.name_hash = hash_asset_name(input.name);
+            entry.name_offset = static_cast<u32>(names.size());
+            entry.name_length = static_cast<u32>(input.name.size());
+            entry.size = input.data.size();
+            entry.compression = PackCompression::none;
+            names += input.name;
+            if (input.compress) {
+                auto compressed = lz4_compress(input.data);
+                if (compressed.size() <= input.data.size() - input.data.size() / 8) {
+                    entry.compression = PackCompression::lz4;
+                    stored[i] = std::move(compressed);
+                }
+            }
+            if (entry.compression == PackCompression::none) { stored[i] = std::move(input.data); }
+            entry.stored_size = stored[i].size();
+        }
+
+        u64 offset = align_up(sizeof(PackHeader) + entries.size() * sizeof(PackEntry) + names.size(), PACK_ALIGNMENT);
+        for (size_t i = 0; i < entries.size(); i++) {
+            entries[i].offset = offset;
+            offset = align_up(offset + entries[i].stored_size, PACK_ALIGNMENT);
+        }
+
+        std::vector<std::byte> pack;
+        pack.reserve(offset);
+        append(pack, PackHeader{PACK_MAGIC, PACK_VERSION, static_cast<u32>(entries.size()), static_cast<u32>(names.size())});
+        for (const auto& entry : entries) { append(pack, entry); }
+        const auto* name_bytes = reinterpret_cast<const std::byte*>(names.data());
+        pack.insert(pack.end(), name_bytes, name_bytes + names.size());
+        for (size_t i = 0; i < entries.size(); i++) {
+            pack.resize(entries[i].offset);
+            pack.insert(pack.end(), stored[i].begin(), stored[i].end());
+        }
+        return pack;
+    }
+
+    auto AssetPack::open(const std::filesystem::path& path) -> std::optional<AssetPack> {
+        auto file = MappedFile::open(path);
+        if (!file) { return std::nullopt; }
+        return from_file(std::move(*file));
+    }
+
+    auto AssetPack::from_file(MappedFile file) -> std::optional<AssetPack> {
+        auto bytes = file.bytes();
+        PackHeader header{};
+        if (bytes.size() < sizeof(header)) { return std::nullopt; }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic != PACK_MAGIC || header.version != PACK_VERSION) { return std::nullopt; }
+
+        u64 table_size = u64{header.entry_count} * sizeof(PackEntry);
+        if (bytes.size() - sizeof(header) < table_size + header.names_size) { return std::nullopt; }
+        AssetPack pack(std::move(file));
+        bytes = pack.file.bytes();
+        pack.table.resize(header.entry_count);
+        std::memcpy(pack.table.data(), bytes.data() + sizeof(header), table_size);
+        pack.names = std::string_view(reinterpret_cast<const char*>(bytes.data() + sizeof(header) + table_size), header.names_size);
+        for (const auto& entry : pack.table) {
+            bool name_fits = u64{entry.name_offset} + entry.name_length <= header.names_size;
+            bool data_fits = entry.offset <= bytes.size() && entry.stored_size <= bytes.size() - entry.offset;
+            bool known = entry.compression == PackCompression::none ? entry.stored_size == entry.size : entry.compression == PackCompression::lz4;
+            if (!name_fits || !data_fits || !known) { return std::nullopt; }
+        }
+        return pack;
+    }
+
+    auto AssetPack::find(std::string_view name) const -> const PackEntry* {
+        u64 hash = hash_asset_name(name);
+        auto it = std::ranges::lower_bound(table, hash, {}, &PackEntry::name_hash);
+        for (; it != table.end() && it->name_hash == hash; it++) {
+            if (this->name(*it) == name) { return &*it; }
+        }
+        return nullptr;
+    }
+
+    auto AssetPack::name(const PackEntry& entry) const -> std::string_view {
+        return names.substr(entry.name_offset, entry.name_length);
+    }
+
+    auto AssetPack::read(std::string_view name) const -> std::optional<Asset> {
+        const PackEntry* entry = find(name);
+        if (!entry) { return std::nullopt; }
+        auto stored = file.bytes().subspan(entry->offset, entry->stored_size);
+        Asset asset{};
+        if (entry->compression == PackCompression::none) {
+            asset.bytes = stored;
+            return asset;
+        }
+        asset.decompressed.resize(entry->size);
+        if (!lz4_decompress(stored, asset.decompressed)) {
+            fmt::println("asset {} is corrupt", name);
+            std::abort();
+        }
+        asset.bytes = asset.decompressed;
+        return asset;
+    }
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <nce/asset_pack.hxx>
+
+#include <fstream>
+#include <unistd.h>
+
+/**
+ *  Loading the engine's assets as loose files against loading them from a pack.
+ *  Not registered with ctest. Both sides open everything from scratch per run and read every byte,
+ *  the compressed pack includes decompressing the model. The page cache is warm after the first run.
+ */
+
+namespace {
+    const std::array<std::string, 3> ASSETS = { "assets/models/viking_room.obj", "assets/models/viking_room.png", "assets/texture.jpg" };
+
+    auto checksum(std::span<const std::byte> bytes) -> u64 {
+        u64 sum = 0;
+        for (std::byte b : bytes) { sum += static_cast<u64>(b); }
+        return sum;
+    }
+}
+
+TEST_CASE( "Loading assets from loose files and from a pack", "[!benchmark][asset_pack]" ) {
+    std::filesystem::path root = NCE_SOURCE_DIR;
+    auto write_pack = [&](std::string_view name, bool compress) {
+        std::vector<vke::PackInput> inputs;
+        for (const auto& asset : ASSETS) {
+            auto file = vke::MappedFile::open(root / asset);
+            REQUIRE(file.has_value());
+            inputs.push_back({ asset, std::vector<std::byte>(file->bytes().begin(), file->bytes().end()), compress });
+        }
+        auto path = std::filesystem::temp_directory_path() / fmt::format("nce_{}_{}.pack", getpid(), name);
+        auto pack = vke::build_pack(std::move(inputs));
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(pack.data()), static_cast<std::streamsize>(pack.size()));
+        return path;
+    };
+    auto read_pack = [](const std::filesystem::path& path) {
+        u64 sum = 0;
+        auto pack = vke::AssetPack::open(path);
+        for (const auto& name : ASSETS) {
+            sum += checksum(pack->read(name)->bytes);
+        }
+        return sum;
+    };
+    auto stored_path = write_pack("stored", false);
+    auto compressed_path = write_pack("lz4", true);
+
+    BENCHMARK("loose files") {
+        u64 sum = 0;
+        for (const auto& name : ASSETS) {
+            auto file = vke::MappedFile::open(root / name);
+            sum += checksum(file->bytes());
+        }
+        return sum;
+    };
+    BENCHMARK("asset pack, stored") {
+        return read_pack(stored_path);
+    };
+    BENCHMARK("asset pack, lz4 where it pays") {
+        return read_pack(compressed_path);
+    };
+    std::filesystem::remove(stored_path);
+    std::filesystem::remove(compressed_path);
+}
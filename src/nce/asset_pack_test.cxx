@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/asset_pack.hxx>
+
+#include <fstream>
+#include <random>
+#include <unistd.h>
+
+
+namespace {
+    auto bytes_of(std::string_view text) -> std::vector<std::byte> {
+        const auto* data = reinterpret_cast<const std::byte*>(text.data());
+        return std::vector<std::byte>(data, data + text.size());
+    }
+
+    auto noise(size_t size) -> std::vector<std::byte> {
+        std::mt19937 rng(11);
+        std::vector<std::byte> bytes(size);
+        for (auto& b : bytes) { b = static_cast<std::byte>(rng()); }
+        return bytes;
+    }
+
+    auto write_temp(std::string_view name, std::span<const std::byte> bytes) -> std::filesystem::path {
+        auto path = std::filesystem::temp_directory_path() / fmt::format("nce_{}_{}", getpid(), name);
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return path;
+    }
+
+    auto open_pack(std::vector<vke::PackInput> inputs) -> std::optional<vke::AssetPack> {
+        auto path = write_temp("test.pack", vke::build_pack(std::move(inputs)));
+        auto pack = vke::AssetPack::open(path);
+        std::filesystem::remove(path);
+        return pack;
+    }
+}
+
+TEST_CASE( "Entries are sorted, aligned and found by name", "[asset_pack]" ) {
+    std::string obj;
+    for (u32 i = 0; i < 500; i++) { obj += fmt::format("v {} 1.0 2.0\n", i % 9); }
+    auto texture = noise(10000);
+
+    std::vector<vke::PackInput> inputs;
+    inputs.push_back({ "assets/models/viking_room.obj", bytes_of(obj), true });
+    inputs.push_back({ "assets/texture.jpg", texture, true });
+    inputs.push_back({ "assets/empty.txt", {}, true });
+    auto pack = open_pack(std::move(inputs));
+    REQUIRE(pack.has_value());
+
+    auto entries = pack->entries();
+    REQUIRE(entries.size() == 3);
+    for (size_t i = 0; i < entries.size(); i++) {
+        REQUIRE(entries[i].offset % vke::PACK_ALIGNMENT == 0);
+        if (i > 0) { REQUIRE(entries[i - 1].name_hash < entries[i].name_hash); }
+    }
+
+    auto model = pack->read("assets/models/viking_room.obj");
+    REQUIRE(model.has_value());
+    REQUIRE(pack->find("assets/models/viking_room.obj")->compression == vke::PackCompression::lz4);
+    REQUIRE(std::ranges::equal(model->bytes, bytes_of(obj)));
+
+    auto empty = pack->read("assets/empty.txt");
+    REQUIRE(empty.has_value());
+    REQUIRE(empty->bytes.empty());
+
+    REQUIRE_FALSE(pack->read("assets/missing.png").has_value());
+}
+
+TEST_CASE( "Incompressible entries are views of the mapping", "[asset_pack]" ) {
+    auto texture = noise(20000);
+    std::vector<vke::PackInput> inputs;
+    inputs.push_back({ "assets/texture.jpg", texture, true });
+    inputs.push_back({ "assets/readme.txt", bytes_of("not worth compressing") });
+    auto pack = open_pack(std::move(inputs));
+    REQUIRE(pack.has_value());
+
+    auto asset = pack->read("assets/texture.jpg");
+    REQUIRE(asset.has_value());
+    REQUIRE(pack->find("assets/texture.jpg")->compression == vke::PackCompression::none);
+    REQUIRE(asset->decompressed.empty());
+    REQUIRE(reinterpret_cast<uintptr_t>(asset->bytes.data()) % vke::PACK_ALIGNMENT == 0);
+    REQUIRE(std::ranges::equal(asset->bytes, texture));
+    REQUIRE(pack->find("assets/readme.txt")->compression == vke::PackCompression::none);
+}
+
+TEST_CASE( "Invalid packs are rejected", "[asset_pack]" ) {
+    std::vector<vke::PackInput> inputs;
+    inputs.push_back({ "assets/texture.jpg", noise(5000) });
+    auto bytes = vke::build_pack(std::move(inputs));
+
+    SECTION( "wrong magic" ) {
+        bytes[0] = std::byte{'X'};
+    }
+    SECTION( "truncated" ) {
+        bytes.resize(bytes.size() - 100);
+    }
+    SECTION( "entry past the end" ) {
+        bytes.resize(sizeof(vke::PackHeader) + sizeof(vke::PackEntry) + 32);
+    }
+    auto path = write_temp("invalid.pack", bytes);
+    REQUIRE_FALSE(vke::AssetPack::open(path).has_value());
+    std::filesystem::remove(path);
+}
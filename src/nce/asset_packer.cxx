@@ -0,0 +1,54 @@
+#include <nce/asset_pack.hxx>
+
+#include <fmt/format.h>
+#include <fstream>
+
+/**
+ *  Build time packer: asset_packer <output> <root> [--lz4] <files...>
+ *  Every file is packed under its path relative to `root`, which is the path the engine loads it by.
+ *  Files after --lz4 are compressed where that saves space.
+ */
+auto main(i32 argc, char** argv) -> i32 {
+    if (argc < 3) {
+        fmt::println("usage: asset_packer <output> <root> [--lz4] <files...>");
+        return 1;
+    }
+    std::filesystem::path output = argv[1];
+    std::filesystem::path root = argv[2];
+
+    std::vector<vke::PackInput> inputs;
+    bool compress = false;
+    for (i32 i = 3; i < argc; i++) {
+        if (std::string_view(argv[i]) == "--lz4") {
+            compress = true;
+            continue;
+        }
+        std::filesystem::path path = argv[i];
+        auto file = vke::MappedFile::open(path);
+        if (!file) {
+            fmt::println("failed to read {}", path.c_str());
+            return 1;
+        }
+        auto bytes = file->bytes();
+        inputs.push_back({ std::filesystem::relative(path, root).generic_string(), std::vector<std::byte>(bytes.begin(), bytes.end()), compress });
+    }
+    auto pack = vke::build_pack(std::move(inputs));
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(pack.data()), static_cast<std::streamsize>(pack.size()));
+    file.close();
+    if (!file) {
+        fmt::println("failed to write {}", output.c_str());
+        return 1;
+    }
+    auto opened = vke::AssetPack::open(output);
+    if (!opened) {
+        fmt::println("{} does not read back as a pack", output.c_str());
+        return 1;
+    }
+    for (const auto& entry : opened->entries()) {
+        fmt::println("  {:<40} {:>10} -> {:>10} bytes{}", opened->name(entry), entry.size, entry.stored_size,
+                entry.compression == vke::PackCompression::lz4 ? " (lz4)" : "");
+    }
+    return 0;
+}
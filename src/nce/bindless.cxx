@@ -0,0 +1,27 @@
+#include <nce/bindless.hxx>
+
+namespace vke {
+    auto SlotAllocator::allocate() -> std::optional<u32> {
+        if (!free_slots.empty()) {
+            u32 slot = free_slots.back();
+            free_slots.pop_back();
+            live++;
+            return slot;
+        }
+        if (high_water == capacity) {
+            return std::nullopt;
+        }
+        live++;
+        return high_water++;
+    }
+    void SlotAllocator::release(u32 slot) {
+        retired[frame].push_back(slot);
+        live--;
+    }
+    void SlotAllocator::next_frame() {
+        frame = (frame + 1) % static_cast<u32>(retired.size());
+        // the frame now starting reuses the fence of the one that retired these slots
+        free_slots.insert(free_slots.end(), retired[frame].begin(), retired[frame].end());
+        retired[frame].clear();
+    }
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <nce/bindless.hxx>
+
+
+TEST_CASE( "Slots are handed out densely", "[bindless]" ) {
+    vke::SlotAllocator slots(4, 2);
+    REQUIRE(slots.allocate() == 0u);
+    REQUIRE(slots.allocate() == 1u);
+    REQUIRE(slots.allocate() == 2u);
+    REQUIRE(slots.allocate() == 3u);
+    REQUIRE_FALSE(slots.allocate().has_value());
+    REQUIRE(slots.size() == 4);
+}
+
+TEST_CASE( "Released slots wait for frames in flight", "[bindless]" ) {
+    vke::SlotAllocator slots(2, 2);
+    u32 a = slots.allocate().value();
+    u32 b = slots.allocate().value();
+    slots.release(a);
+    REQUIRE(slots.size() == 1);
+    // the previous frame might still sample slot a
+    REQUIRE_FALSE(slots.allocate().has_value());
+    slots.next_frame();
+    REQUIRE_FALSE(slots.allocate().has_value());
+    slots.next_frame();
+    REQUIRE(slots.allocate() == a);
+
+    slots.release(b);
+    slots.next_frame();
+    slots.next_frame();
+    REQUIRE(slots.allocate() == b);
+    REQUIRE(slots.size() == 2);
+}
+
+TEST_CASE( "Slot churn", "[bindless][!benchmark]" ) {
+    // materials streaming in and out of a scene with many differently textured parts
+    constexpr u32 objects = 10'000;
+    vke::SlotAllocator slots(vke::MAX_BINDLESS_TEXTURES, 2);
+    std::vector<u32> held;
+    held.reserve(vke::MAX_BINDLESS_TEXTURES);
+
+    BENCHMARK("allocate and release 10k slots") {
+        for (u32 i = 0; i < objects; i++) {
+            if (auto slot = slots.allocate()) {
+                held.push_back(*slot);
+            } else {
+                for (u32 s : held) { slots.release(s); }
+                held.clear();
+                slots.next_frame();
+                slots.next_frame();
+            }
+        }
+        return held.size();
+    };
+}
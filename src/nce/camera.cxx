@@ -0,0 +1,36 @@
+#include <nce/camera.hxx>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace vke {
+    auto camera_matrices(const Camera& camera, VkExtent2D extent) -> CameraMatrices {
+        CameraMatrices matrices{};
+        matrices.view = glm::lookAt(camera.eye, camera.center, camera.up);
+        matrices.proj = glm::perspective(camera.fov_y, static_cast<f32>(extent.width) / static_cast<f32>(extent.height), camera.near_plane, camera.far_plane);
+        matrices.proj[1][1] *= -1;
+        return matrices;
+    }
+
+    void CameraTracker::set_camera(const Camera& new_camera) {
+        if (new_camera == camera) { return; }
+        camera = new_camera;
+        version++;
+    }
+
+    void CameraTracker::set_extent(VkExtent2D new_extent) {
+        if (new_extent.width == extent.width && new_extent.height == extent.height) { return; }
+        extent = new_extent;
+        version++;
+    }
+
+    auto CameraTracker::consume(u32 frame) -> bool {
+        if (written[frame] == version) { return false; }
+        // computed once per change, not once per frame copy
+        if (matrices_version != version) {
+            matrices = camera_matrices(camera, extent);
+            matrices_version = version;
+        }
+        written[frame] = version;
+        return true;
+    }
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/camera.hxx>
+
+
+namespace {
+    const vke::Camera start{{2.0f, 2.0f, 2.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, glm::radians(45.0f), 0.1f, 10.0f};
+}
+
+TEST_CASE( "Every frame copy is written once per change", "[camera]" ) {
+    vke::CameraTracker tracker(2);
+    tracker.set_camera(start);
+    tracker.set_extent({800, 600});
+
+    REQUIRE(tracker.consume(0));
+    REQUIRE(tracker.consume(1));
+    // nothing changed, steady frames cost no writes
+    for (u32 frame = 0; frame < 8; frame++) {
+        REQUIRE_FALSE(tracker.consume(frame % 2));
+    }
+
+    // setting the same state is not a change
+    tracker.set_camera(start);
+    tracker.set_extent({800, 600});
+    REQUIRE_FALSE(tracker.consume(0));
+
+    vke::Camera moved = start;
+    moved.eye.z = 3.0f;
+    tracker.set_camera(moved);
+    REQUIRE(tracker.consume(0));
+    REQUIRE_FALSE(tracker.consume(0));
+    REQUIRE(tracker.consume(1));
+    REQUIRE(tracker.matrices.view == vke::camera_matrices(moved, {800, 600}).view);
+}
+
+TEST_CASE( "A resize changes the projection but not the view", "[camera]" ) {
+    vke::CameraTracker tracker(2);
+    tracker.set_camera(start);
+    tracker.set_extent({800, 600});
+    REQUIRE(tracker.consume(0));
+    glm::mat4 view = tracker.matrices.view;
+    glm::mat4 proj = tracker.matrices.proj;
+
+    tracker.set_extent({1600, 600});
+    REQUIRE(tracker.consume(0));
+    REQUIRE(tracker.matrices.view == view);
+    REQUIRE(tracker.matrices.proj != proj);
+    // y is flipped for Vulkan clip space
+    REQUIRE(tracker.matrices.proj[1][1] < 0.0f);
+}
@@ -0,0 +1,154 @@
+#include <nce/culling.hxx>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace vke {
+    auto sphere_from_aabb(glm::vec3 min, glm::vec3 max) -> ObjectBounds {
+        return {(min + max) * 0.5f, glm::length(max - min) * 0.5f};
+    }
+
+    auto transform_bounds(const ObjectBounds& bounds, const glm::mat4& model) -> ObjectBounds {
+        glm::vec3 center = glm::vec3(model * glm::vec4(bounds.center, 1.0f));
+        f32 scale = std::max({glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))});
+        return {center, bounds.radius * scale};
+    }
+
+    auto Frustum::from_view_proj(const glm::mat4& view_proj) -> Frustum {
+        // glm is column major, row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+        auto row = [&view_proj](i32 i) {
+            return glm::vec4(view_proj[0][i], view_proj[1][i], view_proj[2][i], view_proj[3][i]);
+        };
+        Frustum frustum{};
+        frustum.planes[left] = row(3) + row(0);
+        frustum.planes[right] = row(3) - row(0);
+        frustum.planes[bottom] = row(3) + row(1);
+        frustum.planes[top] = row(3) - row(1);
+        frustum.planes[near] = row(2); // 0 <= z, not -w <= z
+        frustum.planes[far] = row(3) - row(2);
+        for (auto& plane : frustum.planes) {
+            plane = plane / glm::length(glm::vec3(plane));
+        }
+        return frustum;
+    }
+
+    auto Frustum::intersects(const ObjectBounds& bounds) const -> bool {
+        return std::ranges::all_of(planes, [&bounds](const glm::vec4& plane) {
+                return glm::dot(glm::vec3(plane), bounds.center) + plane.w >= -bounds.radius;
+                });
+    }
+
+    void cull_reference(const Frustum& frustum, std::span<const ObjectBounds> bounds, u32 index_count, std::vector<VkDrawIndexedIndirectCommand>& draws) {
+        for (u32 object = 0; object < bounds.size(); object++) {
+            if (frustum.intersects(bounds[object])) {
+                draws.push_back(VkDrawIndexedIndirectCommand{index_count, 1, 0, 0, object});
+            }
+        }
+    }
+
+    auto project_bounds(const glm::mat4& view_proj, const ObjectBounds& bounds) -> std::optional<ScreenBounds> {
+        ScreenBounds screen{glm::vec2(1.0f), glm::vec2(0.0f), 1.0f};
+        for (u32 corner = 0; corner < 8; corner++) {
+            glm::vec3 offset((corner & 1) ? bounds.radius : -bounds.radius,
+                    (corner & 2) ? bounds.radius : -bounds.radius,
+                    (corner & 4) ? bounds.radius : -bounds.radius);
+            glm::vec4 clip = view_proj * glm::vec4(bounds.center + offset, 1.0f);
+            if (clip.z < 0.0f) {
+                return std::nullopt;
+            }
+            glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            glm::vec2 uv(std::clamp(ndc.x * 0.5f + 0.5f, 0.0f, 1.0f), std::clamp(ndc.y * 0.5f + 0.5f, 0.0f, 1.0f));
+            screen.min = glm::min(screen.min, uv);
+            screen.max = glm::max(screen.max, uv);
+            screen.nearest_depth = std::min(screen.nearest_depth, ndc.z);
+        }
+        return screen;
+    }
+
+    auto hiz_extent(VkExtent2D depth_extent) -> VkExtent2D {
+        return {std::bit_floor(depth_extent.width), std::bit_floor(depth_extent.height)};
+    }
+    auto hiz_mip_count(VkExtent2D extent) -> u32 {
+        return static_cast<u32>(std::bit_width(std::max(extent.width, extent.height)));
+    }
+    auto hiz_footprint(u32 texel, u32 source_size, u32 size) -> std::pair<u32, u32> {
+        return {texel * source_size / size, ((texel + 1) * source_size + size - 1) / size};
+    }
+
+    auto DepthPyramid::build(std::span<const f32> depth, VkExtent2D depth_extent) -> DepthPyramid {
+        DepthPyramid pyramid{hiz_extent(depth_extent), {}};
+        pyramid.levels.resize(hiz_mip_count(pyramid.extent));
+
+        // mip 0 keeps every depth texel it overlaps, the extents are not multiples of each other
+        auto& base = pyramid.levels[0];
+        base.resize(static_cast<size_t>(pyramid.extent.width) * pyramid.extent.height);
+        for (u32 y = 0; y < pyramid.extent.height; y++) {
+            auto [y0, y1] = hiz_footprint(y, depth_extent.height, pyramid.extent.height);
+            for (u32 x = 0; x < pyramid.extent.width; x++) {
+                auto [x0, x1] = hiz_footprint(x, depth_extent.width, pyramid.extent.width);
+                f32 farthest = 0.0f;
+                for (u32 sy = y0; sy < y1; sy++) {
+                    for (u32 sx = x0; sx < x1; sx++) {
+                        farthest = std::max(farthest, depth[sy * depth_extent.width + sx]);
+                    }
+                }
+                base[y * pyramid.extent.width + x] = farthest;
+            }
+        }
+
+        for (u32 level = 1; level < pyramid.levels.size(); level++) {
+            VkExtent2D source = pyramid.level_extent(level - 1);
+            VkExtent2D extent = pyramid.level_extent(level);
+            pyramid.levels[level].resize(static_cast<size_t>(extent.width) * extent.height);
+            for (u32 y = 0; y < extent.height; y++) {
+                for (u32 x = 0; x < extent.width; x++) {
+                    u32 sx = std::min(x * 2 + 1, source.width - 1);
+                    u32 sy = std::min(y * 2 + 1, source.height - 1);
+                    const auto& s = pyramid.levels[level - 1];
+                    pyramid.levels[level][y * extent.width + x] = std::max({
+                            s[y * 2 * source.width + x * 2], s[y * 2 * source.width + sx],
+                            s[sy * source.width + x * 2], s[sy * source.width + sx]});
+                }
+            }
+        }
+        return pyramid;
+    }
+
+    auto DepthPyramid::level_extent(u32 level) const -> VkExtent2D {
+        return {std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u)};
+    }
+
+    auto DepthPyramid::sample(glm::vec2 uv, u32 level) const -> f32 {
+        level = std::min(level, static_cast<u32>(levels.size()) - 1);
+        VkExtent2D size = level_extent(level);
+        auto texel = [](f32 coord, u32 size) {
+            return static_cast<u32>(std::clamp(static_cast<i32>(std::floor(coord)), 0, static_cast<i32>(size) - 1));
+        };
+        f32 x = uv.x * static_cast<f32>(size.width) - 0.5f;
+        f32 y = uv.y * static_cast<f32>(size.height) - 0.5f;
+        u32 x0 = texel(x, size.width), x1 = texel(x + 1.0f, size.width);
+        u32 y0 = texel(y, size.height), y1 = texel(y + 1.0f, size.height);
+        const auto& l = levels[level];
+        return std::max({l[y0 * size.width + x0], l[y0 * size.width + x1], l[y1 * size.width + x0], l[y1 * size.width + x1]});
+    }
+
+    auto DepthPyramid::occludes(const ScreenBounds& bounds) const -> bool {
+        f32 width = (bounds.max.x - bounds.min.x) * static_cast<f32>(extent.width);
+        f32 height = (bounds.max.y - bounds.min.y) * static_cast<f32>(extent.height);
+        // the level where the rectangle spans at most one texel, the 2x2 fetch then covers all of it
+        f32 level = std::ceil(std::log2(std::max({width, height, 1.0f})));
+        glm::vec2 center((bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f);
+        return bounds.nearest_depth > sample(center, static_cast<u32>(level));
+    }
+
+    void occlusion_cull_reference(const glm::mat4& view_proj, const DepthPyramid& pyramid, std::span<const ObjectBounds> bounds, u32 index_count, std::vector<VkDrawIndexedIndirectCommand>& draws) {
+        Frustum frustum = Frustum::from_view_proj(view_proj);
+        for (u32 object = 0; object < bounds.size(); object++) {
+            if (!frustum.intersects(bounds[object])) { continue; }
+            std::optional<ScreenBounds> screen = project_bounds(view_proj, bounds[object]);
+            if (screen && pyramid.occludes(*screen)) { continue; }
+            draws.push_back(VkDrawIndexedIndirectCommand{index_count, 1, 0, 0, object});
+        }
+    }
+}
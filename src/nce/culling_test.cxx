@@ -0,0 +1,187 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/culling.hxx>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+
+namespace {
+    auto camera() -> glm::mat4 {
+        glm::mat4 proj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
+        proj[1][1] *= -1;
+        // looking down -z from the origin
+        return proj * glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+}
+
+TEST_CASE( "Frustum planes bound the view volume", "[culling]" ) {
+    using namespace vke;
+    Frustum frustum = Frustum::from_view_proj(camera());
+
+    REQUIRE(frustum.intersects({{0.0f, 0.0f, -5.0f}, 0.5f}));
+    // behind the camera, beyond the far plane, and outside the 90 degree fov
+    REQUIRE_FALSE(frustum.intersects({{0.0f, 0.0f, 5.0f}, 0.5f}));
+    REQUIRE_FALSE(frustum.intersects({{0.0f, 0.0f, -12.0f}, 1.0f}));
+    REQUIRE_FALSE(frustum.intersects({{-4.0f, 0.0f, -2.0f}, 1.0f}));
+    REQUIRE_FALSE(frustum.intersects({{0.0f, 4.0f, -2.0f}, 1.0f}));
+
+    // spheres straddling a plane are kept
+    REQUIRE(frustum.intersects({{0.0f, 0.0f, -10.5f}, 1.0f}));
+    REQUIRE(frustum.intersects({{-2.5f, 0.0f, -2.0f}, 1.0f}));
+}
+
+TEST_CASE( "Bounds follow the object transform", "[culling]" ) {
+    using namespace vke;
+    ObjectBounds mesh = sphere_from_aabb(glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f));
+    REQUIRE(mesh.center == glm::vec3(0.0f));
+
+    glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -20.0f)), glm::vec3(1.0f, 4.0f, 1.0f));
+    ObjectBounds moved = transform_bounds(mesh, model);
+    REQUIRE(moved.center == glm::vec3(0.0f, 0.0f, -20.0f));
+    REQUIRE(moved.radius == mesh.radius * 4.0f);
+    // beyond the far plane until the scale pulls it back in
+    REQUIRE_FALSE(Frustum::from_view_proj(camera()).intersects(moved));
+    moved.radius *= 3.0f;
+    REQUIRE(Frustum::from_view_proj(camera()).intersects(moved));
+}
+
+TEST_CASE( "CPU reference emits one indexed draw per visible object", "[culling]" ) {
+    using namespace vke;
+    std::vector<ObjectBounds> bounds;
+    for (i32 z = 0; z < 16; z++) {
+        bounds.push_back({{0.0f, 0.0f, -static_cast<f32>(z)}, 0.25f});
+    }
+
+    std::vector<VkDrawIndexedIndirectCommand> draws;
+    cull_reference(Frustum::from_view_proj(camera()), bounds, 36, draws);
+    // z = 0 still touches the near plane, z > 10 is past the far plane
+    REQUIRE(draws.size() == 11);
+    for (u32 i = 0; i < draws.size(); i++) {
+        REQUIRE(draws[i].indexCount == 36);
+        REQUIRE(draws[i].instanceCount == 1);
+        REQUIRE(draws[i].firstInstance == i);
+    }
+}
+
+TEST_CASE( "Depth pyramid keeps the farthest depth", "[culling]" ) {
+    using namespace vke;
+    // 6x5 does not divide evenly into the 4x4 mip 0
+    std::vector<f32> depth(6 * 5, 0.25f);
+    depth[4 * 6 + 0] = 0.75f; // bottom left corner
+    DepthPyramid pyramid = DepthPyramid::build(depth, {6, 5});
+    REQUIRE(pyramid.extent.width == 4);
+    REQUIRE(pyramid.extent.height == 4);
+    REQUIRE(pyramid.levels.size() == 3);
+    REQUIRE(pyramid.levels[0][3 * 4 + 0] == 0.75f);
+    REQUIRE(pyramid.levels[0][0] == 0.25f);
+    REQUIRE(pyramid.levels[2][0] == 0.75f);
+
+    REQUIRE(pyramid.sample({0.1f, 0.1f}, 0) == 0.25f);
+    REQUIRE(pyramid.sample({0.1f, 0.9f}, 0) == 0.75f);
+    // levels past the last mip clamp to it
+    REQUIRE(pyramid.sample({0.9f, 0.1f}, 7) == 0.75f);
+}
+
+TEST_CASE( "Hi-Z mip 0 reduces every depth texel at non power of two extents", "[culling]" ) {
+    using namespace vke;
+    for (VkExtent2D depth_extent : {VkExtent2D{1280, 720}, VkExtent2D{1920, 1080}, VkExtent2D{6, 5}, VkExtent2D{1024, 768}}) {
+        VkExtent2D extent = hiz_extent(depth_extent);
+        // per axis the footprints tile the source without gaps, at most ceil(scale) + 1 texels each
+        for (auto [source_size, size] : {std::pair{depth_extent.width, extent.width}, std::pair{depth_extent.height, extent.height}}) {
+            u32 taps = (source_size + size - 1) / size + 1;
+            u32 covered = 0;
+            for (u32 texel = 0; texel < size; texel++) {
+                auto [first, last] = hiz_footprint(texel, source_size, size);
+                REQUIRE(first <= covered);
+                REQUIRE(last > first);
+                REQUIRE(last - first <= taps);
+                covered = last;
+            }
+            REQUIRE(covered == source_size);
+        }
+
+        // hiz.comp's mip 0: a single 2x2 fetch when the source is twice the size, every overlapped texel otherwise
+        std::vector<f32> depth(static_cast<size_t>(depth_extent.width) * depth_extent.height);
+        for (size_t i = 0; i < depth.size(); i++) {
+            depth[i] = static_cast<f32>((i * 7919) % 1009) / 1009.0f;
+        }
+        DepthPyramid pyramid = DepthPyramid::build(depth, depth_extent);
+        u32 mismatches = 0;
+        for (u32 y = 0; y < extent.height; y++) {
+            for (u32 x = 0; x < extent.width; x++) {
+                f32 farthest = 0.0f;
+                u32 y1 = ((y + 1) * depth_extent.height + extent.height - 1) / extent.height;
+                u32 x1 = ((x + 1) * depth_extent.width + extent.width - 1) / extent.width;
+                for (u32 sy = y * depth_extent.height / extent.height; sy < y1; sy++) {
+                    for (u32 sx = x * depth_extent.width / extent.width; sx < x1; sx++) {
+                        farthest = std::max(farthest, depth[sy * depth_extent.width + sx]);
+                    }
+                }
+                mismatches += pyramid.levels[0][y * extent.width + x] != farthest ? 1u : 0u;
+            }
+        }
+        REQUIRE(mismatches == 0);
+    }
+
+    // the single 2x2 fetch mip 0 used to take skips depth texels at 720 -> 512: texel 2 spans depth rows 2 to 4,
+    // the fetch at its center reads rows 3 and 4
+    f32 center = (2.0f + 0.5f) * 720.0f / 512.0f - 0.5f;
+    REQUIRE(static_cast<u32>(std::floor(center)) == 3);
+    REQUIRE(hiz_footprint(2, 720, 512) == std::pair<u32, u32>{2, 5});
+    std::vector<f32> column(720, 0.25f);
+    column[2] = 0.75f;
+    REQUIRE(DepthPyramid::build(column, {1, 720}).levels[0][2] == 0.75f);
+}
+
+TEST_CASE( "Occlusion culling drops objects hidden behind a wall", "[culling]" ) {
+    using namespace vke;
+    glm::mat4 view_proj = camera();
+    constexpr VkExtent2D extent{200, 150};
+    constexpr u32 index_count = 3 * 1000;
+
+    // a wall filling the view at z = -2 with a window in the middle, the window sees the far plane
+    glm::vec4 wall = view_proj * glm::vec4(0.0f, 0.0f, -2.0f, 1.0f);
+    std::vector<f32> depth(extent.width * extent.height, wall.z / wall.w);
+    for (u32 y = 60; y < 90; y++) {
+        for (u32 x = 80; x < 120; x++) {
+            depth[y * extent.width + x] = 1.0f;
+        }
+    }
+    DepthPyramid pyramid = DepthPyramid::build(depth, extent);
+
+    // a dense grid of parts behind the wall, a few in front of it
+    std::vector<ObjectBounds> bounds;
+    for (i32 z = 3; z < 9; z++) {
+        for (i32 y = -8; y <= 8; y++) {
+            for (i32 x = -8; x <= 8; x++) {
+                bounds.push_back({{0.5f * static_cast<f32>(x), 0.5f * static_cast<f32>(y), -static_cast<f32>(z)}, 0.1f});
+            }
+        }
+    }
+    const u32 in_front = 4;
+    for (u32 i = 0; i < in_front; i++) {
+        bounds.push_back({{-0.6f + 0.4f * static_cast<f32>(i), -0.5f, -1.5f}, 0.1f});
+    }
+
+    std::vector<VkDrawIndexedIndirectCommand> frustum_draws;
+    cull_reference(Frustum::from_view_proj(view_proj), bounds, index_count, frustum_draws);
+    std::vector<VkDrawIndexedIndirectCommand> draws;
+    occlusion_cull_reference(view_proj, pyramid, bounds, index_count, draws);
+
+    // everything in front of the wall survives, and nothing seen through the window is lost
+    auto drawn = [&draws](u32 object) {
+        return std::ranges::any_of(draws, [object](const auto& d) { return d.firstInstance == object; });
+    };
+    for (u32 object = 0; object < bounds.size(); object++) {
+        std::optional<ScreenBounds> screen = project_bounds(view_proj, bounds[object]);
+        REQUIRE(screen);
+        bool through_window = screen->max.x > 80.0f / 200.0f && screen->min.x < 120.0f / 200.0f
+            && screen->max.y > 60.0f / 150.0f && screen->min.y < 90.0f / 150.0f;
+        if (object >= bounds.size() - in_front || through_window) {
+            REQUIRE(drawn(object));
+        }
+    }
+    // the pyramid is conservative, but still removes the bulk of the triangles frustum culling keeps
+    u64 frustum_triangles = frustum_draws.size() * index_count / 3;
+    u64 triangles = draws.size() * index_count / 3;
+    REQUIRE(triangles * 5 < frustum_triangles);
+}
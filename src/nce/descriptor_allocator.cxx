@@ -0,0 +1,192 @@
+#include <nce/descriptor_allocator.hxx>
+
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace {
+    void hash_combine(std::size_t& seed, std::size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+    }
+}
+
+namespace vke {
+    DescriptorLayoutKey::DescriptorLayoutKey(std::vector<DescriptorBinding> bindings, VkDescriptorSetLayoutCreateFlags flags) :
+        bindings(std::move(bindings)),
+        flags(flags) {
+        // the same layout declared in a different order must hit the same cache entry
+        std::ranges::sort(this->bindings, {}, &DescriptorBinding::binding);
+    }
+
+    auto DescriptorLayoutKeyHash::operator()(const DescriptorLayoutKey& key) const -> std::size_t {
+        std::size_t seed = std::hash<u32>{}(key.flags);
+        for (const auto& b : key.bindings) {
+            hash_combine(seed, std::hash<u32>{}(b.binding));
+            hash_combine(seed, std::hash<u32>{}(static_cast<u32>(b.type)));
+            hash_combine(seed, std::hash<u32>{}(b.count));
+            hash_combine(seed, std::hash<u32>{}(b.stages));
+            hash_combine(seed, std::hash<u32>{}(b.flags));
+        }
+        return seed;
+    }
+    auto DescriptorSetKeyHash::operator()(const DescriptorSetKey& key) const -> std::size_t {
+        std::size_t seed = std::hash<const void*>{}(key.layout);
+        for (const auto& w : key.writes) {
+            hash_combine(seed, std::hash<u32>{}(w.binding));
+            hash_combine(seed, std::hash<u32>{}(static_cast<u32>(w.type)));
+            hash_combine(seed, std::hash<const void*>{}(w.handle));
+            hash_combine(seed, std::hash<u64>{}(w.offset));
+            hash_combine(seed, std::hash<u64>{}(w.range));
+            hash_combine(seed, std::hash<const void*>{}(w.sampler));
+            hash_combine(seed, std::hash<u32>{}(static_cast<u32>(w.layout)));
+        }
+        return seed;
+    }
+
+    DescriptorCache::~DescriptorCache() {
+        if (device == VK_NULL_HANDLE) { return; }
+        for (const auto& [key, layout] : layouts) {
+            vkDestroyDescriptorSetLayout(device, layout, nullptr);
+        }
+    }
+    auto DescriptorCache::layout(const DescriptorLayoutKey& key, const CreateLayoutFn& create) -> VkDescriptorSetLayout {
+        if (auto it = layouts.find(key); it != layouts.end()) {
+            hits++;
+            return it->second;
+        }
+        misses++;
+        VkDescriptorSetLayout created = create(key);
+        layouts.emplace(key, created);
+        return created;
+    }
+    auto DescriptorCache::layout(const DescriptorLayoutKey& key) -> VkDescriptorSetLayout {
+        return layout(key, [this](const DescriptorLayoutKey& k) {
+            std::vector<VkDescriptorSetLayoutBinding> bindings;
+            std::vector<VkDescriptorBindingFlags> binding_flags;
+            for (const auto& b : k.bindings) {
+                bindings.push_back({b.binding, b.type, b.count, b.stages, nullptr});
+                binding_flags.push_back(b.flags);
+            }
+            bool any_flags = std::ranges::any_of(binding_flags, [](VkDescriptorBindingFlags f) { return f != 0; });
+
+            VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info{};
+            binding_flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+            binding_flags_info.bindingCount = static_cast<u32>(binding_flags.size());
+            binding_flags_info.pBindingFlags = binding_flags.data();
+
+            VkDescriptorSetLayoutCreateInfo layout_info{};
+            layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            layout_info.pNext = any_flags ? &binding_flags_info : nullptr;
+            layout_info.flags = k.flags;
+            layout_info.bindingCount = static_cast<u32>(bindings.size());
+            layout_info.pBindings = bindings.data();
+
+            VkDescriptorSetLayout created = VK_NULL_HANDLE;
+            VkResult result = vkCreateDescriptorSetLayout(device, &layout_info, nullptr, &created);
+            if (result != VK_SUCCESS) {
+                fmt::println("failed to create descriptor set layout! ({})", static_cast<i32>(result));
+                std::abort();
+            }
+            return created;
+        });
+    }
+    auto DescriptorCache::set(const DescriptorSetKey& key, const CreateSetFn& create) -> VkDescriptorSet {
+        if (auto it = sets.find(key); it != sets.end()) {
+            hits++;
+            return it->second;
+        }
+        misses++;
+        VkDescriptorSet created = create(key);
+        sets.emplace(key, created);
+        return created;
+    }
+
+    DescriptorAllocator::~DescriptorAllocator() {
+        if (device == VK_NULL_HANDLE) { return; }
+        for (VkDescriptorPool pool : used_pools) { vkDestroyDescriptorPool(device, pool, nullptr); }
+        for (VkDescriptorPool pool : free_pools) { vkDestroyDescriptorPool(device, pool, nullptr); }
+    }
+    void DescriptorAllocator::init(VkDevice device, std::vector<PoolRatio> ratios, VkDescriptorPoolCreateFlags flags) {
+        this->device = device;
+        this->ratios = std::move(ratios);
+        this->flags = flags;
+    }
+    auto DescriptorAllocator::grab_pool(const CreatePoolFn& create_pool) -> VkDescriptorPool {
+        if (!free_pools.empty()) {
+            VkDescriptorPool pool = free_pools.back();
+            free_pools.pop_back();
+            used_pools.push_back(pool);
+            return pool;
+        }
+
+        VkDescriptorPool pool = create_pool(sets_per_pool);
+        sets_per_pool = std::min(sets_per_pool * 2, MAX_SETS_PER_POOL);
+        used_pools.push_back(pool);
+        return pool;
+    }
+    auto DescriptorAllocator::allocate(const CreatePoolFn& create_pool, const AllocateSetFn& allocate_set) -> VkDescriptorSet {
+        if (current == VK_NULL_HANDLE) {
+            current = grab_pool(create_pool);
+        }
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        VkResult result = allocate_set(current, set);
+        if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+            // the current pool is full, chain a new one and retry once
+            current = grab_pool(create_pool);
+            result = allocate_set(current, set);
+        }
+        if (result != VK_SUCCESS) {
+            fmt::println("failed to allocate descriptor set! ({})", static_cast<i32>(result));
+            std::abort();
+        }
+        allocations++;
+        return set;
+    }
+    auto DescriptorAllocator::allocate(VkDescriptorSetLayout layout) -> VkDescriptorSet {
+        auto create_pool = [this](u32 max_sets) {
+            std::vector<VkDescriptorPoolSize> pool_sizes;
+            for (const auto& [type, ratio] : ratios) {
+                pool_sizes.push_back({type, std::max(1u, static_cast<u32>(ratio * static_cast<f32>(max_sets)))});
+            }
+
+            VkDescriptorPoolCreateInfo pool_info{};
+            pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            pool_info.flags = flags;
+            pool_info.poolSizeCount = static_cast<u32>(pool_sizes.size());
+            pool_info.pPoolSizes = pool_sizes.data();
+            pool_info.maxSets = max_sets;
+
+            VkDescriptorPool pool = VK_NULL_HANDLE;
+            VkResult result = vkCreateDescriptorPool(device, &pool_info, nullptr, &pool);
+            if (result != VK_SUCCESS) {
+                fmt::println("failed to create descriptor pool! ({})", static_cast<i32>(result));
+                std::abort();
+            }
+            return pool;
+        };
+        return allocate(create_pool, [this, layout](VkDescriptorPool pool, VkDescriptorSet& set) {
+            VkDescriptorSetAllocateInfo alloc_info{};
+            alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            alloc_info.descriptorPool = pool;
+            alloc_info.descriptorSetCount = 1;
+            alloc_info.pSetLayouts = &layout;
+            return vkAllocateDescriptorSets(device, &alloc_info, &set);
+        });
+    }
+    void DescriptorAllocator::reset(const ResetPoolFn& reset_pool) {
+        for (VkDescriptorPool pool : used_pools) {
+            reset_pool(pool);
+            free_pools.push_back(pool);
+        }
+        used_pools.clear();
+        current = VK_NULL_HANDLE;
+    }
+    void DescriptorAllocator::reset() {
+        reset([this](VkDescriptorPool pool) { vkResetDescriptorPool(device, pool, 0); });
+    }
+
+    void print_descriptor_stats(const DescriptorStats& stats) {
+        fmt::println("descriptors: {} sets allocated from {} pools, cache {} hits / {} misses ({:.1f}% hit rate)",
+                stats.allocations, stats.pool_count, stats.cache_hits, stats.cache_misses, stats.hit_rate() * 100.0);
+    }
+}
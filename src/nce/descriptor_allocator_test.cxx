@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/descriptor_allocator.hxx>
+
+
+namespace {
+    template<typename Handle>
+    auto fake_handle(std::uintptr_t value) -> Handle { return reinterpret_cast<Handle>(value); }
+
+    const vke::DescriptorBinding ubo { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT };
+    const vke::DescriptorBinding sampler { 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT };
+}
+
+TEST_CASE( "Layouts are cached by their bindings", "[descriptor]" ) {
+    using namespace vke;
+    DescriptorCache cache;
+    u32 created = 0;
+    auto create = [&](const DescriptorLayoutKey&) { return fake_handle<VkDescriptorSetLayout>(++created); };
+
+    VkDescriptorSetLayout a = cache.layout(DescriptorLayoutKey({ubo, sampler}), create);
+    // declaration order does not matter
+    VkDescriptorSetLayout b = cache.layout(DescriptorLayoutKey({sampler, ubo}), create);
+    REQUIRE(a == b);
+    REQUIRE(created == 1);
+
+    DescriptorBinding compute_ubo = ubo;
+    compute_ubo.stages = VK_SHADER_STAGE_COMPUTE_BIT;
+    REQUIRE(cache.layout(DescriptorLayoutKey({compute_ubo, sampler}), create) != a);
+    REQUIRE(cache.layout(DescriptorLayoutKey({ubo, sampler}, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT), create) != a);
+    REQUIRE(created == 3);
+    REQUIRE(cache.hits == 1);
+    REQUIRE(cache.misses == 3);
+}
+
+TEST_CASE( "Immutable sets are cached by their writes", "[descriptor]" ) {
+    using namespace vke;
+    DescriptorCache cache;
+    u32 created = 0;
+    auto create = [&](const DescriptorSetKey&) { return fake_handle<VkDescriptorSet>(++created); };
+
+    auto layout = fake_handle<VkDescriptorSetLayout>(1);
+    auto buffer = fake_handle<void*>(0x100);
+    DescriptorSetKey key { layout, { DescriptorWrite{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, buffer, 0, 192} } };
+
+    VkDescriptorSet set = cache.set(key, create);
+    for (u32 i = 0; i < 9; i++) {
+        REQUIRE(cache.set(key, create) == set);
+    }
+    key.writes[0].offset = 256;
+    REQUIRE(cache.set(key, create) != set);
+
+    DescriptorStats stats{0, 0, cache.hits, cache.misses};
+    REQUIRE(stats.cache_hits == 9);
+    REQUIRE(stats.cache_misses == 2);
+    REQUIRE(stats.hit_rate() > 0.8);
+    REQUIRE(DescriptorStats{}.hit_rate() == 0.0);
+}
+
+namespace {
+    /// @brief Pools that hold `max_sets` sets each, fake handles are 1-based indices into `capacity`.
+    struct FakePools {
+        std::vector<u32> capacity;
+        std::vector<u32> used;
+        VkResult full = VK_ERROR_OUT_OF_POOL_MEMORY;
+
+        auto create() -> vke::DescriptorAllocator::CreatePoolFn {
+            return [this](u32 max_sets) {
+                capacity.push_back(max_sets);
+                used.push_back(0);
+                return fake_handle<VkDescriptorPool>(capacity.size());
+            };
+        }
+        auto allocate() -> vke::DescriptorAllocator::AllocateSetFn {
+            return [this](VkDescriptorPool pool, VkDescriptorSet& set) {
+                auto index = reinterpret_cast<std::uintptr_t>(pool) - 1;
+                if (used[index] == capacity[index]) { return full; }
+                used[index]++;
+                set = fake_handle<VkDescriptorSet>(0x1000 * (index + 1) + used[index]);
+                return VK_SUCCESS;
+            };
+        }
+    };
+}
+
+TEST_CASE( "An exhausted pool chains a new one twice its size", "[descriptor]" ) {
+    using namespace vke;
+    DescriptorAllocator allocator;
+    FakePools pools;
+
+    for (u32 i = 0; i < 64 + 128 + 1; i++) {
+        REQUIRE(allocator.allocate(pools.create(), pools.allocate()) != VK_NULL_HANDLE);
+    }
+    REQUIRE(pools.capacity == std::vector<u32>{64, 128, 256});
+    REQUIRE(pools.used == std::vector<u32>{64, 128, 1});
+    REQUIRE(allocator.pool_count() == 3);
+    REQUIRE(allocator.allocations == 64 + 128 + 1);
+
+    // growth stops at MAX_SETS_PER_POOL
+    for (u32 i = 0; i < 8; i++) {
+        (void)allocator.grab_pool(pools.create());
+    }
+    REQUIRE(pools.capacity.back() == DescriptorAllocator::MAX_SETS_PER_POOL);
+    REQUIRE(allocator.sets_per_pool == DescriptorAllocator::MAX_SETS_PER_POOL);
+}
+
+TEST_CASE( "A fragmented pool chains a new one and reset recycles every pool", "[descriptor]" ) {
+    using namespace vke;
+    DescriptorAllocator allocator;
+    FakePools pools;
+    pools.full = VK_ERROR_FRAGMENTED_POOL;
+
+    for (u32 i = 0; i < 65; i++) {
+        (void)allocator.allocate(pools.create(), pools.allocate());
+    }
+    REQUIRE(pools.capacity.size() == 2);
+    REQUIRE(allocator.current == fake_handle<VkDescriptorPool>(2));
+
+    std::vector<VkDescriptorPool> reset;
+    allocator.reset([&](VkDescriptorPool pool) {
+        pools.used[reinterpret_cast<std::uintptr_t>(pool) - 1] = 0;
+        reset.push_back(pool);
+    });
+    REQUIRE(reset.size() == 2);
+    REQUIRE(allocator.used_pools.empty());
+    REQUIRE(allocator.free_pools.size() == 2);
+    REQUIRE(allocator.current == VK_NULL_HANDLE);
+
+    // the reset pools are reused before any new one is created
+    for (u32 i = 0; i < 65; i++) {
+        (void)allocator.allocate(pools.create(), pools.allocate());
+    }
+    REQUIRE(pools.capacity.size() == 2);
+    REQUIRE(allocator.pool_count() == 2);
+    REQUIRE(allocator.allocations == 130);
+}
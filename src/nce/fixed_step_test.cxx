@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/fixed_step.hxx>
+#include <nce/viewer_state.hxx>
+
+#include <bit>
+#include <thread>
+#include <vector>
+
+
+namespace {
+    /// @brief A damped spring pushed around by inputs, with a hash of every state it went through.
+    struct Body {
+        f64 x = 1.0;
+        f64 v = 0.0;
+        u64 history = 0xcbf29ce484222325; ///< changes if any tick ran differently, in a different order or twice
+
+        auto operator==(const Body&) const -> bool = default;
+    };
+    struct Push {
+        f64 impulse = 0.0;
+    };
+
+    void step_body(Body& body, std::span<const Push> pushes, f64 dt) {
+        for (const Push& push : pushes) { body.v += push.impulse; }
+        body.v += (-40.0 * body.x - 0.5 * body.v) * dt;
+        body.x += body.v * dt;
+        body.history = (body.history ^ std::bit_cast<u64>(body.x)) * 0x100000001b3;
+    }
+
+    constexpr u64 TICKS = 240;
+    constexpr f64 HZ = 1'000.0;
+    const std::vector<nce::TickedInput<Push>> SCRIPT = {
+        {{0.5}, 3}, {{-1.25}, 17}, {{2.0}, 17}, {{0.1}, 40}, {{-0.7}, 41}, {{3.0}, 150}, {{-3.0}, 239},
+    };
+
+    /// @brief A drag that orbits and zooms while the spin is toggled off and on again.
+    const std::vector<nce::TickedInput<nce::ViewerInput>> ORBIT_SCRIPT = {
+        {{12, -3}, 2}, {{40, 7}, 3}, {{0, 0, 2}, 3}, {{0, 0, 0, true}, 60}, {{-25, 90}, 61}, {{300, 400}, 100},
+        {{0, 0, -5}, 101}, {{0, 0, 0, true}, 180}, {{7, -7, 1}, 239},
+    };
+
+    template<typename State, typename Input>
+    auto reference(State initial, typename nce::FixedStepper<State, Input>::Step step, const std::vector<nce::TickedInput<Input>>& script) -> State {
+        nce::FixedStepper<State, Input> stepper(initial, step, 1.0 / HZ);
+        for (const auto& input : script) { stepper.submit(input); }
+        while (stepper.tick() < TICKS) { stepper.step(); }
+        return stepper.state();
+    }
+
+    /// @brief Run the simulation thread to TICKS while a render thread reads snapshots `render` does something with.
+    template<typename State, typename Input, typename Render>
+    auto run_threaded(State initial, typename nce::FixedStepper<State, Input>::Step step, const std::vector<nce::TickedInput<Input>>& script,
+            Render&& render) -> std::pair<State, u64> {
+        nce::SimulationThread<State, Input> simulation(initial, step, {HZ, 8, TICKS});
+        for (const auto& input : script) { REQUIRE(simulation.submit(input.input, input.tick)); }
+        u64 frames = 0;
+        u64 last_tick = 0;
+        while (true) {
+            const auto& snapshot = simulation.snapshot();
+            REQUIRE(snapshot.tick >= last_tick);
+            last_tick = snapshot.tick;
+            f64 alpha = snapshot.alpha(simulation.now_ns());
+            REQUIRE(alpha >= 0.0);
+            REQUIRE(alpha <= 1.0);
+            render(snapshot);
+            frames++;
+            if (snapshot.tick == TICKS) { return {snapshot.current, frames}; }
+        }
+    }
+}
+
+TEST_CASE( "Inputs apply at their tick in submission order", "[fixed_step]" ) {
+    nce::FixedStepper<Body, Push> a(Body{}, step_body, 0.01);
+    nce::FixedStepper<Body, Push> b(Body{}, step_body, 0.01);
+    a.submit({{1.0}, 5});
+    b.step();
+    b.step();
+    // submitted late, still lands in tick 5
+    b.submit({{1.0}, 5});
+    while (a.tick() < 10) { a.step(); }
+    while (b.tick() < 10) { b.step(); }
+    REQUIRE(a.state() == b.state());
+
+    nce::FixedStepper<Body, Push> c(Body{}, step_body, 0.01);
+    c.submit({{1.0}, 6});
+    while (c.tick() < 10) { c.step(); }
+    REQUIRE_FALSE(c.state() == a.state());
+
+    // tick 0 is the next tick
+    nce::FixedStepper<Body, Push> d(Body{}, step_body, 0.01);
+    while (d.tick() < 4) { d.step(); }
+    d.submit({{1.0}, 0});
+    while (d.tick() < 10) { d.step(); }
+    REQUIRE(d.state() == a.state());
+}
+
+TEST_CASE( "The simulation does not depend on the render rate", "[fixed_step]" ) {
+    const Body expected = reference(Body{}, step_body, SCRIPT);
+
+    SECTION( "render as fast as possible" ) {
+        auto [body, frames] = run_threaded(Body{}, step_body, SCRIPT, [](const auto&) {});
+        REQUIRE(body == expected);
+        REQUIRE(frames > 0);
+    }
+    SECTION( "render at 60 Hz" ) {
+        auto [body, frames] = run_threaded(Body{}, step_body, SCRIPT, [](const auto&) { std::this_thread::sleep_for(std::chrono::microseconds(16'667)); });
+        REQUIRE(body == expected);
+        // the simulation ran at its own rate, the renderer saw a fraction of its ticks
+        REQUIRE(frames < TICKS);
+    }
+    SECTION( "heavy frames" ) {
+        auto [body, frames] = run_threaded(Body{}, step_body, SCRIPT, [](const auto&) { std::this_thread::sleep_for(std::chrono::milliseconds(50)); });
+        REQUIRE(body == expected);
+        REQUIRE(frames < TICKS / 10);
+    }
+}
+
+TEST_CASE( "The viewer's orbit does not depend on the render rate", "[fixed_step]" ) {
+    const nce::ViewerState expected = reference(nce::ViewerState{}, nce::step_viewer, ORBIT_SCRIPT);
+    // the script moved every part of the orbit
+    REQUIRE(expected.yaw != nce::ViewerState{}.yaw);
+    REQUIRE(expected.pitch != nce::ViewerState{}.pitch);
+    REQUIRE(expected.distance != nce::ViewerState{}.distance);
+
+    auto [fast, fast_frames] = run_threaded(nce::ViewerState{}, nce::step_viewer, ORBIT_SCRIPT, [](const auto&) {});
+    REQUIRE(fast == expected);
+    // every frame blends from the snapshot it got, the blend stays between the two ticks
+    auto [slow, slow_frames] = run_threaded(nce::ViewerState{}, nce::step_viewer, ORBIT_SCRIPT, [](const auto& snapshot) {
+            nce::ViewerState view = nce::blend_viewer(snapshot.previous, snapshot.current, 0.5);
+            REQUIRE(view.distance >= std::min(snapshot.previous.distance, snapshot.current.distance));
+            REQUIRE(view.distance <= std::max(snapshot.previous.distance, snapshot.current.distance));
+            std::this_thread::sleep_for(std::chrono::microseconds(16'667));
+            });
+    REQUIRE(slow == expected);
+    REQUIRE(slow_frames < fast_frames);
+
+    nce::ViewerState before;
+    nce::ViewerState after;
+    before.rotation = 6.2;
+    after.rotation = 0.1;
+    after.yaw = before.yaw + 1.0;
+    REQUIRE(nce::blend_viewer(before, after, 0.0) == before);
+    REQUIRE(nce::blend_viewer(before, after, 0.5).yaw == before.yaw + 0.5);
+    // across the wrap the short way is forward
+    REQUIRE(nce::blend_viewer(before, after, 0.5).rotation > 6.2);
+}
+
+TEST_CASE( "Snapshots blend the last two states", "[fixed_step]" ) {
+    nce::TickSnapshot<Body> snapshot{Body{0.0}, Body{1.0}, 10, 1'000'000, 1'000'000};
+    REQUIRE(snapshot.alpha(1'000'000) == 0.0);
+    REQUIRE(snapshot.alpha(1'500'000) == 0.5);
+    REQUIRE(snapshot.alpha(5'000'000) == 1.0);
+    REQUIRE(snapshot.alpha(0) == 0.0);
+
+    nce::SimulationThread<Body, Push> simulation(Body{}, step_body, {HZ, 8, 20});
+    while (simulation.ticks() < 20) { std::this_thread::yield(); }
+    const auto& last = simulation.snapshot();
+    REQUIRE(last.tick == 20);
+    nce::FixedStepper<Body, Push> stepper(Body{}, step_body, 1.0 / HZ);
+    while (stepper.tick() < 19) { stepper.step(); }
+    REQUIRE(last.previous == stepper.state());
+    stepper.step();
+    REQUIRE(last.current == stepper.state());
+    REQUIRE(simulation.stats().ticks == 20);
+}
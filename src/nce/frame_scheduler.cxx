@@ -0,0 +1,96 @@
+#include <nce/frame_scheduler.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fmt/format.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace nce {
+    FrameScheduler::FrameScheduler(i32 input_fd, bool continuous)
+        : input_fd(input_fd),
+        timer_fd(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK)),
+        wake_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+        continuous(continuous) {
+        if (timer_fd < 0 || wake_fd < 0) { fmt::println("frame scheduler: timerfd or eventfd failed: {}", std::strerror(errno)); std::abort(); }
+    }
+
+    FrameScheduler::~FrameScheduler() {
+        close(timer_fd);
+        close(wake_fd);
+    }
+
+    void FrameScheduler::start_animation(f64 hz) {
+        i64 interval_ns = std::max<i64>(1, std::llround(1e9 / hz));
+        itimerspec spec{};
+        spec.it_interval.tv_sec = interval_ns / 1'000'000'000;
+        spec.it_interval.tv_nsec = interval_ns % 1'000'000'000;
+        spec.it_value = spec.it_interval;
+        timerfd_settime(timer_fd, 0, &spec, nullptr);
+        animation = true;
+        // the first frame of an animation should not wait a whole interval
+        pending |= Damage::animation;
+    }
+
+    void FrameScheduler::stop_animation() {
+        itimerspec spec{};
+        timerfd_settime(timer_fd, 0, &spec, nullptr);
+        animation = false;
+    }
+
+    void FrameScheduler::post(Damage reason) {
+        posted.fetch_or(static_cast<u32>(reason), std::memory_order_release);
+        u64 one = 1;
+        [[maybe_unused]] auto written = write(wake_fd, &one, sizeof(one));
+    }
+
+    auto FrameScheduler::has_work() const -> bool {
+        return continuous || pending != Damage::none || posted.load(std::memory_order_acquire) != 0;
+    }
+
+    void FrameScheduler::wait(bool input_pending, i32 timeout_ms) {
+        if (input_pending || has_work()) {
+            counters.wakeups++;
+            return;
+        }
+        auto begin = std::chrono::steady_clock::now();
+        std::array<pollfd, 3> fds = {
+            pollfd{wake_fd, POLLIN, 0},
+            pollfd{timer_fd, POLLIN, 0},
+            pollfd{input_fd, POLLIN, 0}, // a negative fd is skipped by poll()
+        };
+        if (poll(fds.data(), fds.size(), timeout_ms) < 0 && errno != EINTR) {
+            fmt::println("frame scheduler: poll failed: {}", std::strerror(errno));
+        }
+        u64 count = 0;
+        if (fds[0].revents & POLLIN) {
+            // posted damage is picked up by begin_frame, the eventfd only has to be reset
+            [[maybe_unused]] auto read_bytes = read(wake_fd, &count, sizeof(count));
+        }
+        if (fds[1].revents & POLLIN && read(timer_fd, &count, sizeof(count)) == sizeof(count)) {
+            counters.timer_ticks += count;
+            pending |= Damage::animation;
+        }
+        counters.wakeups++;
+        counters.blocks++;
+        counters.blocked_ms += std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    auto FrameScheduler::begin_frame() -> Damage {
+        Damage damage = pending | static_cast<Damage>(posted.exchange(0, std::memory_order_acquire));
+        if (continuous) { damage |= Damage::animation; }
+        pending = Damage::none;
+        if (damage == Damage::none) {
+            counters.skipped++;
+        } else {
+            counters.frames++;
+        }
+        return damage;
+    }
+}
@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/frame_scheduler.hxx>
+
+#include <chrono>
+#include <fmt/format.h>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    auto cpu_seconds() -> f64 {
+        rusage usage{};
+        getrusage(RUSAGE_THREAD, &usage);
+        return static_cast<f64>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + static_cast<f64>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+    auto elapsed_ms(Clock::time_point since) -> f64 {
+        return std::chrono::duration<f64, std::milli>(Clock::now() - since).count();
+    }
+
+    /// @brief A pipe standing in for the X connection's socket.
+    struct FakeInput {
+        std::array<i32, 2> fds{};
+        FakeInput() { REQUIRE(pipe(fds.data()) == 0); }
+        ~FakeInput() { close(fds[0]); close(fds[1]); }
+        void send() { [[maybe_unused]] auto written = write(fds[1], "x", 1); }
+        void receive() { char byte; [[maybe_unused]] auto read_bytes = read(fds[0], &byte, 1); }
+    };
+}
+
+TEST_CASE( "Damage is collected until the next frame", "[frame_scheduler]" ) {
+    nce::FrameScheduler scheduler(-1);
+    REQUIRE_FALSE(scheduler.has_work());
+    REQUIRE(scheduler.begin_frame() == nce::Damage::none);
+
+    scheduler.damage(nce::Damage::input);
+    scheduler.damage(nce::Damage::resize);
+    REQUIRE(scheduler.has_work());
+    REQUIRE(scheduler.begin_frame() == (nce::Damage::input | nce::Damage::resize));
+    REQUIRE(scheduler.begin_frame() == nce::Damage::none);
+    REQUIRE(scheduler.stats().frames == 1);
+    REQUIRE(scheduler.stats().skipped == 2);
+
+    // with work queued wait() does not block
+    scheduler.damage(nce::Damage::expose);
+    scheduler.wait();
+    REQUIRE(scheduler.stats().blocks == 0);
+    REQUIRE((scheduler.begin_frame() & nce::Damage::expose) == nce::Damage::expose);
+}
+
+TEST_CASE( "An idle scheduler sleeps until input arrives", "[frame_scheduler]" ) {
+    FakeInput input;
+    nce::FrameScheduler scheduler(input.fds[0]);
+
+    auto begin = Clock::now();
+    scheduler.wait(false, 50);
+    REQUIRE(elapsed_ms(begin) >= 45.0);
+    REQUIRE(scheduler.begin_frame() == nce::Damage::none);
+
+    // input already read off the socket does not wait for the socket
+    begin = Clock::now();
+    scheduler.wait(true, 5'000);
+    REQUIRE(elapsed_ms(begin) < 1'000.0);
+
+    std::jthread sender([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        input.send();
+    });
+    begin = Clock::now();
+    scheduler.wait(false, 5'000);
+    REQUIRE(elapsed_ms(begin) < 1'000.0);
+    input.receive();
+    // the caller reads the input and decides what it damaged
+    REQUIRE(scheduler.begin_frame() == nce::Damage::none);
+}
+
+TEST_CASE( "Posting from another thread wakes the scheduler", "[frame_scheduler]" ) {
+    nce::FrameScheduler scheduler(-1);
+    std::jthread loader([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        scheduler.post(nce::Damage::asset);
+    });
+    auto begin = Clock::now();
+    scheduler.wait(false, 5'000);
+    REQUIRE(elapsed_ms(begin) < 1'000.0);
+    loader.join();
+    REQUIRE(scheduler.begin_frame() == nce::Damage::asset);
+    REQUIRE_FALSE(scheduler.has_work());
+}
+
+TEST_CASE( "A running animation ticks at its rate and stops", "[frame_scheduler]" ) {
+    nce::FrameScheduler scheduler(-1);
+    scheduler.start_animation(200.0);
+    REQUIRE(scheduler.animating());
+    u64 drawn = 0;
+    auto begin = Clock::now();
+    while (elapsed_ms(begin) < 100.0) {
+        scheduler.wait(false, 1'000);
+        if (scheduler.begin_frame() != nce::Damage::none) { drawn++; }
+    }
+    // 20 ticks in 100 ms, loose bounds for a loaded machine
+    REQUIRE(drawn >= 5);
+    REQUIRE(drawn <= 25);
+
+    scheduler.stop_animation();
+    [[maybe_unused]] auto last = scheduler.begin_frame();
+    scheduler.wait(false, 30);
+    REQUIRE(scheduler.begin_frame() == nce::Damage::none);
+}
+
+TEST_CASE( "Idle cost of spinning versus waiting", "[frame_scheduler]" ) {
+    constexpr f64 RUN_MS = 200.0;
+    auto run = [&](bool continuous) {
+        FakeInput input;
+        nce::FrameScheduler scheduler(input.fds[0], continuous);
+        f64 cpu_begin = cpu_seconds();
+        auto begin = Clock::now();
+        while (elapsed_ms(begin) < RUN_MS) {
+            scheduler.wait(false, static_cast<i32>(RUN_MS));
+            [[maybe_unused]] auto damage = scheduler.begin_frame();
+        }
+        f64 cpu_percent = (cpu_seconds() - cpu_begin) * 1e5 / RUN_MS;
+        f64 wakeups_per_s = static_cast<f64>(scheduler.stats().wakeups) * 1e3 / RUN_MS;
+        fmt::println("{}: {:.1f} wake-ups/s, cpu {:.1f}% of a core", continuous ? "continuous" : "on demand", wakeups_per_s, cpu_percent);
+        return std::pair{wakeups_per_s, cpu_percent};
+    };
+    auto [spin_wakeups, spin_cpu] = run(true);
+    auto [idle_wakeups, idle_cpu] = run(false);
+    REQUIRE(idle_wakeups <= 10.0);
+    REQUIRE(idle_wakeups * 100.0 < spin_wakeups);
+    REQUIRE(idle_cpu < spin_cpu);
+}
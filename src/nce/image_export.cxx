@@ -0,0 +1,283 @@
+#include <nce/image_export.hxx>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fmt/format.h>
+#include <fstream>
+#include <stb/stb_image_write.h>
+
+namespace {
+    constexpr std::array<char, 4> QOI_MAGIC = { 'q', 'o', 'i', 'f' };
+    constexpr size_t QOI_HEADER_SIZE = 14;
+    constexpr std::array<u8, 8> QOI_END = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    constexpr u8 QOI_OP_INDEX = 0x00;
+    constexpr u8 QOI_OP_DIFF = 0x40;
+    constexpr u8 QOI_OP_LUMA = 0x80;
+    constexpr u8 QOI_OP_RUN = 0xc0;
+    constexpr u8 QOI_OP_RGB = 0xfe;
+    constexpr u8 QOI_OP_RGBA = 0xff;
+    constexpr u8 QOI_MASK = 0xc0;
+    constexpr u32 QOI_MAX_RUN = 62;
+
+    struct Pixel {
+        u8 r = 0, g = 0, b = 0, a = 255;
+        [[nodiscard]] auto operator==(const Pixel&) const -> bool = default;
+    };
+
+    auto qoi_hash(Pixel p) -> u32 {
+        return (p.r * 3u + p.g * 5u + p.b * 7u + p.a * 11u) % 64u;
+    }
+
+    auto pixel_at(const vke::PixelView& image, const std::byte* row, u32 x) -> Pixel {
+        const auto* texel = reinterpret_cast<const u8*>(row) + static_cast<size_t>(x) * 4;
+        if (image.order == vke::PixelOrder::bgra) { return Pixel{texel[2], texel[1], texel[0], 255}; }
+        return Pixel{texel[0], texel[1], texel[2], 255};
+    }
+
+    void push(std::vector<std::byte>& out, u8 value) {
+        out.push_back(static_cast<std::byte>(value));
+    }
+    void push_u32_be(std::vector<std::byte>& out, u32 value) {
+        for (i32 shift = 24; shift >= 0; shift -= 8) { push(out, static_cast<u8>(value >> shift)); }
+    }
+    auto read_u32_be(std::span<const std::byte> bytes) -> u32 {
+        u32 value = 0;
+        for (size_t i = 0; i < 4; i++) { value = value << 8 | static_cast<u32>(bytes[i]); }
+        return value;
+    }
+
+    auto valid(const vke::PixelView& image) -> bool {
+        return image.row_pitch >= static_cast<size_t>(image.width) * 4
+            && image.pixels.size() >= static_cast<size_t>(image.row_pitch) * image.height;
+    }
+}
+
+namespace vke {
+    auto image_file_format(const std::filesystem::path& path) -> std::optional<ImageFileFormat> {
+        auto extension = path.extension();
+        if (extension == ".png") { return ImageFileFormat::png; }
+        if (extension == ".qoi") { return ImageFileFormat::qoi; }
+        return std::nullopt;
+    }
+
+    auto encode_qoi(const PixelView& image) -> std::vector<std::byte> {
+        if (!valid(image)) { return {}; }
+        std::vector<std::byte> out;
+        // worst case is one QOI_OP_RGB per pixel
+        out.reserve(QOI_HEADER_SIZE + static_cast<size_t>(image.width) * image.height * 4 + QOI_END.size());
+        for (char c : QOI_MAGIC) { push(out, static_cast<u8>(c)); }
+        push_u32_be(out, image.width);
+        push_u32_be(out, image.height);
+        push(out, 3); // channels
+        push(out, 0); // sRGB with linear alpha
+
+        std::array<Pixel, 64> index{};
+        index.fill(Pixel{0, 0, 0, 0});
+        Pixel previous{};
+        u32 run = 0;
+        for (u32 y = 0; y < image.height; y++) {
+            const std::byte* row = image.pixels.data() + static_cast<size_t>(y) * image.row_pitch;
+            for (u32 x = 0; x < image.width; x++) {
+                Pixel pixel = pixel_at(image, row, x);
+                if (pixel == previous) {
+                    if (++run == QOI_MAX_RUN) {
+                        push(out, static_cast<u8>(QOI_OP_RUN | (run - 1)));
+                        run = 0;
+                    }
+                    continue;
+                }
+                if (run > 0) {
+                    push(out, static_cast<u8>(QOI_OP_RUN | (run - 1)));
+                    run = 0;
+                }
+                u32 slot = qoi_hash(pixel);
+                if (index[slot] == pixel) {
+                    push(out, static_cast<u8>(QOI_OP_INDEX | slot));
+                } else {
+                    index[slot] = pixel;
+                    // differences wrap around, as in the reference encoder
+                    auto dr = static_cast<i8>(pixel.r - previous.r);
+                    auto dg = static_cast<i8>(pixel.g - previous.g);
+                    auto db = static_cast<i8>(pixel.b - previous.b);
+                    i32 dr_dg = dr - dg;
+                    i32 db_dg = db - dg;
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                        push(out, static_cast<u8>(QOI_OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                    } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+                        push(out, static_cast<u8>(QOI_OP_LUMA | (dg + 32)));
+                        push(out, static_cast<u8>((dr_dg + 8) << 4 | (db_dg + 8)));
+                    } else {
+                        push(out, QOI_OP_RGB);
+                        push(out, pixel.r);
+                        push(out, pixel.g);
+                        push(out, pixel.b);
+                    }
+                }
+                previous = pixel;
+            }
+        }
+        if (run > 0) { push(out, static_cast<u8>(QOI_OP_RUN | (run - 1))); }
+        for (u8 b : QOI_END) { push(out, b); }
+        return out;
+    }
+
+    auto decode_qoi(std::span<const std::byte> file) -> std::optional<DecodedImage> {
+        if (file.size() < QOI_HEADER_SIZE + QOI_END.size()
+                || !std::equal(QOI_MAGIC.begin(), QOI_MAGIC.end(), file.begin(), [](char c, std::byte b) { return static_cast<std::byte>(c) == b; })) {
+            return std::nullopt;
+        }
+        DecodedImage image;
+        image.width = read_u32_be(file.subspan(4));
+        image.height = read_u32_be(file.subspan(8));
+        auto channels = static_cast<u8>(file[12]);
+        if (image.width == 0 || image.height == 0 || (channels != 3 && channels != 4)) { return std::nullopt; }
+        size_t pixel_count = static_cast<size_t>(image.width) * image.height;
+        // every op decodes at most 62 pixels from one byte, anything claiming more is truncated
+        if (pixel_count / QOI_MAX_RUN > file.size()) { return std::nullopt; }
+        image.rgba.resize(pixel_count * 4);
+
+        std::array<Pixel, 64> index{};
+        index.fill(Pixel{0, 0, 0, 0});
+        Pixel pixel{};
+        size_t position = QOI_HEADER_SIZE;
+        size_t end = file.size() - QOI_END.size();
+        auto next = [&]() { return static_cast<u8>(file[position++]); };
+        u32 run = 0;
+        for (size_t i = 0; i < pixel_count; i++) {
+            if (run > 0) {
+                run--;
+            } else {
+                if (position >= end) { return std::nullopt; }
+                u8 op = next();
+                if (op == QOI_OP_RGB || op == QOI_OP_RGBA) {
+                    if (position + (op == QOI_OP_RGB ? 3 : 4) > end) { return std::nullopt; }
+                    pixel.r = next();
+                    pixel.g = next();
+                    pixel.b = next();
+                    if (op == QOI_OP_RGBA) { pixel.a = next(); }
+                } else if ((op & QOI_MASK) == QOI_OP_INDEX) {
+                    pixel = index[op];
+                } else if ((op & QOI_MASK) == QOI_OP_DIFF) {
+                    pixel.r = static_cast<u8>(pixel.r + ((op >> 4) & 3) - 2);
+                    pixel.g = static_cast<u8>(pixel.g + ((op >> 2) & 3) - 2);
+                    pixel.b = static_cast<u8>(pixel.b + (op & 3) - 2);
+                } else if ((op & QOI_MASK) == QOI_OP_LUMA) {
+                    if (position >= end) { return std::nullopt; }
+                    u8 second = next();
+                    i32 dg = (op & 0x3f) - 32;
+                    pixel.r = static_cast<u8>(pixel.r + dg - 8 + ((second >> 4) & 0x0f));
+                    pixel.g = static_cast<u8>(pixel.g + dg);
+                    pixel.b = static_cast<u8>(pixel.b + dg - 8 + (second & 0x0f));
+                } else {
+                    run = op & 0x3f;
+                }
+                index[qoi_hash(pixel)] = pixel;
+            }
+            auto* out = reinterpret_cast<u8*>(image.rgba.data()) + i * 4;
+            out[0] = pixel.r;
+            out[1] = pixel.g;
+            out[2] = pixel.b;
+            out[3] = pixel.a;
+        }
+        return image;
+    }
+
+    auto encode_png(const PixelView& image) -> std::vector<std::byte> {
+        if (!valid(image)) { return {}; }
+        // stb wants RGB rows, swizzle and drop alpha in one pass
+        std::vector<u8> rgb(static_cast<size_t>(image.width) * image.height * 3);
+        for (u32 y = 0; y < image.height; y++) {
+            const std::byte* row = image.pixels.data() + static_cast<size_t>(y) * image.row_pitch;
+            u8* out = rgb.data() + static_cast<size_t>(y) * image.width * 3;
+            for (u32 x = 0; x < image.width; x++) {
+                Pixel pixel = pixel_at(image, row, x);
+                out[x * 3 + 0] = pixel.r;
+                out[x * 3 + 1] = pixel.g;
+                out[x * 3 + 2] = pixel.b;
+            }
+        }
+        std::vector<std::byte> png;
+        auto append = [](void* context, void* data, i32 size) {
+            auto* bytes = static_cast<std::byte*>(data);
+            static_cast<std::vector<std::byte>*>(context)->insert(static_cast<std::vector<std::byte>*>(context)->end(), bytes, bytes + size);
+        };
+        if (!stbi_write_png_to_func(append, &png, static_cast<i32>(image.width), static_cast<i32>(image.height), 3, rgb.data(), static_cast<i32>(image.width * 3))) {
+            return {};
+        }
+        return png;
+    }
+
+    ImageExporter::ImageExporter(u32 max_pending) : max_pending(std::max(max_pending, 1u)), worker([this] { run(); }) {}
+
+    ImageExporter::~ImageExporter() {
+        {
+            std::scoped_lock lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+    }
+
+    auto ImageExporter::submit(ExportJob job) -> bool {
+        {
+            std::scoped_lock lock(mutex);
+            if (queue.size() < max_pending && !stopping) {
+                queue.push_back(std::move(job));
+                wake.notify_one();
+                return true;
+            }
+            export_stats.dropped++;
+        }
+        if (job.release) { job.release(); }
+        return false;
+    }
+
+    void ImageExporter::flush() {
+        std::unique_lock lock(mutex);
+        idle.wait(lock, [this] { return queue.empty() && !busy; });
+    }
+
+    auto ImageExporter::stats() const -> ExportStats {
+        std::scoped_lock lock(mutex);
+        return export_stats;
+    }
+
+    void ImageExporter::run() {
+        std::unique_lock lock(mutex);
+        while (true) {
+            wake.wait(lock, [this] { return !queue.empty() || stopping; });
+            // queued jobs are finished before stopping, their pixels have to be released either way
+            if (queue.empty()) { return; }
+            ExportJob job = std::move(queue.front());
+            queue.pop_front();
+            busy = true;
+            lock.unlock();
+
+            auto begin = std::chrono::steady_clock::now();
+            auto format = image_file_format(job.path).value_or(ImageFileFormat::png);
+            std::vector<std::byte> file = format == ImageFileFormat::qoi ? encode_qoi(job.image) : encode_png(job.image);
+            f64 encode_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            if (job.release) { job.release(); }
+
+            bool written = false;
+            if (!file.empty()) {
+                std::ofstream out(job.path, std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+                out.close();
+                written = static_cast<bool>(out);
+            }
+            if (!written) { fmt::println("failed to export {}", job.path.c_str()); }
+
+            lock.lock();
+            busy = false;
+            export_stats.encode_ms += encode_ms;
+            if (written) {
+                export_stats.written++;
+                export_stats.bytes_written += file.size();
+            } else {
+                export_stats.failed++;
+            }
+            if (queue.empty()) { idle.notify_all(); }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <nce/image_export.hxx>
+
+#include <random>
+#include <unistd.h>
+
+/**
+ *  What a capture costs the render thread at 1280x720, against encoding on it.
+ *  Not registered with ctest. "submit" is everything draw_frame does per captured frame once the
+ *  readback landed (the copy itself runs on the GPU), the encoders are what the worker does with it.
+ */
+
+namespace {
+    constexpr u32 WIDTH = 1280;
+    constexpr u32 HEIGHT = 720;
+
+    /// @brief Mostly flat background with a shaded model in the middle, like a viewport.
+    auto viewport_pixels() -> std::vector<std::byte> {
+        std::mt19937 rng(3);
+        std::vector<std::byte> pixels(static_cast<size_t>(WIDTH) * HEIGHT * 4);
+        for (u32 y = 0; y < HEIGHT; y++) {
+            for (u32 x = 0; x < WIDTH; x++) {
+                auto* texel = pixels.data() + (static_cast<size_t>(y) * WIDTH + x) * 4;
+                bool model = x > WIDTH / 4 && x < 3 * WIDTH / 4 && y > HEIGHT / 4 && y < 3 * HEIGHT / 4;
+                u32 shade = model ? (x / 4 + y / 3 + (rng() & 7)) & 0xff : 38;
+                texel[0] = static_cast<std::byte>(shade);
+                texel[1] = static_cast<std::byte>(model ? shade / 2 : 38);
+                texel[2] = static_cast<std::byte>(model ? 255 - shade : 38);
+                texel[3] = std::byte{255};
+            }
+        }
+        return pixels;
+    }
+}
+
+TEST_CASE( "Encoding a captured frame", "[!benchmark][image_export]" ) {
+    auto pixels = viewport_pixels();
+    vke::PixelView view{WIDTH, HEIGHT, WIDTH * 4, vke::PixelOrder::bgra, pixels};
+    fmt::println("qoi {} KiB, png {} KiB, raw {} KiB", vke::encode_qoi(view).size() / 1024, vke::encode_png(view).size() / 1024, pixels.size() / 1024);
+
+    BENCHMARK("encode qoi") {
+        return vke::encode_qoi(view);
+    };
+    BENCHMARK("encode png") {
+        return vke::encode_png(view);
+    };
+
+    auto path = std::filesystem::temp_directory_path() / fmt::format("nce_{}_capture.qoi", getpid());
+    vke::ImageExporter exporter(2);
+    BENCHMARK("submit to the exporter") {
+        return exporter.submit(vke::ExportJob{path, view, {}});
+    };
+    exporter.flush();
+    auto stats = exporter.stats();
+    fmt::println("exporter: {} written, {} dropped, {:.2f} ms encoding per image", stats.written, stats.dropped,
+            stats.written > 0 ? stats.encode_ms / static_cast<f64>(stats.written) : 0.0);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/image_export.hxx>
+#include <nce/mapped_file.hxx>
+
+#include <atomic>
+#include <random>
+#include <unistd.h>
+
+
+namespace {
+    /// @brief A render-like image: flat background, gradients and a noisy block, rows padded to `row_pitch`.
+    auto test_pixels(u32 width, u32 height, u32 row_pitch) -> std::vector<std::byte> {
+        std::mt19937 rng(5);
+        std::vector<std::byte> pixels(static_cast<size_t>(row_pitch) * height, std::byte{0xcd});
+        for (u32 y = 0; y < height; y++) {
+            for (u32 x = 0; x < width; x++) {
+                auto* texel = pixels.data() + static_cast<size_t>(y) * row_pitch + x * 4;
+                u32 value = x < width / 3 ? 38 : x < 2 * width / 3 ? (x + y) * 3 : static_cast<u32>(rng());
+                texel[0] = static_cast<std::byte>(value);
+                texel[1] = static_cast<std::byte>(value >> 8);
+                texel[2] = static_cast<std::byte>(value >> 16 ^ y);
+                texel[3] = static_cast<std::byte>(rng()); // never encoded
+            }
+        }
+        return pixels;
+    }
+
+    auto temp_path(std::string_view name) -> std::filesystem::path {
+        return std::filesystem::temp_directory_path() / fmt::format("nce_{}_{}", getpid(), name);
+    }
+}
+
+TEST_CASE( "QOI round trips both pixel orders and padded rows", "[image_export]" ) {
+    constexpr u32 width = 97;
+    constexpr u32 height = 61;
+    auto order = GENERATE(vke::PixelOrder::rgba, vke::PixelOrder::bgra);
+    auto row_pitch = GENERATE(width * 4, width * 4 + 12);
+    auto pixels = test_pixels(width, height, row_pitch);
+    vke::PixelView view{width, height, row_pitch, order, pixels};
+
+    auto file = vke::encode_qoi(view);
+    REQUIRE(file.size() < pixels.size());
+    auto decoded = vke::decode_qoi(file);
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->width == width);
+    REQUIRE(decoded->height == height);
+    for (u32 y = 0; y < height; y++) {
+        for (u32 x = 0; x < width; x++) {
+            const auto* src = pixels.data() + static_cast<size_t>(y) * row_pitch + x * 4;
+            const auto* dst = decoded->rgba.data() + (static_cast<size_t>(y) * width + x) * 4;
+            bool bgra = order == vke::PixelOrder::bgra;
+            REQUIRE(dst[0] == src[bgra ? 2 : 0]);
+            REQUIRE(dst[1] == src[1]);
+            REQUIRE(dst[2] == src[bgra ? 0 : 2]);
+            REQUIRE(dst[3] == std::byte{255});
+        }
+    }
+}
+
+TEST_CASE( "Malformed QOI files are rejected", "[image_export]" ) {
+    auto pixels = test_pixels(32, 32, 32 * 4);
+    auto file = vke::encode_qoi(vke::PixelView{32, 32, 32 * 4, vke::PixelOrder::rgba, pixels});
+    REQUIRE(vke::decode_qoi(file).has_value());
+
+    SECTION( "truncated" ) {
+        file.resize(file.size() / 2);
+    }
+    SECTION( "wrong magic" ) {
+        file[0] = std::byte{'x'};
+    }
+    SECTION( "too small for its dimensions" ) {
+        file[4] = std::byte{0x7f};
+    }
+    REQUIRE_FALSE(vke::decode_qoi(file).has_value());
+}
+
+TEST_CASE( "PNG output starts with the signature", "[image_export]" ) {
+    auto pixels = test_pixels(40, 20, 40 * 4);
+    auto png = vke::encode_png(vke::PixelView{40, 20, 40 * 4, vke::PixelOrder::bgra, pixels});
+    REQUIRE(png.size() > 8);
+    constexpr std::array<u8, 8> signature = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    for (size_t i = 0; i < signature.size(); i++) {
+        REQUIRE(png[i] == std::byte{signature[i]});
+    }
+    REQUIRE(vke::encode_png(vke::PixelView{40, 20, 40 * 4, vke::PixelOrder::bgra, std::span(pixels).first(100)}).empty());
+}
+
+TEST_CASE( "The exporter writes queued jobs and drops past its limit", "[image_export]" ) {
+    constexpr u32 size = 64;
+    auto pixels = test_pixels(size, size, size * 4);
+    std::atomic<u32> released = 0;
+    std::vector<std::filesystem::path> paths;
+    u32 accepted = 0;
+    {
+        vke::ImageExporter exporter(2);
+        for (u32 i = 0; i < 16; i++) {
+            paths.push_back(temp_path(fmt::format("export_{}.{}", i, i % 2 ? "qoi" : "png")));
+            vke::ExportJob job{paths.back(), vke::PixelView{size, size, size * 4, vke::PixelOrder::rgba, pixels}, [&] { released++; }};
+            accepted += exporter.submit(std::move(job)) ? 1u : 0u;
+        }
+        exporter.flush();
+        auto stats = exporter.stats();
+        REQUIRE(stats.written == accepted);
+        REQUIRE(stats.dropped == 16u - accepted);
+        REQUIRE(stats.failed == 0);
+        REQUIRE(released == 16);
+
+        // still usable after a flush, the destructor finishes it
+        paths.push_back(temp_path("export_last.qoi"));
+        REQUIRE(exporter.submit(vke::ExportJob{paths.back(), vke::PixelView{size, size, size * 4, vke::PixelOrder::rgba, pixels}, [&] { released++; }}));
+    }
+    REQUIRE(released == 17);
+    REQUIRE(accepted >= 2);
+
+    auto last = vke::MappedFile::open(paths.back());
+    REQUIRE(last.has_value());
+    REQUIRE(vke::decode_qoi(last->bytes()).has_value());
+    for (const auto& path : paths) { std::filesystem::remove(path); }
+}
+
+TEST_CASE( "Export failures are counted", "[image_export]" ) {
+    auto pixels = test_pixels(8, 8, 8 * 4);
+    vke::ImageExporter exporter;
+    REQUIRE(exporter.submit(vke::ExportJob{"/nonexistent/dir/shot.png", vke::PixelView{8, 8, 8 * 4, vke::PixelOrder::rgba, pixels}, {}}));
+    exporter.flush();
+    REQUIRE(exporter.stats().failed == 1);
+    REQUIRE(vke::image_file_format("shot.qoi") == vke::ImageFileFormat::qoi);
+    REQUIRE_FALSE(vke::image_file_format("shot.jpg").has_value());
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <nce/mapped_file.hxx>
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vke {
+
+/**
+ *  Asset pack layout, little endian:
+ *      PackHeader
+ *      PackEntry[entry_count]      sorted by name_hash, then name
+ *      names                       entry names back to back, not null terminated
+ *      entry data                  every entry starts at a multiple of PACK_ALIGNMENT
+ *  Offsets are from the start of the file. Aligned entries map onto whole pages, so an uncompressed
+ *  entry can be handed out as a view of the mapping and only its own pages are faulted in.
+ */
+constexpr u32 PACK_MAGIC = 0x5045434e; ///< "NCEP"
+constexpr u32 PACK_VERSION = 1;
+constexpr u64 PACK_ALIGNMENT = 4096;
+
+enum class PackCompression : u32 {
+    none = 0,
+    lz4 = 1, ///< nce/lz4_block.hxx
+};
+
+struct PackHeader {
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 names_size;
+};
+
+struct PackEntry {
+    u64 name_hash;
+    u64 offset;
+    u64 stored_size; ///< bytes in the pack
+    u64 size; ///< bytes once decompressed
+    u32 name_offset; ///< into the names block
+    u32 name_length;
+    PackCompression compression;
+    u32 reserved;
+};
+
+/// @brief FNV-1a, the pack's name hash.
+[[nodiscard]] constexpr auto hash_asset_name(std::string_view name) -> u64 {
+    u64 hash = 0xcbf29ce484222325ull;
+    for (char c : name) {
+        hash = (hash ^ static_cast<u8>(c)) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+struct PackInput {
+    std::string name;
+    std::vector<std::byte> data;
+    bool compress = false; ///< lz4, only kept when it saves at least an eighth. Trades disk size for decompression time
+};
+
+/// @brief Serialize a whole pack. Aborts on duplicate names.
+[[nodiscard]] auto build_pack(std::vector<PackInput> inputs) -> std::vector<std::byte>;
+
+/// @brief Bytes of one asset: a view of the pack, a decompressed copy, or a loose file.
+struct Asset {
+    std::span<const std::byte> bytes;
+    std::vector<std::byte> decompressed;
+    std::optional<MappedFile> file;
+};
+
+/**
+ *  @brief Read side of a pack, the file is mapped once and stays mapped.
+ *  Lookups are a binary search over the table of contents. Uncompressed entries are returned without a copy.
+ *  All member functions are const and safe to call from several threads.
+ */
+class AssetPack {
+public:
+    /// @brief std::nullopt if the file cannot be read or is not a valid pack of this version.
+    [[nodiscard]] static auto open(const std::filesystem::path& path) -> std::optional<AssetPack>;
+    [[nodiscard]] static auto from_file(MappedFile file) -> std::optional<AssetPack>;
+
+    [[nodiscard]] auto find(std::string_view name) const -> const PackEntry*;
+    [[nodiscard]] auto name(const PackEntry& entry) const -> std::string_view;
+    /// @brief std::nullopt if `name` is not in the pack. Aborts on a corrupt compressed entry.
+    [[nodiscard]] auto read(std::string_view name) const -> std::optional<Asset>;
+    [[nodiscard]] auto entries() const -> std::span<const PackEntry> { return table; }
+
+private:
+    explicit AssetPack(MappedFile file) : file(std::move(file)) {}
+
+    MappedFile file;
+    std::vector<PackEntry> table;
+    std::string_view names;
+};
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace vke {
+
+/// @brief Bindings of the global bindless descriptor set (set 1), mirrored in the shaders.
+enum BindlessBinding : u32 {
+    bindless_textures = 0, ///< sampler2D textures[]
+    bindless_storage_buffers = 1 ///< readonly buffer { ... } buffers[]
+};
+
+constexpr u32 MAX_BINDLESS_TEXTURES = 4096;
+constexpr u32 MAX_BINDLESS_STORAGE_BUFFERS = 1024;
+constexpr u32 BINDLESS_SET = 1;
+
+/**
+ *  @brief Hands out stable indices into a bindless descriptor array.
+ *  Released slots may still be referenced by frames in flight, they are held back for
+ *  `frames_in_flight` calls to next_frame() before being handed out again. Reuse is LIFO
+ *  so the live range of the array stays dense.
+ */
+struct SlotAllocator {
+    constexpr static u32 INVALID = std::numeric_limits<u32>::max();
+
+    u32 capacity;
+    u32 high_water = 0; ///< slots below this index have been handed out at least once
+    u32 live = 0;
+    std::vector<u32> free_slots;
+    std::vector<std::vector<u32>> retired; ///< per frame in flight, slots released during that frame
+    u32 frame = 0;
+
+    SlotAllocator(u32 capacity, u32 frames_in_flight) : capacity(capacity), retired(frames_in_flight) {}
+
+    [[nodiscard]] auto allocate() -> std::optional<u32>;
+    /// @brief Return a slot, it becomes reusable once every frame that might read it has completed.
+    void release(u32 slot);
+    /// @brief Called once per frame after the fence of the frame being reused was waited on.
+    void next_frame();
+    [[nodiscard]] auto size() const -> u32 { return live; }
+};
+
+}
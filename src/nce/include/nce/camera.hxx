@@ -0,0 +1,55 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace vke {
+
+/// @brief Look-at camera with a perspective projection.
+struct Camera {
+    glm::vec3 eye;
+    glm::vec3 center;
+    glm::vec3 up;
+    f32 fov_y; ///< radians
+    f32 near_plane;
+    f32 far_plane;
+
+    auto operator==(const Camera&) const -> bool = default;
+};
+
+/// @brief The per-frame camera block of hello.vert (set 0, binding 0), std140 layout.
+struct CameraMatrices {
+    glm::mat4 view;
+    glm::mat4 proj; ///< y flipped for Vulkan clip space
+};
+
+[[nodiscard]] auto camera_matrices(const Camera& camera, VkExtent2D extent) -> CameraMatrices;
+
+/**
+ *  @brief Dirty tracking of the camera block.
+ *  Every frame in flight owns a copy of the block, a change has to be written to each copy once.
+ *  Frames whose copy is current skip the write entirely.
+ */
+struct CameraTracker {
+    Camera camera{};
+    VkExtent2D extent{};
+    CameraMatrices matrices{}; ///< valid after consume()
+    u64 version = 1; ///< bumped by every change, copies start at 0 so the first frames always write
+    u64 matrices_version = 0;
+    std::vector<u64> written; ///< per frame in flight, the version its copy holds
+
+    explicit CameraTracker(u32 frames_in_flight) : written(frames_in_flight, 0) {}
+
+    /// @brief No-op when nothing changed.
+    void set_camera(const Camera& camera);
+    /// @brief No-op when nothing changed, the projection depends on the aspect ratio.
+    void set_extent(VkExtent2D extent);
+    /// @brief Whether `frame`'s copy is stale, marks it current. The caller writes `matrices` when true.
+    [[nodiscard]] auto consume(u32 frame) -> bool;
+};
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <array>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace vke {
+
+/// @brief Bounding sphere of an object, std430 layout shared with cull.comp.
+struct ObjectBounds {
+    glm::vec3 center;
+    f32 radius;
+};
+
+/// @brief Sphere enclosing an axis aligned box.
+[[nodiscard]] auto sphere_from_aabb(glm::vec3 min, glm::vec3 max) -> ObjectBounds;
+/// @brief Move a sphere into the space of `model`, the radius grows with the largest axis scale.
+[[nodiscard]] auto transform_bounds(const ObjectBounds& bounds, const glm::mat4& model) -> ObjectBounds;
+
+/**
+ *  @brief The six clip planes of a view-projection matrix (Vulkan clip space, depth in [0, 1]).
+ *  Normals point inwards and are normalized, so plane distances are in world units.
+ */
+struct Frustum {
+    enum Plane : u32 { left, right, bottom, top, near, far };
+    std::array<glm::vec4, 6> planes;
+
+    [[nodiscard]] static auto from_view_proj(const glm::mat4& view_proj) -> Frustum;
+    [[nodiscard]] auto intersects(const ObjectBounds& bounds) const -> bool;
+};
+
+constexpr u32 CULL_WORKGROUP_SIZE = 64; ///< local_size_x of cull.comp
+constexpr u32 HIZ_WORKGROUP_SIZE = 8; ///< local_size_x and local_size_y of hiz.comp
+/// @brief The draw buffer starts with one draw count per phase, padded so the commands that follow stay 16 byte aligned.
+constexpr VkDeviceSize CULL_DRAWS_OFFSET = 16;
+
+/**
+ *  @brief Two-phase occlusion culling.
+ *  The early phase draws what was visible last frame, its depth is reduced into the Hi-Z pyramid.
+ *  The late phase tests every object against the pyramid, draws the ones that became visible and
+ *  records the visibility the next frame's early phase uses.
+ */
+enum CullPhase : u32 {
+    cull_early = 0,
+    cull_late = 1
+};
+
+/// @brief Push constants of cull.comp, frustum planes are extracted from view_proj in the shader.
+struct CullPushConstants {
+    glm::mat4 view_proj;
+    glm::vec2 hiz_size; ///< mip 0 of the Hi-Z pyramid in texels
+    u32 object_count;
+    u32 index_count; ///< every object draws the same mesh
+    u32 bounds_buffer; ///< bindless slot of the ObjectBounds buffer
+    u32 draw_buffer; ///< bindless slot of the counts + VkDrawIndexedIndirectCommand buffer
+    u32 visibility_buffer; ///< bindless slot of the per-object visibility of the last late phase
+    u32 phase; ///< CullPhase
+    u32 culling; ///< 0 draws every object in the early phase, for measuring what culling saves
+};
+
+struct HiZPushConstants {
+    glm::vec2 size; ///< of the mip being written
+};
+
+/**
+ *  @brief CPU reference of cull.comp's frustum test.
+ *  Appends one draw per object intersecting `frustum`, firstInstance is the object index. The shader
+ *  appends in whatever order its atomics resolve, compare against it after sorting by firstInstance.
+ */
+void cull_reference(const Frustum& frustum, std::span<const ObjectBounds> bounds, u32 index_count, std::vector<VkDrawIndexedIndirectCommand>& draws);
+
+/// @brief Screen space rectangle of projected bounds, uv in [0, 1] and the depth of the nearest point.
+struct ScreenBounds {
+    glm::vec2 min;
+    glm::vec2 max;
+    f32 nearest_depth;
+};
+
+/// @brief Project the box around a sphere, std::nullopt when it crosses the near plane.
+[[nodiscard]] auto project_bounds(const glm::mat4& view_proj, const ObjectBounds& bounds) -> std::optional<ScreenBounds>;
+
+/// @brief Mip 0 of the Hi-Z pyramid, the depth extent rounded down to powers of two.
+[[nodiscard]] auto hiz_extent(VkExtent2D depth_extent) -> VkExtent2D;
+[[nodiscard]] auto hiz_mip_count(VkExtent2D extent) -> u32;
+/// @brief Source texels [first, last) along one axis below `texel` of a level `size` texels wide, hiz.comp reduces the same ones.
+[[nodiscard]] auto hiz_footprint(u32 texel, u32 source_size, u32 size) -> std::pair<u32, u32>;
+
+/**
+ *  @brief CPU reference of the Hi-Z pyramid, each texel holds the farthest depth below it.
+ *  sample() behaves like the max reduction sampler hiz.comp and cull.comp use.
+ */
+struct DepthPyramid {
+    VkExtent2D extent; ///< of mip 0
+    std::vector<std::vector<f32>> levels;
+
+    [[nodiscard]] static auto build(std::span<const f32> depth, VkExtent2D depth_extent) -> DepthPyramid;
+    [[nodiscard]] auto level_extent(u32 level) const -> VkExtent2D;
+    /// @brief Farthest depth of the 2x2 texels a bilinear fetch at `uv` would read.
+    [[nodiscard]] auto sample(glm::vec2 uv, u32 level) const -> f32;
+    /// @brief Whether everything inside `bounds` lies behind the depth stored in the pyramid.
+    [[nodiscard]] auto occludes(const ScreenBounds& bounds) const -> bool;
+};
+
+/// @brief CPU reference of the late phase, draws every object in the frustum not occluded by `pyramid`.
+void occlusion_cull_reference(const glm::mat4& view_proj, const DepthPyramid& pyramid, std::span<const ObjectBounds> bounds, u32 index_count, std::vector<VkDrawIndexedIndirectCommand>& draws);
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace vke {
+
+struct DescriptorBinding {
+    u32 binding;
+    VkDescriptorType type;
+    u32 count;
+    VkShaderStageFlags stages;
+    VkDescriptorBindingFlags flags = 0;
+
+    [[nodiscard]] auto operator==(const DescriptorBinding& o) const -> bool = default;
+};
+
+/// @brief Everything that identifies a VkDescriptorSetLayout, bindings are kept sorted by binding index.
+struct DescriptorLayoutKey {
+    std::vector<DescriptorBinding> bindings;
+    VkDescriptorSetLayoutCreateFlags flags = 0;
+
+    DescriptorLayoutKey(std::vector<DescriptorBinding> bindings, VkDescriptorSetLayoutCreateFlags flags = 0);
+    [[nodiscard]] auto operator==(const DescriptorLayoutKey& o) const -> bool = default;
+};
+
+/// @brief One resource written into a descriptor set, `handle` is the VkBuffer or VkImageView.
+struct DescriptorWrite {
+    u32 binding;
+    VkDescriptorType type;
+    void* handle;
+    VkDeviceSize offset = 0;
+    VkDeviceSize range = 0;
+    VkSampler sampler = VK_NULL_HANDLE;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    [[nodiscard]] auto operator==(const DescriptorWrite& o) const -> bool = default;
+};
+
+/// @brief Identifies an immutable descriptor set: its layout and the resources written into it.
+struct DescriptorSetKey {
+    VkDescriptorSetLayout layout;
+    std::vector<DescriptorWrite> writes;
+
+    [[nodiscard]] auto operator==(const DescriptorSetKey& o) const -> bool = default;
+};
+
+struct DescriptorLayoutKeyHash { auto operator()(const DescriptorLayoutKey& key) const -> std::size_t; };
+struct DescriptorSetKeyHash { auto operator()(const DescriptorSetKey& key) const -> std::size_t; };
+
+struct DescriptorStats {
+    u64 allocations = 0; ///< sets allocated from pools since startup
+    u32 pool_count = 0; ///< pools currently alive
+    u64 cache_hits = 0;
+    u64 cache_misses = 0;
+
+    [[nodiscard]] auto hit_rate() const -> f64 {
+        u64 lookups = cache_hits + cache_misses;
+        return lookups == 0 ? 0.0 : static_cast<f64>(cache_hits) / static_cast<f64>(lookups);
+    }
+};
+
+/**
+ *  @brief Deduplicates descriptor set layouts and immutable descriptor sets.
+ *  Lookups hash the binding description, only misses call `create`. Layouts are destroyed with
+ *  the cache when it was given a device, sets live as long as the pool they came from.
+ */
+struct DescriptorCache {
+    using CreateLayoutFn = std::function<VkDescriptorSetLayout(const DescriptorLayoutKey& key)>;
+    using CreateSetFn = std::function<VkDescriptorSet(const DescriptorSetKey& key)>;
+
+    VkDevice device = VK_NULL_HANDLE;
+    std::unordered_map<DescriptorLayoutKey, VkDescriptorSetLayout, DescriptorLayoutKeyHash> layouts;
+    std::unordered_map<DescriptorSetKey, VkDescriptorSet, DescriptorSetKeyHash> sets;
+    u64 hits = 0;
+    u64 misses = 0;
+
+    DescriptorCache() = default;
+    DescriptorCache(const DescriptorCache&) = delete;
+    auto operator=(const DescriptorCache&) -> DescriptorCache& = delete;
+    ~DescriptorCache();
+
+    [[nodiscard]] auto layout(const DescriptorLayoutKey& key, const CreateLayoutFn& create) -> VkDescriptorSetLayout;
+    /// @brief Create (through vkCreateDescriptorSetLayout) or reuse a layout.
+    [[nodiscard]] auto layout(const DescriptorLayoutKey& key) -> VkDescriptorSetLayout;
+    [[nodiscard]] auto set(const DescriptorSetKey& key, const CreateSetFn& create) -> VkDescriptorSet;
+};
+
+/**
+ *  @brief Allocates descriptor sets from a growing chain of pools.
+ *  When a pool runs out (VK_ERROR_OUT_OF_POOL_MEMORY / VK_ERROR_FRAGMENTED_POOL) the next one is
+ *  taken, each new pool holds twice as many sets as the previous up to MAX_SETS_PER_POOL.
+ *  reset() recycles every pool at once, individual sets are never freed. The overloads taking
+ *  functions run the same policy without a device, pools are destroyed only when it was given one.
+ */
+struct DescriptorAllocator {
+    constexpr static u32 INITIAL_SETS_PER_POOL = 64;
+    constexpr static u32 MAX_SETS_PER_POOL = 4096;
+
+    using CreatePoolFn = std::function<VkDescriptorPool(u32 max_sets)>;
+    using AllocateSetFn = std::function<VkResult(VkDescriptorPool pool, VkDescriptorSet& set)>;
+    using ResetPoolFn = std::function<void(VkDescriptorPool pool)>;
+
+    /// @brief Descriptors per set of a type, pool sizes are `ratio * sets_per_pool`.
+    struct PoolRatio {
+        VkDescriptorType type;
+        f32 ratio;
+    };
+
+    VkDevice device = VK_NULL_HANDLE;
+    std::vector<PoolRatio> ratios;
+    VkDescriptorPoolCreateFlags flags = 0;
+    VkDescriptorPool current = VK_NULL_HANDLE;
+    std::vector<VkDescriptorPool> used_pools; ///< full pools, including `current`
+    std::vector<VkDescriptorPool> free_pools; ///< reset and ready for reuse
+    u32 sets_per_pool = INITIAL_SETS_PER_POOL;
+    u64 allocations = 0;
+
+    DescriptorAllocator() = default;
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    auto operator=(const DescriptorAllocator&) -> DescriptorAllocator& = delete;
+    ~DescriptorAllocator();
+
+    void init(VkDevice device, std::vector<PoolRatio> ratios, VkDescriptorPoolCreateFlags flags = 0);
+    [[nodiscard]] auto allocate(const CreatePoolFn& create_pool, const AllocateSetFn& allocate_set) -> VkDescriptorSet;
+    /// @brief Allocate a set of `layout` through vkAllocateDescriptorSets, pools come from vkCreateDescriptorPool.
+    [[nodiscard]] auto allocate(VkDescriptorSetLayout layout) -> VkDescriptorSet;
+    void reset(const ResetPoolFn& reset_pool);
+    /// @brief Return every set to its pool, only valid once no command buffer references them.
+    void reset();
+    [[nodiscard]] auto pool_count() const -> u32 { return static_cast<u32>(used_pools.size() + free_pools.size()); }
+    [[nodiscard]] auto grab_pool(const CreatePoolFn& create_pool) -> VkDescriptorPool;
+};
+
+/// @brief Sets allocated, pools alive and the cache's hit rate on one line.
+void print_descriptor_stats(const DescriptorStats& stats);
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include <nce/spsc_ring.hxx>
+#include <nce/triple_buffer.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace nce {
+
+/// @brief An input for the simulation and the tick it belongs to, 0 for the next tick whichever it is.
+template<typename Input> struct TickedInput {
+    Input input;
+    u64 tick = 0;
+};
+
+/**
+ *  @brief The deterministic part of a fixed timestep simulation: a state, a step function and the
+ *  inputs waiting for their tick. Tick n is the step that produces the state after n steps, it gets
+ *  every input for tick n or earlier in submission order. Nothing here looks at a clock, the same
+ *  initial state and inputs give the same state after any number of ticks.
+ */
+template<typename State, typename Input> class FixedStepper {
+public:
+    using Step = std::function<void(State& state, std::span<const Input> inputs, f64 dt)>;
+
+    FixedStepper(State initial, Step step, f64 dt) : current(std::move(initial)), step_fn(std::move(step)), dt(dt) {}
+
+    void submit(const TickedInput<Input>& input) { pending.push_back(input); }
+    /// @brief Run tick `tick() + 1`.
+    void step() {
+        u64 next = ticks + 1;
+        inputs.clear();
+        // stable, inputs of one tick keep their submission order
+        auto later = std::stable_partition(pending.begin(), pending.end(), [&](const TickedInput<Input>& ticked) {
+            return ticked.tick <= next;
+        });
+        for (auto it = pending.begin(); it != later; ++it) { inputs.push_back(it->input); }
+        pending.erase(pending.begin(), later);
+        step_fn(current, inputs, dt);
+        ticks = next;
+    }
+
+    [[nodiscard]] auto state() const -> const State& { return current; }
+    [[nodiscard]] auto tick() const -> u64 { return ticks; }
+    [[nodiscard]] auto step_seconds() const -> f64 { return dt; }
+
+private:
+    State current;
+    Step step_fn;
+    f64 dt;
+    u64 ticks = 0;
+    std::vector<TickedInput<Input>> pending;
+    std::vector<Input> inputs; ///< reused, nothing is allocated per tick once it has grown
+};
+
+/**
+ *  @brief What the render thread gets from the simulation: the last two states and when the newer one
+ *  was due. Rendering blends them with alpha(now), which trails the simulation by up to one tick but
+ *  moves smoothly whatever the two rates are.
+ */
+template<typename State> struct TickSnapshot {
+    State previous{};
+    State current{};
+    u64 tick = 0; ///< current is the state after this many ticks
+    i64 due_ns = 0; ///< steady clock time at which tick `tick` was due
+    i64 step_ns = 0;
+
+    /// @brief Weight of `current` for a frame rendered at `now_ns`, 0 right when it was due, 1 a tick later.
+    [[nodiscard]] auto alpha(i64 now_ns) const -> f64 {
+        if (step_ns <= 0) { return 1.0; }
+        return std::clamp(static_cast<f64>(now_ns - due_ns) / static_cast<f64>(step_ns), 0.0, 1.0);
+    }
+};
+
+struct SimulationStats {
+    u64 ticks = 0;
+    u64 late_wakeups = 0; ///< wake-ups that had to run more than one tick to catch up
+    u64 dropped_ticks = 0; ///< ticks given up on after falling max_catch_up behind, the simulation slowed down instead
+};
+
+/**
+ *  @brief Runs a FixedStepper at a fixed rate on its own thread and publishes a TickSnapshot after
+ *  every batch of ticks through a TripleBuffer.
+ *  The render thread submits input through an SPSC ring and reads snapshots, neither side takes a lock
+ *  or waits for the other: a heavy frame only means the renderer skips snapshots, a heavy tick only
+ *  means it sees the same one twice. The thread sleeps between ticks and runs up to max_catch_up ticks
+ *  at once when it woke up late.
+ */
+template<typename State, typename Input, u32 INPUT_CAPACITY = 1024> class SimulationThread {
+public:
+    using Step = typename FixedStepper<State, Input>::Step;
+    using Snapshot = TickSnapshot<State>;
+
+    struct Options {
+        f64 hz = 120.0;
+        u32 max_catch_up = 8;
+        u64 max_ticks = 0; ///< stop stepping after this many ticks, 0 runs until destroyed
+    };
+
+    SimulationThread(State initial, Step step, Options options)
+        : stepper(initial, std::move(step), 1.0 / options.hz),
+        snapshots(Snapshot{initial, initial, 0, now_ns(), static_cast<i64>(1e9 / options.hz)}),
+        options(options) {
+        thread = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+    ~SimulationThread() {
+        thread.request_stop();
+        thread.join();
+    }
+
+    /// @brief Render thread only, false when INPUT_CAPACITY inputs are already waiting.
+    auto submit(const Input& input, u64 tick = 0) -> bool { return inputs.try_push(TickedInput<Input>{input, tick}); }
+    /// @brief Render thread only, the newest snapshot, unchanged until the next call.
+    [[nodiscard]] auto snapshot() -> const Snapshot& { return snapshots.read(); }
+    [[nodiscard]] auto ticks() const -> u64 { return published_ticks.load(std::memory_order_acquire); }
+    /// @brief Only meaningful once the thread stopped stepping (max_ticks) or from the simulation thread.
+    [[nodiscard]] auto stats() const -> const SimulationStats& { return counters; }
+
+    [[nodiscard]] static auto now_ns() -> i64 {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    void run(std::stop_token stop) {
+        const i64 step_ns = static_cast<i64>(1e9 / options.hz);
+        i64 start_ns = now_ns();
+        std::mutex sleep_mutex; // only ever locked by this thread, the condition variable needs one to wake up on stop
+        std::condition_variable_any sleeper;
+        while (!stop.stop_requested()) {
+            if (options.max_ticks != 0 && stepper.tick() >= options.max_ticks) {
+                std::unique_lock lock(sleep_mutex);
+                sleeper.wait(lock, stop, [] { return false; });
+                return;
+            }
+            i64 now = now_ns();
+            u32 steps = 0;
+            while (start_ns + static_cast<i64>(stepper.tick() + 1) * step_ns <= now) {
+                if (steps == options.max_catch_up) {
+                    // too far behind to catch up, give the time up rather than spiral
+                    u64 behind = static_cast<u64>((now - start_ns) / step_ns) - stepper.tick();
+                    counters.dropped_ticks += behind;
+                    start_ns += static_cast<i64>(behind) * step_ns;
+                    break;
+                }
+                while (auto input = inputs.try_pop()) { stepper.submit(*input); }
+                before_last_tick = stepper.state();
+                stepper.step();
+                steps++;
+                if (options.max_ticks != 0 && stepper.tick() >= options.max_ticks) { break; }
+            }
+            if (steps > 0) {
+                counters.ticks += steps;
+                counters.late_wakeups += steps > 1;
+                publish(start_ns + static_cast<i64>(stepper.tick()) * step_ns, step_ns);
+            }
+            auto due = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(start_ns + static_cast<i64>(stepper.tick() + 1) * step_ns));
+            std::unique_lock lock(sleep_mutex);
+            sleeper.wait_until(lock, stop, due, [] { return false; });
+        }
+    }
+
+    void publish(i64 due_ns, i64 step_ns) {
+        Snapshot& snapshot = snapshots.write_buffer();
+        snapshot.previous = before_last_tick;
+        snapshot.current = stepper.state();
+        snapshot.tick = stepper.tick();
+        snapshot.due_ns = due_ns;
+        snapshot.step_ns = step_ns;
+        snapshots.publish();
+        published_ticks.store(stepper.tick(), std::memory_order_release);
+    }
+
+    FixedStepper<State, Input> stepper;
+    SpscRing<TickedInput<Input>, INPUT_CAPACITY> inputs;
+    TripleBuffer<Snapshot> snapshots;
+    State before_last_tick = stepper.state(); ///< copied before every tick, the snapshot blends from it
+    std::atomic<u64> published_ticks = 0;
+    SimulationStats counters;
+    Options options;
+    std::jthread thread; ///< last, starts once everything it uses exists
+};
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+
+namespace nce {
+
+/// @brief Why a frame has to be drawn, several reasons are or'ed together.
+enum class Damage : u32 {
+    none = 0,
+    input = 1 << 0,
+    resize = 1 << 1,
+    expose = 1 << 2,
+    animation = 1 << 3, ///< the animation timer ticked, or the scheduler runs continuously
+    asset = 1 << 4, ///< a load finished on another thread
+};
+[[nodiscard]] constexpr auto operator|(Damage a, Damage b) -> Damage { return static_cast<Damage>(static_cast<u32>(a) | static_cast<u32>(b)); }
+[[nodiscard]] constexpr auto operator&(Damage a, Damage b) -> Damage { return static_cast<Damage>(static_cast<u32>(a) & static_cast<u32>(b)); }
+constexpr auto operator|=(Damage& a, Damage b) -> Damage& { return a = a | b; }
+
+struct SchedulerStats {
+    u64 wakeups = 0; ///< times wait() returned, every iteration of a loop that never blocks
+    u64 blocks = 0; ///< times wait() had to sleep
+    u64 frames = 0; ///< begin_frame() calls that asked for a draw
+    u64 skipped = 0; ///< begin_frame() calls with nothing to draw
+    u64 timer_ticks = 0; ///< animation timer expirations, more than wakeups when frames fall behind
+    f64 blocked_ms = 0.0; ///< time spent inside wait()
+};
+
+/**
+ *  @brief Decides when the main loop draws and puts it to sleep when nothing changed.
+ *  The loop draws only when something damaged the scene: input, a resize or expose, a running
+ *  animation or a post() from another thread. Otherwise wait() blocks in poll() on the input fd (the X
+ *  connection or the input thread's ready fd), a timerfd that ticks only while an animation runs and an
+ *  eventfd for post(). An idle window does not wake up at all.
+ *  Continuous mode draws every iteration and never blocks, for benchmarks and scenes that always move.
+ */
+class FrameScheduler {
+public:
+    /// @brief `input_fd` becomes readable when input arrives, -1 to wait on the timer and posts only.
+    explicit FrameScheduler(i32 input_fd, bool continuous = false);
+    ~FrameScheduler();
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    void set_continuous(bool continuous) { this->continuous = continuous; }
+    [[nodiscard]] auto is_continuous() const -> bool { return continuous; }
+    /// @brief Draw `hz` frames per second until stop_animation(), e.g. while the camera flies to a part.
+    void start_animation(f64 hz);
+    void stop_animation();
+    [[nodiscard]] auto animating() const -> bool { return animation; }
+
+    /// @brief Render thread only.
+    void damage(Damage reason) { pending |= reason; }
+    /// @brief Any thread, wakes a blocked wait().
+    void post(Damage reason);
+
+    /// @brief Whether wait() would return right away.
+    [[nodiscard]] auto has_work() const -> bool;
+    /**
+     *  @brief Block until input arrives, the animation timer ticks or something is posted, unless there
+     *  already is work. `input_pending` is for input already read off the fd, e.g. into xcb's queue.
+     *  `timeout_ms` -1 waits forever.
+     */
+    void wait(bool input_pending = false, i32 timeout_ms = -1);
+    /// @brief Damage since the last frame, Damage::none means the frame can be skipped.
+    [[nodiscard]] auto begin_frame() -> Damage;
+
+    [[nodiscard]] auto stats() const -> const SchedulerStats& { return counters; }
+
+private:
+    i32 input_fd;
+    i32 timer_fd = -1;
+    i32 wake_fd = -1;
+    bool continuous;
+    bool animation = false;
+    Damage pending = Damage::none;
+    std::atomic<u32> posted = 0;
+    SchedulerStats counters;
+};
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace vke {
+
+enum class PixelOrder : u8 {
+    rgba,
+    bgra, ///< the swapchain's B8G8R8A8 formats
+};
+
+enum class ImageFileFormat : u8 {
+    png,
+    qoi, ///< encodes an order of magnitude faster than png at a similar size for renders, meant for continuous capture
+};
+
+/// @brief Format chosen by the file extension, std::nullopt for anything but .png and .qoi.
+[[nodiscard]] auto image_file_format(const std::filesystem::path& path) -> std::optional<ImageFileFormat>;
+
+/// @brief 8 bit, 4 channel pixels read back from an image, rows `row_pitch` bytes apart.
+struct PixelView {
+    u32 width = 0;
+    u32 height = 0;
+    u32 row_pitch = 0;
+    PixelOrder order = PixelOrder::rgba;
+    std::span<const std::byte> pixels;
+};
+
+/// @brief Screenshots are opaque, both encoders write RGB and drop the alpha channel.
+[[nodiscard]] auto encode_qoi(const PixelView& image) -> std::vector<std::byte>;
+[[nodiscard]] auto encode_png(const PixelView& image) -> std::vector<std::byte>;
+
+struct DecodedImage {
+    u32 width = 0;
+    u32 height = 0;
+    std::vector<std::byte> rgba; ///< tightly packed, alpha 255 for 3 channel files
+};
+/// @brief std::nullopt on a bad header or truncated data.
+[[nodiscard]] auto decode_qoi(std::span<const std::byte> file) -> std::optional<DecodedImage>;
+
+/**
+ *  @brief Pixels to encode and write, `release` runs on the worker once `image.pixels` is no longer read.
+ *  The pixels are borrowed, a readback buffer is handed over without copying it on the render thread.
+ */
+struct ExportJob {
+    std::filesystem::path path;
+    PixelView image;
+    std::function<void()> release;
+};
+
+struct ExportStats {
+    u64 written = 0;
+    u64 failed = 0; ///< encoding or writing the file failed
+    u64 dropped = 0; ///< submitted while the queue was full
+    u64 bytes_written = 0;
+    f64 encode_ms = 0.0; ///< total time spent encoding, not writing
+};
+
+/**
+ *  @brief Encodes and writes images on its own thread, in submission order.
+ *  At most `max_pending` jobs wait in the queue, further submits are dropped instead of blocking the caller.
+ *  The destructor finishes every queued job.
+ */
+class ImageExporter {
+public:
+    explicit ImageExporter(u32 max_pending = 4);
+    ImageExporter(const ImageExporter&) = delete;
+    auto operator=(const ImageExporter&) -> ImageExporter& = delete;
+    ~ImageExporter();
+
+    /// @brief Queue `job`, false when the queue is full. A dropped job is released right away.
+    auto submit(ExportJob job) -> bool;
+    /// @brief Block until every submitted job was written.
+    void flush();
+    [[nodiscard]] auto stats() const -> ExportStats;
+
+private:
+    void run();
+
+    u32 max_pending;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<ExportJob> queue;
+    bool busy = false;
+    bool stopping = false;
+    ExportStats export_stats;
+    std::jthread worker; ///< last, started once everything it uses is constructed
+};
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <nce/window_events.hxx>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace window {
+
+/// @brief Bumped whenever the record layout or WindowEvent changes, older logs are rejected rather than misread.
+constexpr u32 INPUT_LOG_VERSION = 1;
+
+/**
+ *  @brief One handled event as the window saw it: the frame that handled it, when it was handled
+ *  relative to the start of the recording and, for key events, the keysym it resolved to.
+ *  Keeping the keysym makes a replay independent of the keymap and needs no keyboard state.
+ */
+struct RecordedEvent {
+    u64 frame = 0;
+    i64 offset_ns = 0;
+    WindowEvent event;
+    u32 keysym = 0; ///< 0 for anything but key_press and key_release
+};
+
+/**
+ *  @brief Log layout: "NCEI", the version and the record count as little endian u32, u32, u64, then per
+ *  record the frame and offset as LEB128 deltas from the previous record, the event's fields in little
+ *  endian and the keysym as LEB128. Frame deltas are 0 or 1 and offsets grow by microseconds, most
+ *  records take about 20 bytes.
+ *  Offsets and frames never go backwards, the recorder guarantees it and the encoder relies on it.
+ */
+[[nodiscard]] auto encode_input_log(std::span<const RecordedEvent> events) -> std::vector<std::byte>;
+/// @brief std::nullopt on a bad header, another version, truncated data or an unknown event type.
+[[nodiscard]] auto decode_input_log(std::span<const std::byte> log) -> std::optional<std::vector<RecordedEvent>>;
+
+/// @brief Keys, buttons, motion and focus: what a replay stands in for, unlike the window's geometry.
+[[nodiscard]] constexpr auto is_input_event(EventType type) -> bool {
+    switch (type) {
+        case EventType::key_press:
+        case EventType::key_release:
+        case EventType::button_press:
+        case EventType::button_release:
+        case EventType::motion:
+        case EventType::focus_in:
+        case EventType::focus_out:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// @brief Collects every event a window handles, written out once at the end of a session.
+class InputRecorder {
+public:
+    /// @brief `start_ns` on the input_clock_ns() clock, offsets are measured from it.
+    explicit InputRecorder(i64 start_ns);
+
+    void record(u64 frame, i64 now_ns, const WindowEvent& event, u32 keysym);
+
+    [[nodiscard]] auto events() const -> std::span<const RecordedEvent> { return recorded; }
+    [[nodiscard]] auto encode() const -> std::vector<std::byte> { return encode_input_log(recorded); }
+    /// @brief false if the file cannot be written.
+    [[nodiscard]] auto write(const std::filesystem::path& path) const -> bool;
+
+private:
+    i64 start_ns;
+    std::vector<RecordedEvent> recorded;
+};
+
+enum class ReplaySpeed : u8 {
+    realtime, ///< events are released once as much time has passed as when they were recorded
+    fast, ///< one recorded frame per call, as fast as frames are rendered
+};
+
+/**
+ *  @brief Feeds a recorded log back frame by frame.
+ *  In fast mode every next_frame() returns the events of the next recorded frame, so a replay renders
+ *  exactly as many frames with the same input in each as the recording did, however long they take.
+ *  In realtime mode it returns everything due by `now_ns`, the clock starts at the first call.
+ */
+class InputReplay {
+public:
+    InputReplay(std::vector<RecordedEvent> events, ReplaySpeed speed);
+    /// @brief std::nullopt if the file cannot be read or is not a valid log.
+    [[nodiscard]] static auto open(const std::filesystem::path& path, ReplaySpeed speed) -> std::optional<InputReplay>;
+
+    /// @brief Events for the next frame, valid until the next call.
+    [[nodiscard]] auto next_frame(i64 now_ns) -> std::span<const RecordedEvent>;
+    /// @brief Every event was returned.
+    [[nodiscard]] auto finished() const -> bool { return next == events.size(); }
+    [[nodiscard]] auto size() const -> size_t { return events.size(); }
+    [[nodiscard]] auto recorded_frames() const -> u64 { return events.empty() ? 0 : events.back().frame - events.front().frame + 1; }
+
+private:
+    std::vector<RecordedEvent> events;
+    ReplaySpeed speed;
+    size_t next = 0;
+    u64 frame = 0; ///< recorded frame the next fast call returns
+    std::optional<i64> start_ns;
+};
+
+}
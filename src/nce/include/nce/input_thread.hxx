@@ -0,0 +1,103 @@
+#pragma once
+#include <nce/spsc_ring.hxx>
+#include <nce/window_events.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace window {
+
+/// @brief A decoded event and when the input thread read it off the connection.
+struct TimedEvent {
+    WindowEvent event;
+    i64 arrival_ns = 0; ///< input_clock_ns() at arrival
+};
+using InputQueue = nce::SpscRing<TimedEvent, 4096>;
+
+/// @brief Monotonic nanoseconds, comparable across threads.
+[[nodiscard]] inline auto input_clock_ns() -> i64 {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief Time from an event reaching the input thread until the render thread handled it.
+struct InputLatency {
+    u64 events = 0;
+    f64 total_ms = 0.0;
+    f64 max_ms = 0.0;
+
+    void add(f64 ms) {
+        events++;
+        total_ms += ms;
+        max_ms = std::max(max_ms, ms);
+    }
+    [[nodiscard]] auto mean_ms() const -> f64 { return events > 0 ? total_ms / static_cast<f64>(events) : 0.0; }
+};
+
+/**
+ *  @brief Render thread side of the input thread: move everything queued so far into `ring` and hand it
+ *  to `process` whenever it fills up and once at the end, like pump_events does for the connection.
+ *  Every event popped adds its arrival to now latency to `latency`.
+ */
+template<typename Process>
+auto drain_input(InputQueue& queue, EventRing& ring, InputLatency& latency, Process&& process) -> EventStats {
+    EventStats stats;
+    auto flush = [&] {
+        if (ring.empty()) { return; }
+        stats.max_depth = std::max(stats.max_depth, ring.size());
+        stats.processed += ring.size();
+        stats.batches++;
+        process(ring);
+    };
+    i64 now = input_clock_ns();
+    while (auto timed = queue.try_pop()) {
+        stats.received++;
+        latency.add(static_cast<f64>(now - timed->arrival_ns) / 1e6);
+        if (ring.full()) { flush_full_ring(ring, flush); }
+        ring.push(timed->event);
+    }
+    flush();
+    return stats;
+}
+
+/**
+ *  @brief Reads and decodes X events on its own thread so input is timestamped when it arrives, not when
+ *  the render thread gets back from waiting on fences and presenting.
+ *  The thread sleeps in poll() on the connection's socket and only ever reads events, requests and
+ *  replies stay on the render thread (xcb serializes access to the connection). Waiting for a reply can
+ *  move events off the socket into xcb's queue without waking the thread, whoever read replies calls
+ *  wake() so they are picked up. Nothing else wakes it, an idle window costs no wake-ups. Events are handed over
+ *  through a wait-free SPSC ring, when the render thread falls 4096 events behind new ones are dropped
+ *  and counted.
+ */
+class InputThread {
+public:
+    InputThread(xcb_connection_t* connection, const EventFilter& filter);
+    ~InputThread();
+    InputThread(const InputThread&) = delete;
+    InputThread& operator=(const InputThread&) = delete;
+
+    /// @brief Consumer side, only the render thread may pop.
+    [[nodiscard]] auto queue() -> InputQueue& { return events; }
+    /// @brief eventfd that turns readable whenever events were queued, for the render thread to sleep on.
+    [[nodiscard]] auto ready_fd() const -> i32 { return ready; }
+    /// @brief Make the thread look at xcb's event queue, after replies were read on another thread.
+    void wake();
+    /// @brief Reset ready_fd(), before draining so that nothing queued afterwards goes unsignalled.
+    void acknowledge();
+    [[nodiscard]] auto dropped() const -> u64 { return dropped_events.load(std::memory_order_relaxed); }
+
+private:
+    void run(std::stop_token stop);
+    void read_pending();
+
+    xcb_connection_t* connection;
+    EventFilter filter;
+    i32 wake_fd = -1; ///< eventfd written by wake() and on shutdown to interrupt poll()
+    i32 ready = -1;
+    InputQueue events;
+    std::atomic<u64> dropped_events = 0;
+    std::jthread thread; ///< last, starts once everything it uses exists
+};
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include <nce/keycode.hxx>
+
+#include <array>
+#include <bitset>
+
+namespace nce {
+
+/**
+ *  Every keysym in keycode.hxx gets its own bit. Latin-1 (0x0000-0x00ff) and the function keys
+ *  (0xff00-0xffff) are indexed directly, the few hundred sparse keysyms outside those ranges go
+ *  through a perfect hash built at compile time. Keysyms keycode.hxx does not name share slot 0
+ *  with NoSymbol.
+ */
+constexpr u32 KEY_DENSE_SLOTS = 512;
+constexpr u32 KEY_SPARSE_SLOTS = 512;
+constexpr u32 KEY_SLOTS = KEY_DENSE_SLOTS + KEY_SPARSE_SLOTS;
+constexpr u32 KEY_HASH_BUCKETS = 128;
+
+[[nodiscard]] constexpr auto is_dense_keysym(u32 keysym) -> bool {
+    return keysym < 0x100 || (keysym & ~0xffu) == 0xff00;
+}
+[[nodiscard]] constexpr auto key_hash(u32 keysym, u32 seed) -> u32 {
+    u32 hash = (keysym ^ seed) * 0x9e3779b1u;
+    return hash ^ (hash >> 15);
+}
+
+/// @brief Hash and displace: a key's bucket picks the seed that places it in its own slot.
+struct KeyHashTable {
+    std::array<u32, KEY_HASH_BUCKETS> seeds{};
+    std::array<u32, KEY_SPARSE_SLOTS> keysyms{}; ///< 0 marks an empty slot, 0 is never a sparse keysym
+};
+
+consteval auto build_key_hash_table() -> KeyHashTable {
+    // sparse keysyms grouped by bucket, bucket b owns by_bucket[offsets[b], offsets[b] + sizes[b])
+    std::array<u32, KEY_HASH_BUCKETS + 1> offsets{};
+    for (KeyCode code : KEY_CODES) {
+        u32 keysym = static_cast<u32>(code);
+        if (!is_dense_keysym(keysym)) { offsets[key_hash(keysym, 0) % KEY_HASH_BUCKETS + 1]++; }
+    }
+    for (u32 bucket = 0; bucket < KEY_HASH_BUCKETS; bucket++) { offsets[bucket + 1] += offsets[bucket]; }
+    std::array<u32, KEY_CODES.size()> by_bucket{};
+    std::array<u32, KEY_HASH_BUCKETS> sizes{};
+    u32 largest = 0;
+    for (KeyCode code : KEY_CODES) {
+        u32 keysym = static_cast<u32>(code);
+        if (is_dense_keysym(keysym)) { continue; }
+        u32 bucket = key_hash(keysym, 0) % KEY_HASH_BUCKETS;
+        // aliases share a value and so a bucket, only the first one is placed
+        bool alias = false;
+        for (u32 i = 0; i < sizes[bucket]; i++) { alias = alias || by_bucket[offsets[bucket] + i] == keysym; }
+        if (alias) { continue; }
+        by_bucket[offsets[bucket] + sizes[bucket]++] = keysym;
+        largest = sizes[bucket] > largest ? sizes[bucket] : largest;
+    }
+
+    // largest buckets first, while most slots are still free
+    KeyHashTable table;
+    std::array<bool, KEY_SPARSE_SLOTS> used{};
+    for (u32 size = largest; size > 0; size--) {
+        for (u32 bucket = 0; bucket < KEY_HASH_BUCKETS; bucket++) {
+            if (sizes[bucket] != size) { continue; }
+            if (size > 32) { throw "a bucket this large never fits, grow KEY_HASH_BUCKETS"; }
+            std::array<u32, 32> slots{};
+            for (u32 seed = 1;; seed++) {
+                if (seed == 1u << 16) { throw "no seed places this bucket, grow KEY_SPARSE_SLOTS"; }
+                bool fits = true;
+                for (u32 i = 0; i < size && fits; i++) {
+                    slots[i] = key_hash(by_bucket[offsets[bucket] + i], seed) % KEY_SPARSE_SLOTS;
+                    fits = !used[slots[i]];
+                    for (u32 j = 0; j < i; j++) { fits = fits && slots[j] != slots[i]; }
+                }
+                if (!fits) { continue; }
+                for (u32 i = 0; i < size; i++) {
+                    used[slots[i]] = true;
+                    table.keysyms[slots[i]] = by_bucket[offsets[bucket] + i];
+                }
+                table.seeds[bucket] = seed;
+                break;
+            }
+        }
+    }
+    return table;
+}
+inline constexpr KeyHashTable KEY_HASH_TABLE = build_key_hash_table();
+
+/// @brief Bit index of a keysym in the key bitsets.
+[[nodiscard]] constexpr auto key_slot(u32 keysym) -> u32 {
+    if (keysym < 0x100) { return keysym; }
+    if ((keysym & ~0xffu) == 0xff00) { return 0x100 + (keysym & 0xff); }
+    u32 slot = key_hash(keysym, KEY_HASH_TABLE.seeds[key_hash(keysym, 0) % KEY_HASH_BUCKETS]) % KEY_SPARSE_SLOTS;
+    return KEY_HASH_TABLE.keysyms[slot] == keysym ? KEY_DENSE_SLOTS + slot : 0;
+}
+[[nodiscard]] constexpr auto key_slot(KeyCode code) -> u32 { return key_slot(static_cast<u32>(code)); }
+
+using KeyBits = std::bitset<KEY_SLOTS>;
+
+/**
+ *  @brief Keyboard state of one frame, never modified once published.
+ *  Every query is a couple of bit tests, asking twice gives the same answer.
+ */
+struct KeySnapshot {
+    KeyBits current; ///< down at the end of this frame
+    KeyBits previous; ///< down at the end of the frame before
+    KeyBits tapped; ///< went down and came back up within this frame
+
+    [[nodiscard]] auto is_down(KeyCode code) const -> bool { return current[key_slot(code)]; }
+    /// @brief Went down during this frame.
+    [[nodiscard]] auto is_pressed(KeyCode code) const -> bool {
+        u32 slot = key_slot(code);
+        return (current[slot] & !previous[slot]) | tapped[slot];
+    }
+    /// @brief Came up during this frame.
+    [[nodiscard]] auto is_released(KeyCode code) const -> bool {
+        u32 slot = key_slot(code);
+        return (previous[slot] & !current[slot]) | tapped[slot];
+    }
+    /// @brief Down through the whole frame.
+    [[nodiscard]] auto is_held(KeyCode code) const -> bool {
+        u32 slot = key_slot(code);
+        return current[slot] & previous[slot];
+    }
+};
+
+/**
+ *  @brief Live key state written by event processing, published as a snapshot once per poll.
+ *  Snapshots are double buffered, the one returned by snapshot() stays valid and unchanged
+ *  until the second end_frame() after it.
+ *  Auto-repeat is filtered before it gets here: a press of a key that is already down is no edge.
+ */
+class KeyMap {
+public:
+    void press(u32 keysym);
+    void release(u32 keysym);
+    /// @brief Every key up, for when key releases may have been missed (focus or keymap changes).
+    void invalidate();
+    /// @brief Publish the state of the events processed since the last call.
+    void end_frame();
+
+    [[nodiscard]] auto snapshot() const -> const KeySnapshot& { return snapshots[front]; }
+    [[nodiscard]] auto is_down(KeyCode code) const -> bool { return snapshot().is_down(code); }
+    [[nodiscard]] auto is_pressed(KeyCode code) const -> bool { return snapshot().is_pressed(code); }
+    [[nodiscard]] auto is_released(KeyCode code) const -> bool { return snapshot().is_released(code); }
+    [[nodiscard]] auto is_held(KeyCode code) const -> bool { return snapshot().is_held(code); }
+
+private:
+    KeyBits down;
+    KeyBits pressed_this_frame;
+    KeyBits tapped;
+    std::array<KeySnapshot, 2> snapshots;
+    u32 front = 0;
+};
+
+}
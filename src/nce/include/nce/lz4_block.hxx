@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace vke {
+
+/**
+ *  @brief Compression in the LZ4 block format.
+ *  Greedy matching over a 64 KiB window with a single hash table. It favours packing speed and
+ *  decompression speed over ratio, like LZ4's default level, and the output is readable by liblz4's
+ *  LZ4_decompress_safe. Only blocks are handled: no frame header, no checksum, the caller stores
+ *  the decompressed size.
+ */
+[[nodiscard]] auto lz4_compress(std::span<const std::byte> source) -> std::vector<std::byte>;
+/// @brief Decompress a block into exactly `destination.size()` bytes, false on malformed or truncated input.
+[[nodiscard]] auto lz4_decompress(std::span<const std::byte> source, std::span<std::byte> destination) -> bool;
+
+}
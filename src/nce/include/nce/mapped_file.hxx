@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace vke {
+
+/**
+ *  @brief Read only contents of a whole file, owning its mapping.
+ *  Regular files are mmap'ed and read in place, pages are faulted in by the first access instead of
+ *  being copied into a buffer. Pipes, devices and files that refuse to map are streamed into memory
+ *  instead, either way bytes() stays valid for the lifetime of the MappedFile.
+ *  The data is at least page aligned when mapped and new-aligned when streamed, SPIR-V can be passed as is.
+ */
+class MappedFile {
+public:
+    /// @brief std::nullopt if the file cannot be opened or read.
+    [[nodiscard]] static auto open(const std::filesystem::path& path) -> std::optional<MappedFile>;
+
+    MappedFile(MappedFile&& other) noexcept;
+    auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+    ~MappedFile();
+
+    [[nodiscard]] auto bytes() const -> std::span<const std::byte> { return contents; }
+    [[nodiscard]] auto data() const -> const std::byte* { return contents.data(); }
+    [[nodiscard]] auto size() const -> size_t { return contents.size(); }
+    [[nodiscard]] auto empty() const -> bool { return contents.empty(); }
+    /// @brief Whether the bytes are a mapping rather than the streamed fallback.
+    [[nodiscard]] auto is_mapped() const -> bool { return mapped; }
+
+private:
+    MappedFile() = default;
+    void release();
+
+    std::span<const std::byte> contents;
+    bool mapped = false; ///< contents is a mapping to munmap, otherwise it points into streamed
+    std::vector<std::byte> streamed;
+};
+
+}
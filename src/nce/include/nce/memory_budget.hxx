@@ -0,0 +1,90 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vke {
+
+enum class MemoryCategory : u8 {
+    vertex,
+    index,
+    texture,
+    staging,
+    attachment, ///< depth, Hi-Z and render graph images
+    uniform,
+    storage, ///< object, culling and stats buffers
+};
+constexpr u32 MEMORY_CATEGORY_COUNT = 7;
+
+[[nodiscard]] auto memory_category_name(MemoryCategory category) -> std::string_view;
+
+struct HeapStats {
+    VkDeviceSize size = 0; ///< VkMemoryHeap::size
+    VkDeviceSize budget = 0; ///< what this process may use, VK_EXT_memory_budget's heapBudget or the heap size without it
+    VkDeviceSize usage = 0; ///< the driver's heapUsage plus allocations since it was queried, own allocations without the extension
+    VkDeviceSize allocated = 0; ///< live allocations made through the MemoryBudget
+};
+
+struct CategoryStats {
+    VkDeviceSize bytes = 0;
+    u32 allocations = 0;
+};
+
+/// @brief A copy of the accounting at one point in time.
+struct MemoryStats {
+    std::vector<HeapStats> heaps;
+    std::array<CategoryStats, MEMORY_CATEGORY_COUNT> categories{};
+    u64 failed_allocations = 0; ///< vkAllocateMemory calls that failed, including ones that succeeded on retry
+    bool driver_budget = false; ///< budgets and usage come from VK_EXT_memory_budget
+};
+
+/**
+ *  @brief Device memory accounting per heap and per category, with a soft budget.
+ *  The Instance reports every allocation and free, and refreshes the heap budgets from the driver
+ *  periodically, and again before an allocation would take a heap past `soft_limit` of its budget.
+ *  All member functions are thread safe.
+ */
+class MemoryBudget {
+public:
+    f64 soft_limit = 0.9; ///< fraction of a heap's budget allocations may fill before the budgets are queried again
+
+    /**
+     *  @brief Set the heaps, `budgets` and `usage` are VK_EXT_memory_budget's numbers.
+     *  Without the extension pass empty spans, the budget is then the heap size and the usage our own total.
+     */
+    void update_heaps(std::span<const VkDeviceSize> sizes, std::span<const VkDeviceSize> budgets, std::span<const VkDeviceSize> usage);
+    void on_allocate(const void* memory, u32 heap, MemoryCategory category, VkDeviceSize size);
+    /// @brief No-op for memory that was not reported to on_allocate.
+    void on_free(const void* memory);
+    void on_failure();
+
+    /// @brief Bytes `heap` has to release before `size` more fit under the soft limit, 0 when they fit.
+    [[nodiscard]] auto excess(u32 heap, VkDeviceSize size) const -> VkDeviceSize;
+
+    [[nodiscard]] auto snapshot() const -> MemoryStats;
+
+private:
+    struct Allocation {
+        u32 heap;
+        MemoryCategory category;
+        VkDeviceSize size;
+    };
+
+    [[nodiscard]] auto heap_usage(u32 heap) const -> VkDeviceSize;
+
+    mutable std::mutex mutex;
+    MemoryStats stats;
+    std::vector<VkDeviceSize> driver_usage; ///< heapUsage at the last update_heaps
+    std::vector<VkDeviceSize> allocated_at_update; ///< HeapStats::allocated at the last update_heaps
+    std::unordered_map<const void*, Allocation> allocations;
+};
+
+/// @brief One line per heap and per category.
+void print_memory_stats(const MemoryStats& stats);
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <nce/window_events.hxx>
+
+#include <span>
+#include <vector>
+
+namespace window {
+
+/// @brief X button numbers, 4 to 7 are the scroll wheel.
+enum class MouseButton : u8 {
+    left = 1,
+    middle = 2,
+    right = 3,
+    back = 8,
+    forward = 9,
+};
+
+/// @brief One motion event, kept at full resolution when the pointer records history.
+struct PointerSample {
+    i16 x = 0;
+    i16 y = 0;
+    u32 time = 0; ///< server time in milliseconds
+};
+
+/**
+ *  @brief Pointer state of one frame: every motion event of the frame coalesced into one delta and the
+ *  last absolute position, button edges and wheel clicks.
+ */
+struct PointerFrame {
+    i32 x = 0; ///< last position in window coordinates
+    i32 y = 0;
+    i32 dx = 0; ///< motion accumulated over the frame
+    i32 dy = 0;
+    i32 scroll_x = 0; ///< wheel clicks, positive is right
+    i32 scroll_y = 0; ///< wheel clicks, positive is up
+    u32 buttons_down = 0; ///< bit (button - 1) per button held at the end of the frame
+    u32 buttons_pressed = 0; ///< went down during the frame, also set for a click shorter than the frame
+    u32 buttons_released = 0;
+    u32 motion_events = 0; ///< coalesced into dx, dy
+
+    [[nodiscard]] auto is_down(MouseButton button) const -> bool { return buttons_down & button_bit(button); }
+    [[nodiscard]] auto is_pressed(MouseButton button) const -> bool { return buttons_pressed & button_bit(button); }
+    [[nodiscard]] auto is_released(MouseButton button) const -> bool { return buttons_released & button_bit(button); }
+    [[nodiscard]] static constexpr auto button_bit(MouseButton button) -> u32 { return 1u << (static_cast<u32>(button) - 1); }
+};
+
+/**
+ *  @brief Accumulates pointer events between frames and publishes them as one PointerFrame.
+ *  Deltas come from consecutive positions, so the first event after startup only sets the position.
+ *  With history on, every motion event of the last frame is kept in order for tools that need the
+ *  full path (sketching), otherwise nothing is stored per event.
+ */
+class Pointer {
+public:
+    explicit Pointer(bool record_history = false) : record_history(record_history) {}
+
+    /// @brief Motion and button events, anything else is ignored.
+    void handle(const WindowEvent& event);
+    /// @brief Every button up, for when releases may have been missed.
+    void invalidate();
+    /// @brief Publish what was handled since the last call and start a new frame.
+    void end_frame();
+
+    [[nodiscard]] auto frame() const -> const PointerFrame& { return published; }
+    /// @brief Motion events of the published frame, empty unless history is recorded.
+    [[nodiscard]] auto history() const -> std::span<const PointerSample> { return published_history; }
+    [[nodiscard]] auto records_history() const -> bool { return record_history; }
+
+private:
+    void move_to(i16 x, i16 y);
+
+    bool record_history;
+    bool has_position = false;
+    PointerFrame live;
+    PointerFrame published;
+    std::vector<PointerSample> live_history;
+    std::vector<PointerSample> published_history;
+};
+
+}
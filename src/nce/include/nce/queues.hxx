@@ -0,0 +1,55 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace vke {
+
+struct QueueFamilyIndices {
+    std::optional<u32> graphics_family;
+    std::optional<u32> present_family;
+    std::optional<u32> transfer_family; ///< transfer-only family, else a compute family without graphics, else graphics
+    std::optional<u32> compute_family; ///< compute family without graphics, else graphics
+    auto has_value() -> bool { return graphics_family.has_value() && present_family.has_value(); }
+    auto has_value() const -> bool { return graphics_family.has_value() && present_family.has_value(); }
+
+    [[nodiscard]] auto dedicated_transfer() const -> bool { return transfer_family != graphics_family; }
+    [[nodiscard]] auto dedicated_compute() const -> bool { return compute_family != graphics_family; }
+    /// @brief Every family a queue has to be created for, each listed once.
+    [[nodiscard]] auto unique_families() const -> std::vector<u32>;
+};
+
+/**
+ *  @brief Pick the queue families of a device.
+ *  Uploads and async compute prefer families without graphics so they overlap rendering,
+ *  both fall back to the graphics family when the device only exposes one universal family.
+ */
+[[nodiscard]] auto select_queue_families(std::span<const VkQueueFamilyProperties> families, const std::function<bool(u32 family)>& supports_present) -> QueueFamilyIndices;
+
+/**
+ *  @brief Barriers moving a resource written on one queue family to another.
+ *  `release` is recorded on the source queue after the last write. When the families differ,
+ *  `acquire` has to be recorded on the destination queue after waiting on the source submission.
+ *  Within one family `release` alone carries the whole dependency.
+ */
+struct BufferOwnershipTransfer {
+    VkBufferMemoryBarrier2 release;
+    std::optional<VkBufferMemoryBarrier2> acquire;
+};
+struct ImageOwnershipTransfer {
+    VkImageMemoryBarrier2 release;
+    std::optional<VkImageMemoryBarrier2> acquire;
+};
+
+[[nodiscard]] auto transfer_buffer_ownership(VkBuffer buffer, u32 src_family, u32 dst_family,
+        VkPipelineStageFlags2 src_stage, VkAccessFlags2 src_access,
+        VkPipelineStageFlags2 dst_stage, VkAccessFlags2 dst_access) -> BufferOwnershipTransfer;
+/// @brief Same as transfer_buffer_ownership, the layout transition happens once, as part of the pair.
+[[nodiscard]] auto transfer_image_ownership(VkImage image, VkImageAspectFlags aspect, u32 src_family, u32 dst_family,
+        VkPipelineStageFlags2 src_stage, VkAccessFlags2 src_access, VkImageLayout old_layout,
+        VkPipelineStageFlags2 dst_stage, VkAccessFlags2 dst_access, VkImageLayout new_layout) -> ImageOwnershipTransfer;
+
+}
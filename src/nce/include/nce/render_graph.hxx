@@ -0,0 +1,224 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace vke {
+
+/**
+ *  @brief How a pass touches an image.
+ *  Every usage maps to exactly one pipeline stage, access mask and layout (see vke::image_state).
+ */
+enum class ResourceUsage : u8 {
+    color_attachment_write,
+    color_attachment_read,
+    depth_attachment_write,
+    depth_attachment_read,
+    fragment_sampled_read,
+    compute_sampled_read,
+    compute_storage_read,
+    compute_storage_write,
+    transfer_src,
+    transfer_dst,
+    present
+};
+
+struct ImageState {
+    VkPipelineStageFlags2 stage;
+    VkAccessFlags2 access;
+    VkImageLayout layout;
+};
+
+[[nodiscard]] constexpr auto is_write(ResourceUsage usage) -> bool {
+    switch (usage) {
+        case ResourceUsage::color_attachment_write:
+        case ResourceUsage::depth_attachment_write:
+        case ResourceUsage::compute_storage_write:
+        case ResourceUsage::transfer_dst:
+            return true;
+        default:
+            return false;
+    }
+}
+
+[[nodiscard]] constexpr auto image_state(ResourceUsage usage) -> ImageState {
+    switch (usage) {
+        case ResourceUsage::color_attachment_write:
+            return { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                     VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+        case ResourceUsage::color_attachment_read:
+            return { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                     VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT,
+                     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+        case ResourceUsage::depth_attachment_write:
+            return { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                     VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                     VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL };
+        case ResourceUsage::depth_attachment_read:
+            return { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                     VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                     VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL };
+        case ResourceUsage::fragment_sampled_read:
+            return { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                     VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        case ResourceUsage::compute_sampled_read:
+            return { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                     VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        case ResourceUsage::compute_storage_read:
+            return { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                     VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                     VK_IMAGE_LAYOUT_GENERAL };
+        case ResourceUsage::compute_storage_write:
+            return { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                     VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                     VK_IMAGE_LAYOUT_GENERAL };
+        case ResourceUsage::transfer_src:
+            return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL };
+        case ResourceUsage::transfer_dst:
+            return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL };
+        case ResourceUsage::present:
+            return { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR };
+    }
+    return { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_UNDEFINED };
+}
+
+/// @brief Stage/access/layout an image is in when it is held in `layout` by the engine's own passes.
+[[nodiscard]] auto image_state(VkImageLayout layout) -> ImageState;
+
+struct ImageDesc {
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent = {0, 0};
+    VkImageUsageFlags usage = 0;
+    VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+
+    [[nodiscard]] auto operator==(const ImageDesc& o) const -> bool {
+        return format == o.format && extent.width == o.extent.width && extent.height == o.extent.height
+            && usage == o.usage && aspect == o.aspect;
+    }
+};
+
+using ResourceHandle = u32;
+
+/**
+ *  @brief A single image barrier produced by RenderGraph::compile.
+ *  `resource` indexes into the graph's resources, the Vulkan handle is only resolved in RenderGraph::execute.
+ */
+struct ImageBarrier {
+    ResourceHandle resource;
+    VkPipelineStageFlags2 src_stage;
+    VkAccessFlags2 src_access;
+    VkPipelineStageFlags2 dst_stage;
+    VkAccessFlags2 dst_access;
+    VkImageLayout old_layout;
+    VkImageLayout new_layout;
+};
+
+struct CompiledPass {
+    u32 pass; ///< index into RenderGraph::passes
+    std::vector<ImageBarrier> barriers; ///< recorded as one vkCmdPipelineBarrier2 before the pass
+};
+
+struct CompiledGraph {
+    constexpr static u32 NO_SLOT = std::numeric_limits<u32>::max();
+
+    std::vector<CompiledPass> passes; ///< live passes in submission order
+    std::vector<ImageBarrier> final_barriers; ///< transitions of imported images into their final layout
+    std::vector<u32> culled_passes;
+    std::vector<u32> physical_slots; ///< per resource, the memory slot a transient image lives in
+    u32 physical_slot_count = 0;
+
+    /// @brief Number of vkCmdPipelineBarrier2 calls RenderGraph::execute records.
+    [[nodiscard]] auto barrier_batch_count() const -> u32;
+};
+
+/// @brief Device allocations backing the transient images of a compiled graph.
+struct TransientMemoryPlan {
+    struct Allocation {
+        u32 slot; ///< the aliasing slot it belongs to
+        VkDeviceSize size = 0; ///< of the largest image bound to it
+        u32 memory_type_bits = std::numeric_limits<u32>::max(); ///< allowed by every image bound to it, never 0
+    };
+    std::vector<Allocation> allocations;
+    std::vector<u32> allocation_of; ///< per resource, CompiledGraph::NO_SLOT for imported and unused images
+};
+
+/**
+ *  @brief Images of a slot share one allocation at offset 0, sized for the largest of them.
+ *  An image whose memory types don't overlap the ones an allocation already allows gets another
+ *  allocation in the same slot instead. `requirements` is indexed by resource, only transients are read.
+ */
+[[nodiscard]] auto plan_transient_memory(const CompiledGraph& compiled, std::span<const VkMemoryRequirements> requirements) -> TransientMemoryPlan;
+
+/**
+ *  @brief Frame graph of passes and the images they read and write.
+ *  Passes declare their accesses up front. compile() culls passes that contribute nothing to an
+ *  imported image, derives every layout transition and hazard barrier, batches them per pass and
+ *  assigns transient images with disjoint lifetimes to shared memory slots.
+ */
+struct RenderGraph {
+    struct Access {
+        ResourceHandle resource;
+        ResourceUsage usage;
+    };
+    struct Resource {
+        std::string name;
+        ImageDesc desc;
+        bool imported;
+        ImageState initial; ///< layout the image is in when the graph starts and the access that left it there
+        std::optional<VkImageLayout> final_layout; ///< imported images only, makes the image an output
+        VkImage image = VK_NULL_HANDLE;
+    };
+    using ExecuteFn = std::function<void(VkCommandBuffer command_buffer)>;
+    struct Pass {
+        std::string name;
+        std::vector<Access> accesses;
+        ExecuteFn execute;
+        bool side_effect = false;
+    };
+    struct PassBuilder {
+        RenderGraph& graph;
+        u32 pass;
+
+        auto read(ResourceHandle resource, ResourceUsage usage) -> PassBuilder&;
+        auto write(ResourceHandle resource, ResourceUsage usage) -> PassBuilder&;
+        /// @brief Keep the pass even if nothing reads its outputs (readback, queries, ...).
+        auto side_effect() -> PassBuilder&;
+    };
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+
+    /// @brief Register an image owned outside of the graph (swapchain image, persistent depth buffer).
+    auto import_image(std::string name, ImageDesc desc, VkImage image, VkImageLayout initial_layout, std::optional<VkImageLayout> final_layout = std::nullopt) -> ResourceHandle;
+    /// @brief Import an image whose last access outside the graph still has to be waited on,
+    /// e.g. a depth buffer shared between frames in flight.
+    auto import_image(std::string name, ImageDesc desc, VkImage image, ImageState initial, std::optional<VkImageLayout> final_layout = std::nullopt) -> ResourceHandle;
+    /// @brief Register a transient image that only lives for the duration of the graph.
+    auto create_image(std::string name, ImageDesc desc) -> ResourceHandle;
+    /// @brief A transient image whose memory the previous frame in flight may still be using, its first
+    /// use waits on `initial`. Its contents are still discarded, the layout of `initial` is ignored.
+    auto create_image(std::string name, ImageDesc desc, ImageState initial) -> ResourceHandle;
+    auto add_pass(std::string name, const std::function<void(PassBuilder&)>& setup, ExecuteFn execute = nullptr) -> u32;
+    /// @brief Point a resource at a new image, e.g. the acquired swapchain image or realized transient memory.
+    void bind_image(ResourceHandle resource, VkImage image) { resources[resource].image = image; }
+    void clear() { resources.clear(); passes.clear(); }
+
+    [[nodiscard]] auto compile() const -> CompiledGraph;
+    /**
+     *  @brief Record barriers and pass callbacks into command_buffer.
+     *  `pipeline_barrier` is the device's dispatch table entry when the caller has one.
+     */
+    void execute(VkCommandBuffer command_buffer, const CompiledGraph& compiled, PFN_vkCmdPipelineBarrier2 pipeline_barrier = vkCmdPipelineBarrier2) const;
+    /// @brief Record a batch of barriers as a single vkCmdPipelineBarrier2.
+    void record_barriers(VkCommandBuffer command_buffer, std::span<const ImageBarrier> barriers, PFN_vkCmdPipelineBarrier2 pipeline_barrier = vkCmdPipelineBarrier2) const;
+};
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <nce/mapped_file.hxx>
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace vke {
+
+/// @brief SPIR-V compiled into the binary, see the generated nce/embedded_shaders.hxx.
+struct EmbeddedShader {
+    std::string_view name; ///< source file name, e.g. "hello.vert"
+    std::span<const u32> code;
+};
+
+/// @brief Empty if `name` is not embedded, usable in constant expressions.
+[[nodiscard]] constexpr auto find_embedded_shader(std::span<const EmbeddedShader> shaders, std::string_view name) -> std::span<const u32> {
+    for (const auto& shader : shaders) {
+        if (shader.name == name) { return shader.code; }
+    }
+    return {};
+}
+
+/// @brief SPIR-V of one shader, either borrowed from the binary or read from an override file.
+struct ShaderCode {
+    std::optional<MappedFile> file; ///< set when the override directory had the shader
+    std::span<const u32> embedded;
+
+    [[nodiscard]] auto bytes() const -> std::span<const std::byte> {
+        return file ? file->bytes() : std::as_bytes(embedded);
+    }
+};
+
+/**
+ *  @brief Look up `name`, preferring `override_dir`/`name`.spv when an override directory is given.
+ *  Shaders missing from the override directory fall back to the embedded code, so only the ones being
+ *  edited need to be there. Without an override directory no file is touched.
+ *  Aborts if `name` is neither overridden nor embedded.
+ */
+[[nodiscard]] auto load_shader(std::string_view name, std::span<const EmbeddedShader> embedded,
+        const std::optional<std::filesystem::path>& override_dir) -> ShaderCode;
+
+/// @brief The override directory named by NCE_SHADER_DIR, std::nullopt when unset or empty.
+[[nodiscard]] auto shader_override_dir() -> std::optional<std::filesystem::path>;
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <new>
+#include <optional>
+
+namespace nce {
+
+/**
+ *  @brief Bounded queue between exactly one producer thread and one consumer thread.
+ *  Both sides are wait-free: a push or pop is a few loads and one release store, never a lock or a retry
+ *  loop. Each side caches the other side's index and only reloads it when the ring looks full or empty,
+ *  so the index cache lines bounce between cores once per batch instead of once per element.
+ */
+template<typename T, u32 CAPACITY> class SpscRing {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+    // 64 bytes, hardware_destructive_interference_size warns about ABI stability with GCC
+    constexpr static size_t CACHE_LINE = 64;
+
+public:
+    /// @brief Producer only. false when the consumer has fallen CAPACITY elements behind.
+    auto try_push(const T& value) -> bool {
+        u32 tail = producer.tail.load(std::memory_order_relaxed);
+        if (tail - producer.cached_head == CAPACITY) {
+            producer.cached_head = consumer.head.load(std::memory_order_acquire);
+            if (tail - producer.cached_head == CAPACITY) { return false; }
+        }
+        slots[tail & (CAPACITY - 1)] = value;
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    /// @brief Consumer only.
+    auto try_pop() -> std::optional<T> {
+        u32 head = consumer.head.load(std::memory_order_relaxed);
+        if (head == consumer.cached_tail) {
+            consumer.cached_tail = producer.tail.load(std::memory_order_acquire);
+            if (head == consumer.cached_tail) { return std::nullopt; }
+        }
+        T value = slots[head & (CAPACITY - 1)];
+        consumer.head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+    /// @brief Exact when called from either side while the other is idle, a snapshot otherwise.
+    [[nodiscard]] auto size() const -> u32 {
+        return producer.tail.load(std::memory_order_acquire) - consumer.head.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+private:
+    // indices run freely and wrap at 2^32, slots are indexed modulo CAPACITY
+    struct alignas(CACHE_LINE) Producer {
+        std::atomic<u32> tail = 0;
+        u32 cached_head = 0;
+    };
+    struct alignas(CACHE_LINE) Consumer {
+        std::atomic<u32> head = 0;
+        u32 cached_tail = 0;
+    };
+    Producer producer;
+    Consumer consumer;
+    alignas(CACHE_LINE) std::array<T, CAPACITY> slots{};
+};
+
+}
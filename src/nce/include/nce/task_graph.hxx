@@ -0,0 +1,47 @@
+#pragma once
+
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace vke {
+
+using TaskHandle = u32;
+
+/// @brief When a stage ran, in milliseconds since TaskGraph::run started.
+struct StageTiming {
+    std::string name;
+    f64 start_ms = 0.0;
+    f64 end_ms = 0.0;
+    u32 worker = 0; ///< which of the run's threads executed it, 0 is the calling thread
+};
+
+/**
+ *  @brief Startup stages with explicit dependencies.
+ *  A stage starts as soon as every stage it depends on has finished. Dependencies are handles returned
+ *  by earlier add() calls, so the graph cannot contain cycles and insertion order is a valid serial order.
+ *  Stages that share mutable state must depend on each other, the graph does no other synchronization.
+ */
+struct TaskGraph {
+    struct Task {
+        std::string name;
+        std::function<void()> work;
+        std::vector<TaskHandle> dependencies;
+    };
+    std::vector<Task> tasks;
+
+    auto add(std::string name, std::function<void()> work, std::vector<TaskHandle> dependencies = {}) -> TaskHandle;
+    /**
+     *  @brief Run every stage on up to `threads` threads, the calling thread is one of them.
+     *  Ready stages are picked in insertion order, with one thread this is the serial order.
+     *  The first exception a stage throws is rethrown once running stages finished, its dependents never start.
+     *  @return Timings indexed by TaskHandle.
+     */
+    [[nodiscard]] auto run(u32 threads) -> std::vector<StageTiming>;
+};
+
+/// @brief One line per stage with a bar placing it on the startup timeline.
+void print_timeline(std::span<const StageTiming> timings);
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <array>
+#include <atomic>
+
+namespace nce {
+
+/**
+ *  @brief Latest-value handover from one writer thread to one reader thread.
+ *  Three copies of T: the writer fills its own back buffer and publishes it by swapping it with the
+ *  middle one, the reader swaps the middle one into its front buffer when it is newer. Each side owns
+ *  its buffer until the next swap, so neither ever waits for the other or sees a half written value,
+ *  at the price of the reader skipping values it was too slow for.
+ *  Both sides are one atomic exchange at most, no locks and no retries.
+ */
+template<typename T> class TripleBuffer {
+    constexpr static size_t CACHE_LINE = 64;
+    constexpr static u8 INDEX = 0b011;
+    constexpr static u8 FRESH = 0b100; ///< the middle buffer holds a value the reader has not taken yet
+
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) {
+        for (auto& slot : slots) { slot.value = initial; }
+    }
+
+    /// @brief Writer only, the buffer to fill before publish(). Holds whatever was published two values ago.
+    [[nodiscard]] auto write_buffer() -> T& { return slots[back].value; }
+    /// @brief Writer only, hands write_buffer() over and gets the reader's discarded buffer back.
+    void publish() {
+        back = middle.exchange(static_cast<u8>(back | FRESH), std::memory_order_acq_rel) & INDEX;
+    }
+
+    /// @brief Reader only, the newest published value, unchanged until the next read().
+    [[nodiscard]] auto read() -> const T& {
+        if (middle.load(std::memory_order_relaxed) & FRESH) {
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        }
+        return slots[front].value;
+    }
+    /// @brief Reader only, whether read() would return a newer value.
+    [[nodiscard]] auto has_new() const -> bool { return middle.load(std::memory_order_relaxed) & FRESH; }
+
+private:
+    struct alignas(CACHE_LINE) Slot {
+        T value{};
+    };
+    std::array<Slot, 3> slots{};
+    alignas(CACHE_LINE) std::atomic<u8> middle = 1;
+    alignas(CACHE_LINE) u8 back = 2; ///< writer side
+    alignas(CACHE_LINE) u8 front = 0; ///< reader side
+};
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <span>
+
+namespace nce {
+
+/// @brief Scene and interaction state of the viewer, advanced on the simulation thread at a fixed rate.
+struct ViewerState {
+    f64 rotation = 0.0; ///< radians about z
+    f64 spin = std::numbers::pi / 2.0; ///< radians per second
+    // the orbit starts where vke::Instance puts its camera, the eye at (2, 2, 2)
+    f64 yaw = std::numbers::pi / 4.0; ///< radians about z
+    f64 pitch = std::asin(1.0 / std::numbers::sqrt3); ///< radians above the xy plane, short of the poles
+    f64 distance = 2.0 * std::numbers::sqrt3; ///< from the origin
+
+    auto operator==(const ViewerState&) const -> bool = default;
+};
+
+/// @brief One frame's interaction, the render thread coalesces its input into at most one of these.
+struct ViewerInput {
+    i32 orbit_dx = 0;
+    i32 orbit_dy = 0;
+    i32 zoom = 0;
+    bool toggle_spin = false;
+};
+
+inline void step_viewer(ViewerState& state, std::span<const ViewerInput> inputs, f64 dt) {
+    for (const ViewerInput& input : inputs) {
+        state.yaw += input.orbit_dx * 0.005;
+        state.pitch = std::clamp(state.pitch + input.orbit_dy * 0.005, -1.5, 1.5);
+        state.distance = std::clamp(state.distance * std::pow(0.9, input.zoom), 0.5, 100.0);
+        if (input.toggle_spin) { state.spin = state.spin == 0.0 ? std::numbers::pi / 2.0 : 0.0; }
+    }
+    state.rotation = std::fmod(state.rotation + state.spin * dt, 2.0 * std::numbers::pi);
+}
+
+/// @brief `alpha` of the way from `previous` to `current`, the rotation wraps at 2 pi and blends along the short way.
+[[nodiscard]] inline auto blend_viewer(const ViewerState& previous, const ViewerState& current, f64 alpha) -> ViewerState {
+    ViewerState blended = current;
+    f64 turn = std::remainder(current.rotation - previous.rotation, 2.0 * std::numbers::pi);
+    blended.rotation = previous.rotation + turn * alpha;
+    blended.yaw = std::lerp(previous.yaw, current.yaw, alpha);
+    blended.pitch = std::lerp(previous.pitch, current.pitch, alpha);
+    blended.distance = std::lerp(previous.distance, current.distance, alpha);
+    return blended;
+}
+
+}
@@ -12,12 +12,26 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <atomic>
+
 
 #include <nce/vke_macro.hxx>
 
 #include <nce/log.hxx>
 #include <nce/window.hxx>
 #include <nce/vertex.hxx>
+#include <nce/render_graph.hxx>
+#include <nce/bindless.hxx>
+#include <nce/descriptor_allocator.hxx>
+#include <nce/queues.hxx>
+#include <nce/culling.hxx>
+#include <nce/camera.hxx>
+#include <nce/task_graph.hxx>
+#include <nce/mapped_file.hxx>
+#include <nce/asset_pack.hxx>
+#include <nce/memory_budget.hxx>
+#include <nce/image_export.hxx>
+#include <render_api/dispatch.hxx>
 
 namespace vke {
 #ifndef NDEBUG
@@ -127,25 +141,18 @@ struct VKEImageViewDeleter { void operator()(VkImageView ptr); };
 struct VKESurfaceDeleter { void operator()(VkSurfaceKHR_T* ptr); };
 struct VKEShaderModuleDeleter { void operator()(VkShaderModule_T* ptr); };
 struct VKEPipelineLayoutDeleter { void operator()(VkPipelineLayout_T* ptr); };
-struct VKERenderPassDeleter { void operator()(VkRenderPass_T* ptr); };
 struct VKEGraphicsPipelineDeleter { void operator()(VkPipeline_T* ptr); };
-struct VKEFramebufferDeleter { void operator()(VkFramebuffer_T* ptr); };
+struct VKEPipelineCacheDeleter { void operator()(VkPipelineCache_T* ptr); };
 struct VKECommandPoolDeleter { void operator()(VkCommandPool_T* ptr); };
 struct VKESemaphoreDeleter { void operator()(VkSemaphore_T* ptr); };
 struct VKEFenceDeleter { void operator()(VkFence_T* ptr); };
 struct VKEBufferDeleter { void operator()(VkBuffer_T* ptr); };
 struct VKEMemoryDeleter { void operator()(VkDeviceMemory_T* ptr); };
-struct VKEDescriptorSetLayoutDeleter { void operator()(VkDescriptorSetLayout_T* ptr); };
 struct VKEDescriptorPoolDeleter { void operator()(VkDescriptorPool_T* ptr); };
 struct VKEImageDeleter { void operator()(VkImage_T* ptr); };
 struct VKESampleDeleter { void operator()(VkSampler_T* ptr); };
-
-struct QueueFamilyIndices {
-    std::optional<u32> graphics_family;
-    std::optional<u32> present_family;
-    auto has_value() -> bool { return graphics_family.has_value() && present_family.has_value(); }
-    auto has_value() const -> bool { return graphics_family.has_value() && present_family.has_value(); }
-};
+struct VKEQueryPoolDeleter { void operator()(VkQueryPool_T* ptr); };
+struct STBImageDeleter { void operator()(u8* ptr); };
 
 struct SwapChainSupportDetails {
     VkSurfaceCapabilitiesKHR capabilities;
@@ -153,128 +160,438 @@ struct SwapChainSupportDetails {
     std::vector<VkPresentModeKHR> present_modes;
 };
 
-struct UniformBufferObject {
+/// @brief Device memory backing the transient images of a compiled RenderGraph.
+struct RenderGraphImages {
+    std::vector<std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>> memory; ///< per TransientMemoryPlan allocation, usually one per aliasing slot
+    std::vector<std::unique_ptr<VkImage_T, VKEImageDeleter>> images; ///< indexed by ResourceHandle, destroyed before memory
+};
+
+/// @brief Per-object entry of a bindless storage buffer, indexed with the draw's firstInstance (std430).
+struct ObjectData {
     glm::mat4 model;
-    glm::mat4 view;
-    glm::mat4 proj;
+    u32 texture_index; ///< slot in the bindless texture array
+    u32 padding[3];
+};
+
+/// @brief Per-draw state of hello.vert, changing it costs no memory writes or descriptor updates.
+struct DrawPushConstants {
+    glm::mat4 model; ///< applied on top of every object's model matrix
+    u32 object_buffer; ///< slot of the ObjectData buffer in the bindless storage buffer array
+    u32 object_id; ///< added to gl_InstanceIndex, 0 for the indirect draws which carry it in firstInstance
+};
+
+/// @brief A sampled texture registered in the bindless texture array.
+struct Texture {
+    std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> memory;
+    std::unique_ptr<VkImage_T, VKEImageDeleter> image;
+    std::unique_ptr<VkImageView_T, VKEImageViewDeleter> view;
+    u32 slot = SlotAllocator::INVALID;
+};
+
+/// @brief An image file decoded to RGBA8, decoding needs no device so it overlaps device creation at startup.
+struct DecodedTexture {
+    std::unique_ptr<u8, STBImageDeleter> pixels;
+    u32 width;
+    u32 height;
+};
+
+/// @brief Culling counters and GPU time of the last completed frame.
+struct FrameStats {
+    u32 early_draws = 0;
+    u32 late_draws = 0;
+    u64 triangles = 0; ///< drawn by both culling phases
+    u64 culled_triangles = 0; ///< skipped by frustum and occlusion culling
+    f64 gpu_ms = 0.0;
+    f64 capture_ms = 0.0; ///< render thread time spent recording and handing off readbacks
+};
+
+/// @brief FrameStats summed over the frames drawn with culling on, or off.
+struct FrameStatsTotals {
+    u64 frames = 0;
+    u64 timed_frames = 0; ///< frames whose timestamps were read, gpu_ms sums only these
+    u64 draws = 0;
+    u64 triangles = 0;
+    u64 culled_triangles = 0;
+    f64 gpu_ms = 0.0;
+    f64 gpu_ms_max = 0.0;
+
+    void add(const FrameStats& stats, bool timed);
+    [[nodiscard]] auto mean_gpu_ms() const -> f64 { return timed_frames == 0 ? 0.0 : gpu_ms / static_cast<f64>(timed_frames); }
+};
+
+/// @brief One line per culling mode that drew frames, and the GPU time culling saved when both did.
+void print_frame_stats(const FrameStatsTotals& culled, const FrameStatsTotals& unculled);
+
+/**
+ *  @brief Copies recorded for the transfer queue, submitted together.
+ *  The staging buffers are kept until the upload timeline reaches timeline_value.
+ */
+struct UploadBatch {
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    u64 timeline_value = 0;
+    std::vector<std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>> staging_memory;
+    std::vector<std::unique_ptr<VkBuffer_T, VKEBufferDeleter>> staging_buffers; ///< destroyed before staging_memory
+    std::vector<VkBufferMemoryBarrier2> buffer_acquires; ///< recorded on the graphics queue when the families differ
+    std::vector<VkImageMemoryBarrier2> image_acquires;
+};
+
+enum class ReadbackState : u8 {
+    free,
+    copying, ///< recorded into a frame, complete once that frame's fence signals
+    encoding, ///< owned by the ImageExporter until it releases the pixels
+};
+
+/**
+ *  @brief One host cached buffer of the readback ring.
+ *  The render thread moves a slot from free to copying and on to encoding, the exporter's worker sets it free again.
+ */
+struct ReadbackSlot {
+    std::unique_ptr<VkBuffer_T, VKEBufferDeleter> buffer;
+    std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> memory;
+    void* mapped = nullptr;
+    VkDeviceSize size = 0;
+    VkExtent2D extent{};
+    PixelOrder order = PixelOrder::bgra;
+    u32 frame = 0; ///< frame in flight the copy was recorded into
+    std::filesystem::path path;
+    std::atomic<ReadbackState> state = ReadbackState::free;
+};
+
+constexpr u32 MAX_FRAMES_IN_FLIGHT = 2;
+/// @brief Windows one Instance presents to, every frame presents all of them with one vkQueuePresentKHR.
+constexpr u32 MAX_VIEWPORTS = 8;
+
+/**
+ *  @brief A window the Instance renders to: its surface and swapchain and everything that depends on
+ *  its size or its camera. Meshes, textures, pipelines and the bindless set belong to the Instance and
+ *  are shared by every viewport, another window costs its attachments and a few small buffers.
+ */
+struct Viewport {
+    window::Window& window;
+    std::unique_ptr<VkSurfaceKHR_T, VKESurfaceDeleter> surface;
+    std::unique_ptr<VkSwapchainKHR_T, VKESwapChainDeleter> swapchain; ///< destroyed before the surface
+    std::vector<VkImage> swapchain_images;
+    std::vector<std::unique_ptr<VkImageView_T, VKEImageViewDeleter>> swapchain_image_views;
+    VkFormat swapchain_image_format = VK_FORMAT_UNDEFINED;
+    VkExtent2D swapchain_extent{};
+    bool swapchain_readable = false; ///< the swapchain images allow TRANSFER_SRC
+    bool frame_buffer_resized = false; ///< set through the window's user_data_ptr by its resize callback
+    std::vector<std::unique_ptr<VkSemaphore_T, VKESemaphoreDeleter>> image_available_semaphores;
+    std::vector<std::unique_ptr<VkSemaphore_T, VKESemaphoreDeleter>> render_finished_semaphores;
+    u32 image_index = 0; ///< swapchain image of the frame being recorded
+    bool acquired = false; ///< renders in the frame being recorded, false while its swapchain was out of date
+    std::array<bool, MAX_FRAMES_IN_FLIGHT> drawn{}; ///< per frame in flight, whether its stats buffer was written
+
+    std::vector<std::unique_ptr<VkBuffer_T, VKEBufferDeleter>> uniform_buffers;
+    std::vector<std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>> uniform_buffers_memory;
+    std::vector<void*> uniform_buffers_mapped; ///< per frame in flight, CameraMatrices
+    std::vector<VkDescriptorSet> descriptor_sets;
+    CameraTracker camera_tracker{MAX_FRAMES_IN_FLIGHT};
+    glm::mat4 view_proj{1.0f}; ///< proj * view * scene model of the frame being recorded
+
+    /// @brief Per frame in flight, the draw count of each CullPhase followed by the draws of each phase.
+    std::vector<std::unique_ptr<VkBuffer_T, VKEBufferDeleter>> draw_buffers;
+    std::vector<std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>> draw_buffers_memory;
+    std::vector<u32> draw_buffer_slots;
+    /// @brief One u32 per object, whether this view's last late phase saw it.
+    std::unique_ptr<VkBuffer_T, VKEBufferDeleter> visibility_buffer;
+    std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> visibility_memory;
+    u32 visibility_slot = SlotAllocator::INVALID;
+    /// @brief Per frame in flight, host visible copies of the draw counts.
+    std::vector<std::unique_ptr<VkBuffer_T, VKEBufferDeleter>> stats_buffers;
+    std::vector<std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>> stats_buffers_memory;
+    std::vector<void*> stats_buffers_mapped;
+
+    RenderGraphImages graph_images; ///< the frame graph's transients, depth among them
+    std::unique_ptr<VkImageView_T, VKEImageViewDeleter> depth_image_view; ///< of the depth transient, destroyed before it
+    /// @brief Hi-Z pyramid of the early phase's depth, each texel holds the farthest depth below it.
+    std::unique_ptr<VkImage_T, VKEImageDeleter> hiz_image;
+    std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> hiz_memory;
+    std::unique_ptr<VkImageView_T, VKEImageViewDeleter> hiz_view; ///< every mip
+    std::vector<std::unique_ptr<VkImageView_T, VKEImageViewDeleter>> hiz_mip_views;
+    VkExtent2D hiz_size{};
+
+    RenderGraph frame_graph;
+    CompiledGraph frame_graph_compiled;
+    CompiledGraph frame_graph_capture_compiled; ///< the same passes followed by the readback pass
+    ResourceHandle frame_graph_swapchain = 0;
+
+    /// @brief The resize callback of `window` gets this viewport as its user data.
+    explicit Viewport(window::Window& window) : window(window) { window.user_data_ptr = this; }
+    Viewport(const Viewport&) = delete;
+    Viewport& operator=(const Viewport&) = delete;
+    void set_camera(const Camera& camera) { camera_tracker.set_camera(camera); }
 };
 
 /**
  *  @brief Container that initializes and holds a vulkan instance.
+ *  The device, the uploaded assets and the pipelines are shared by every Viewport, the window passed
+ *  to the constructor is the first one and add_window adds more.
  */
 struct Instance {
     constexpr static u32 WIDTH = 800;
     constexpr static u32 HEIGHT = 600;
 
     const static std::string MODEL_PATH;
-    const static std::string TEXTURE_PATH;
+    const static std::array<std::string, 2> TEXTURE_PATHS;
+    /// @brief Built from assets/ by the asset_pack target, loose files are the fallback when it is missing.
+    const static std::string ASSET_PACK_PATH;
+    /// @brief NCE_DRAW_BENCHMARK instances the model on an OBJECT_GRID x OBJECT_GRID grid, one draw per object.
+    constexpr static u32 OBJECT_GRID = 32;
+    /// @brief Side of the generated benchmark textures, small enough that thousands fit in memory.
+    constexpr static u32 BENCHMARK_TEXTURE_SIZE = 64;
     // Static Members
     /// @brief Required extensions for drawing with vulkan
     constexpr static std::array<CString, 1> validation_layers = { "VK_LAYER_KHRONOS_validation" };
     constexpr static std::array<CString, 2> extensions = { "VK_KHR_surface", "VK_KHR_xcb_surface" };
     constexpr static std::array<CString, 1> device_extensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
-    constexpr static u32 MAX_FRAMES_IN_FLIGHT = 2;
 
 
     //members
     VkApplicationInfo info_app; ///< Properties of the vulkan application
     VkInstanceCreateInfo info_create; ///< Vulkan Instance creation parameters
     static std::unique_ptr<VkInstance_T, VKEInstanceDeleter> instance; ///< Vulkan Instance
-    static std::unique_ptr<VkSurfaceKHR_T, VKESurfaceDeleter> surface;
     static VkPhysicalDevice physical_device;
     static std::unique_ptr<VkDevice_T, VKEDeviceDeleter> logical_device;
+    /// @brief Every device allocation, VKEMemoryDeleter reports frees to it.
+    static MemoryBudget memory_budget;
+    render_api::InstanceDispatch instance_dispatch;
+    render_api::DeviceDispatch dispatch; ///< hot paths call through this instead of the loader's exports
+    QueueFamilyIndices queue_families;
     VkQueue graphics_queue;
     VkQueue present_queue;
-    std::unique_ptr<VkSwapchainKHR_T, VKESwapChainDeleter> swapchain;
-    std::vector<VkImage> swapchain_images;
-    std::vector<std::unique_ptr<VkImageView_T, VKEImageViewDeleter>> swapchain_image_views;
-    VkFormat swapchain_image_format;
-    VkExtent2D swapchain_extent;
-    std::unique_ptr<VkRenderPass_T, VKERenderPassDeleter> render_pass;
-    std::unique_ptr<VkDescriptorSetLayout_T, VKEDescriptorSetLayoutDeleter> descriptor_set_layout;
+    VkQueue transfer_queue; ///< the graphics queue when the device has no dedicated transfer family
+    VkQueue compute_queue;
+    /// @brief front() is the window the Instance was created for, it picks the device and takes the captures.
+    std::vector<std::unique_ptr<Viewport>> viewports;
+    VkFormat color_format = VK_FORMAT_UNDEFINED; ///< of every swapchain, graphics_pipeline renders to it
+    /// @brief Shared by every pipeline, built concurrently at startup, it is internally synchronized.
+    std::unique_ptr<VkPipelineCache_T, VKEPipelineCacheDeleter> pipeline_cache;
+    DescriptorCache descriptor_cache; ///< owns every descriptor set layout
+    VkDescriptorSetLayout descriptor_set_layout = VK_NULL_HANDLE;
     std::unique_ptr<VkPipelineLayout_T, VKEPipelineLayoutDeleter> pipeline_layout;
     std::unique_ptr<VkPipeline_T, VKEGraphicsPipelineDeleter> graphics_pipeline;
-    std::vector<std::unique_ptr<VkFramebuffer_T, VKEFramebufferDeleter>> swapchain_framebuffers;
     std::unique_ptr<VkCommandPool_T, VKECommandPoolDeleter> command_pool;
     std::vector<VkCommandBuffer> command_buffers;
 
-    std::vector<std::unique_ptr<VkSemaphore_T, VKESemaphoreDeleter>> image_available_semaphores;
-    std::vector<std::unique_ptr<VkSemaphore_T, VKESemaphoreDeleter>> render_finished_semaphores;
-    std::vector<std::unique_ptr<VkFence_T, VKEFenceDeleter>> in_flight_fences;
+    std::unique_ptr<VkCommandPool_T, VKECommandPoolDeleter> transfer_command_pool;
+    std::unique_ptr<VkSemaphore_T, VKESemaphoreDeleter> upload_timeline; ///< timeline semaphore signaled by every upload submission
+    u64 upload_timeline_value = 0; ///< value signaled by the last submitted upload
+    u64 upload_waited_value = 0; ///< value the last graphics submission waited on
+    std::vector<VkBufferMemoryBarrier2> pending_buffer_acquires; ///< recorded at the start of the next frame
+    std::vector<VkImageMemoryBarrier2> pending_image_acquires;
+    std::vector<UploadBatch> uploads_in_flight;
+
+    std::vector<std::unique_ptr<VkFence_T, VKEFenceDeleter>> in_flight_fences; ///< one submission renders every viewport
     u32 current_frame = 0;
-    bool frame_buffer_resized = false;
-    const window::Window& window;
+    /// @brief Worker threads of the startup TaskGraph, 1 runs the stages serially in their declared order.
+    constexpr static u32 STARTUP_THREADS = 4;
+    std::chrono::steady_clock::time_point startup_begin; ///< start of the constructor, for time-to-first-frame
+    bool first_frame_presented = false;
+    std::optional<AssetPack> asset_pack;
     std::vector<Vertex> vertices;
     std::vector<u32> indices;
     std::unique_ptr<VkBuffer_T, VKEBufferDeleter> vertex_buffer;
     std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> vertex_buffer_memory;
     std::unique_ptr<VkBuffer_T, VKEBufferDeleter> index_buffer;
     std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> index_buffer_memory;
-    std::vector<std::unique_ptr<VkBuffer_T, VKEBufferDeleter>> uniform_buffers;
-    std::vector<std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>> uniform_buffers_memory;
-    std::vector<void*> uniform_buffers_mapped;
 
-    std::unique_ptr<VkDescriptorPool_T, VKEDescriptorPoolDeleter> descriptor_pool;
-    std::vector<VkDescriptorSet> descriptor_sets;
-    std::unique_ptr<VkImage_T, VKEImageDeleter> texture_image;
-    std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>  texture_image_memory;
+    DescriptorAllocator static_descriptors; ///< sets that live as long as the instance, cached in descriptor_cache
+    std::array<DescriptorAllocator, MAX_FRAMES_IN_FLIGHT> frame_descriptors; ///< reset when the frame's fence is signaled
 
-    std::unique_ptr<VkImageView_T, VKEImageViewDeleter> texture_image_view;
-    std::unique_ptr<VkSampler_T, VKESampleDeleter> texture_sampler;
+    VkDescriptorSetLayout bindless_set_layout = VK_NULL_HANDLE;
+    std::unique_ptr<VkDescriptorPool_T, VKEDescriptorPoolDeleter> bindless_pool;
+    VkDescriptorSet bindless_set = VK_NULL_HANDLE; ///< bound once per frame together with the per-frame set
+    SlotAllocator texture_slots{MAX_BINDLESS_TEXTURES, MAX_FRAMES_IN_FLIGHT};
+    SlotAllocator storage_buffer_slots{MAX_BINDLESS_STORAGE_BUFFERS, MAX_FRAMES_IN_FLIGHT};
 
+    std::vector<Texture> textures;
+    std::unique_ptr<VkSampler_T, VKESampleDeleter> texture_sampler;
 
-    std::unique_ptr<VkImage_T, VKEImageDeleter> depth_image;
-    std::unique_ptr<VkImageView_T, VKEImageViewDeleter> depth_image_view;
-    std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>  depth_image_memory;
+    std::vector<ObjectData> objects;
+    std::unique_ptr<VkBuffer_T, VKEBufferDeleter> object_buffer;
+    std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> object_buffer_memory;
+    u32 object_buffer_slot = SlotAllocator::INVALID;
+
+    ObjectBounds mesh_bounds{}; ///< bounds of the loaded model in model space
+    std::unique_ptr<VkBuffer_T, VKEBufferDeleter> object_bounds_buffer;
+    std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> object_bounds_memory;
+    u32 object_bounds_slot = SlotAllocator::INVALID;
+    VkDescriptorSetLayout cull_set_layout = VK_NULL_HANDLE; ///< the Hi-Z pyramid, sampled by the late phase
+    std::unique_ptr<VkPipelineLayout_T, VKEPipelineLayoutDeleter> cull_pipeline_layout;
+    std::unique_ptr<VkPipeline_T, VKEGraphicsPipelineDeleter> cull_pipeline;
+
+    std::unique_ptr<VkSampler_T, VKESampleDeleter> hiz_sampler; ///< max reduction
+    VkDescriptorSetLayout hiz_set_layout = VK_NULL_HANDLE;
+    std::unique_ptr<VkPipelineLayout_T, VKEPipelineLayoutDeleter> hiz_pipeline_layout;
+    std::unique_ptr<VkPipeline_T, VKEGraphicsPipelineDeleter> hiz_pipeline;
+
+    std::unique_ptr<VkQueryPool_T, VKEQueryPoolDeleter> timestamp_pool; ///< two timestamps per frame in flight
+    f32 timestamp_period = 0.0f; ///< nanoseconds per tick, 0 when the graphics queue has no timestamps
+    std::array<bool, MAX_FRAMES_IN_FLIGHT> timestamps_written{};
+    FrameStats frame_stats; ///< summed over the viewports drawn in the frame
+    u32 object_grid = 1; ///< objects per side, the scene is the model drawn once unless NCE_DRAW_BENCHMARK is set
+    u32 benchmark_textures = 0; ///< distinct generated textures the benchmark grid cycles through after TEXTURE_PATHS
+    bool culling = true; ///< off draws every object, see set_culling
+    /// @brief Frames between switching culling on and off (NCE_CULLING_COMPARE), 0 keeps it as set.
+    u32 culling_compare_interval = 0;
+    std::array<bool, MAX_FRAMES_IN_FLIGHT> frame_culling{}; ///< whether each frame in flight was recorded with culling
+    FrameStatsTotals culled_totals;
+    FrameStatsTotals unculled_totals;
+    bool memory_budget_extension = false; ///< VK_EXT_memory_budget was enabled
+    /// @brief Frames between two heap budget queries, allocations in between are accounted for by MemoryBudget.
+    constexpr static u32 MEMORY_BUDGET_INTERVAL = 120;
+    u64 frames_drawn = 0;
+    /// @brief Captures requested with request_capture, taken one per frame as readback slots free up.
+    std::deque<std::filesystem::path> pending_captures;
+    u32 capture_interval = 0; ///< continuous capture of every nth frame into capture_directory, 0 is off
+    std::filesystem::path capture_directory;
+    u64 captures_skipped = 0; ///< continuous captures that found no free readback slot
+    /// @brief More slots than frames in flight, so slots still being encoded do not stall capture.
+    constexpr static u32 READBACK_SLOTS = MAX_FRAMES_IN_FLIGHT + 2;
+    std::array<ReadbackSlot, READBACK_SLOTS> readback_slots;
+    ImageExporter image_exporter; ///< declared after readback_slots, its worker finishes with them before they are freed
+    f32 scene_rotation = 0.0f; ///< radians about z, interpolated from the simulation by the caller before draw_frame
+    glm::mat4 frame_model{1.0f}; ///< scene rotation of the frame being recorded, pushed with every draw
+    ReadbackSlot* frame_readback = nullptr; ///< slot the frame being recorded copies into, nullptr when it does not capture
 
 
     /// @brief Creates an Instance.
     /// Itializes Vulkan, selects a physical devices
     Instance(window::Window& window);
-    void create_depth_resources();
-    void update_uniform_buffer(u32 current_image);
+    /// @brief Prints the frame, memory and descriptor stats of the session.
+    ~Instance();
+    /**
+     *  @brief Render to another window from the next frame on, with its own swapchain and camera.
+     *  Nothing is uploaded again, the window costs its attachments, culling buffers and camera block.
+     */
+    auto add_window(window::Window& window) -> Viewport&;
+    /// @brief Apply the scene rotation, the camera block is only rewritten when the camera or extent changed.
+    void update_uniform_buffer(Viewport& viewport, u32 current_image);
+    /// @brief Camera of the first window, add_window returns the others.
+    void set_camera(const Camera& camera) { viewports.front()->set_camera(camera); }
+    /// @brief Scene state of the next frame, comes from the simulation thread rather than the frame's own clock.
+    void set_scene_rotation(f32 radians) { scene_rotation = radians; }
+    /// @brief Cull on the GPU (the default) or draw every object, from the next recorded frame on.
+    void set_culling(bool enabled) { culling = enabled; }
     void create_instance();
-    void create_surface(const window::Window& window);
+    void create_surface(Viewport& viewport);
     void pick_physical_device();
     void create_logical_device();
-    void create_swapchain();
-    void create_image_views();
-    void create_render_pass();
+    void create_pipeline_cache();
+    void create_swapchain(Viewport& viewport);
+    void create_image_views(Viewport& viewport);
     void create_descriptor_set_layout();
     void create_graphics_pipeline();
-    void create_framebuffers();
+    void create_cull_pipeline();
+    void create_hiz_pipeline();
+    /// @brief Build the per-frame render graph, attachments are bound each frame instead of baked into framebuffers.
+    void create_frame_graph(Viewport& viewport);
     void create_command_pool();
+    /// @brief Command pool and timeline semaphore of the transfer queue.
+    void create_upload_context();
     void create_command_buffers();
-    void record_command_buffer(VkCommandBuffer command_buffer, u32 image_index);
+    /// @brief Record the frame graph of every acquired viewport, one after the other.
+    void record_command_buffer(VkCommandBuffer command_buffer);
+    /// @brief Draw the survivors of `phase`, the late phase renders on top of the early one.
+    void record_main_pass(Viewport& viewport, VkCommandBuffer command_buffer, CullPhase phase);
+    /// @brief Cull every object on the GPU and compact the survivors of `phase` into this frame's draw buffer.
+    void record_cull_pass(Viewport& viewport, VkCommandBuffer command_buffer, CullPhase phase);
+    /// @brief Reduce the depth buffer into the Hi-Z pyramid, one dispatch per mip.
+    void record_hiz_pass(Viewport& viewport, VkCommandBuffer command_buffer);
+    /// @brief Acquire an image of every window, render them in one submission and present them with one vkQueuePresentKHR.
     void draw_frame();
     void load_model();
     void create_sync_objects();
+    /// @brief Acquire and present semaphores, per frame in flight.
+    void create_semaphores(Viewport& viewport);
     void create_vertex_buffer();
     void create_index_buffer();
-    void create_uniform_buffers();
+    void create_uniform_buffers(Viewport& viewport);
     void create_descriptor_pool();
-    void create_descriptor_sets();
-    void recreate_swapchain();
-    void create_texture_image();
+    /// @brief Set allocated from the current frame's pools, valid until the frame is recorded again.
+    [[nodiscard]] auto allocate_frame_descriptor_set(VkDescriptorSetLayout layout) -> VkDescriptorSet;
+    [[nodiscard]] auto descriptor_stats() const -> DescriptorStats;
+    void create_descriptor_sets(Viewport& viewport);
+    /// @brief Waits for the device, the other viewports keep their swapchains.
+    void recreate_swapchain(Viewport& viewport);
+    void create_texture_image(std::span<const DecodedTexture> decoded);
     void create_texture_image_view();
     void create_texture_sampler();
-    void create_image(u32 width, u32 height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, std::unique_ptr<VkImage_T, VKEImageDeleter>& image, std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>& image_memory);
-    void create_buffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, std::unique_ptr<VkBuffer_T, VKEBufferDeleter>& buffer, std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>& buffer_memory);
+    void create_object_buffer();
+    /// @brief Object bounds, shared by every viewport, and the culling buffers of each.
+    void create_cull_buffers();
+    /// @brief Visibility and the per-frame indirect draw buffers written by the viewport's cull passes.
+    void create_draw_buffers(Viewport& viewport);
+    /// @brief (Re)create the Hi-Z pyramid for the current depth extent.
+    void create_hiz_resources(Viewport& viewport);
+    void create_frame_stats();
+    void create_stats_buffers(Viewport& viewport);
+    /// @brief Collect the stats of the frame whose fence was just waited on.
+    void read_frame_stats();
+    /// @brief Write the next presented frame to `path`, .qoi or .png, without stalling the frame loop.
+    void request_capture(std::filesystem::path path);
+    /// @brief Capture every `interval`th frame into `directory` as QOI, 0 stops.
+    void capture_continuously(std::filesystem::path directory, u32 interval);
+    /// @brief A free readback slot sized for the viewport's swapchain when this frame captures, nullptr otherwise.
+    [[nodiscard]] auto begin_readback(const Viewport& viewport) -> ReadbackSlot*;
+    /// @brief Copy the frame's swapchain image into frame_readback, run by the capture graph's readback pass.
+    void record_readback(const Viewport& viewport, VkCommandBuffer command_buffer);
+    /// @brief Hand the copies of the frame whose fence was just waited on to the exporter.
+    void collect_readbacks();
+    /// @brief `path` out of the asset pack, or the loose file when the pack does not have it.
+    [[nodiscard]] auto load_asset(const std::string& path) const -> Asset;
+    [[nodiscard]] auto decode_texture(const std::string& path) const -> DecodedTexture;
+    /// @brief A checkerboard of its own color per `index`, so every benchmark draw samples a different texture.
+    [[nodiscard]] static auto generate_texture(u32 index) -> DecodedTexture;
+    /// @brief Copy decoded pixels into a device local texture, shader readable once `upload` completes.
+    [[nodiscard]] auto load_texture(UploadBatch& upload, const DecodedTexture& decoded) -> Texture;
+    /// @brief Write a texture into a free slot of the bindless array, the slot is what shaders index with.
+    [[nodiscard]] auto register_texture(VkImageView view) -> u32;
+    [[nodiscard]] auto register_storage_buffer(VkBuffer buffer, VkDeviceSize range) -> u32;
+    void release_texture(u32 slot) { texture_slots.release(slot); }
+    void release_storage_buffer(u32 slot) { storage_buffer_slots.release(slot); }
+    void create_image(u32 width, u32 height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, MemoryCategory category, std::unique_ptr<VkImage_T, VKEImageDeleter>& image, std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>& image_memory, u32 mip_levels = 1);
+    void create_buffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, MemoryCategory category, std::unique_ptr<VkBuffer_T, VKEBufferDeleter>& buffer, std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>& buffer_memory);
+    /**
+     *  @brief The single path to vkAllocateMemory.
+     *  Queries the budgets again when the allocation would exceed the heap's soft budget. A failed
+     *  allocation is retried once after a refresh, a second failure prints the memory stats and crashes.
+     */
+    [[nodiscard]] auto allocate_memory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, MemoryCategory category) -> std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>;
+    /// @brief Query heap budgets and usage, from VK_EXT_memory_budget when it is enabled.
+    void refresh_memory_budget();
+    /// @brief Snapshot of the device memory accounting, refreshed every MEMORY_BUDGET_INTERVAL frames.
+    [[nodiscard]] auto memory_stats() const -> MemoryStats { return memory_budget.snapshot(); }
     void transition_image_layout(VkImage image, VkFormat format, VkImageLayout old_layout, VkImageLayout new_layout);
-    void copy_buffer_to_image(VkBuffer buffer, VkImage image, u32 width, u32 height);
-
-
-
-    [[nodiscard]] auto create_image_view(VkImage image, VkFormat format, VkImageAspectFlags aspect_flags) -> VkImageView;
+    [[nodiscard]] auto begin_upload() -> UploadBatch;
+    /// @brief Stage `data` and copy it into `dst`, which is then owned by the graphics queue for dst_stage/dst_access.
+    void upload_buffer(UploadBatch& upload, VkBuffer dst, const void* data, VkDeviceSize size, VkPipelineStageFlags2 dst_stage, VkAccessFlags2 dst_access);
+    /// @brief Stage `data` and copy it into `image`, which is left in SHADER_READ_ONLY_OPTIMAL for fragment shaders.
+    void upload_image(UploadBatch& upload, VkImage image, const void* data, VkDeviceSize size, u32 width, u32 height);
+    /**
+     *  @brief Submit the batch on the transfer queue without waiting for it.
+     *  The next frame waits on the upload timeline and acquires the uploaded resources.
+     */
+    void submit_upload(UploadBatch&& upload);
+    /// @brief Free the command buffers and staging memory of completed uploads.
+    void collect_uploads();
+    void submit(VkQueue queue, VkCommandBuffer command_buffer, std::span<const VkSemaphoreSubmitInfo> waits, std::span<const VkSemaphoreSubmitInfo> signals, VkFence fence) const;
+    /// @brief Create the transient images of a compiled graph, sharing memory between aliased images.
+    [[nodiscard]] auto realize_render_graph(RenderGraph& graph, const CompiledGraph& compiled) -> RenderGraphImages;
+
+
+
+    [[nodiscard]] auto create_image_view(VkImage image, VkFormat format, VkImageAspectFlags aspect_flags, u32 base_mip = 0, u32 mip_count = 1) -> VkImageView;
     [[nodiscard]] auto find_supported_format(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features) const -> VkFormat;
     [[nodiscard]] auto find_depth_format() -> VkFormat;
     [[nodiscard]] auto has_stencil_component(VkFormat format) -> bool;
     [[nodiscard]] auto begin_single_time_commands() const -> VkCommandBuffer;
     auto end_single_time_commands(VkCommandBuffer command_buffer) const -> void;
 
-    auto copy_buffer(VkBuffer src_buffer, VkBuffer dst_buffer, VkDeviceSize size) const -> void;
     [[nodiscard]] auto find_memory_type(u32 type_filter, VkMemoryPropertyFlags properties) const -> u32;
     [[nodiscard]] auto check_device_extension_support(VkPhysicalDevice device) const -> bool;
+    [[nodiscard]] auto supports_device_extension(VkPhysicalDevice device, std::string_view name) const -> bool;
     [[nodiscard]] auto find_queue_families(VkPhysicalDevice device) -> QueueFamilyIndices;
     /// @brief Rate GPUs based on needed features
     auto rate_device(VkPhysicalDevice device) -> u32;
@@ -289,8 +606,8 @@ struct Instance {
     [[nodiscard]] auto query_swapchain_support(VkPhysicalDevice device, NonOwningPtr<VkSurfaceKHR_T> surface) const -> SwapChainSupportDetails;
     [[nodiscard]] auto choose_swap_surface_format(const std::vector<VkSurfaceFormatKHR>& available_formats) const -> VkSurfaceFormatKHR;
     [[nodiscard]] auto choose_swap_present_mode(const std::vector<VkPresentModeKHR>& available_present_modes) const -> VkPresentModeKHR;
-    [[nodiscard]] auto choose_swap_extent(const VkSurfaceCapabilitiesKHR& capabilities) const -> VkExtent2D;
-    [[nodiscard]] auto create_shader_module(const std::vector<std::byte>& shader_code) const -> std::unique_ptr<VkShaderModule_T, VKEShaderModuleDeleter>;
+    [[nodiscard]] auto choose_swap_extent(const VkSurfaceCapabilitiesKHR& capabilities, const window::Window& window) const -> VkExtent2D;
+    [[nodiscard]] auto create_shader_module(std::span<const std::byte> shader_code) const -> std::unique_ptr<VkShaderModule_T, VKEShaderModuleDeleter>;
 };
 
 
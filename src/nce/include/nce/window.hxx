@@ -1,5 +1,9 @@
 #pragma once
+#include <array>
+#include <chrono>
 #include <limits>
+#include <string_view>
+#include <unistd.h>
 #include <xcb/xcb.h>
 #include <xcb/xproto.h>
 #include <xcb/xcb_keysyms.h>
@@ -17,6 +21,11 @@
 
 #include <nce/log.hxx>
 #include <nce/keycode.hxx>
+#include <nce/key_map.hxx>
+#include <nce/window_events.hxx>
+#include <nce/input_thread.hxx>
+#include <nce/pointer.hxx>
+#include <nce/input_log.hxx>
 
 #include <nce/carray.hxx>
 #include <nce/non_owning_ptr.hxx>
@@ -33,25 +42,6 @@ struct XCBKeySymDeleter { void operator()(xcb_key_symbols_t* ptr){ xcb_key_symbo
 struct XKBStateDeleter { void operator()(xkb_state* ptr){ xkb_state_unref(ptr); } };
 struct XKBKeyMapDeleter { void operator()(xkb_keymap* ptr){ xkb_keymap_unref(ptr); } };
 struct XKBContextDeleter { void operator()(xkb_context* ptr){ xkb_context_unref(ptr); } };
-struct KeyPressQueue {
-    bool prev;
-    bool curr;
-
-    KeyPressQueue() : prev(false), curr(false) {}
-    void push(bool e) { std::swap(prev, curr); curr = e; }
-    void invalidate() { prev = false; curr = false; }
-};
-struct KeyState {
-    KeyPressQueue pressed;
-    bool key_down;
-    void invalidate() { pressed.invalidate(); key_down = false; }
-};
-struct KeyMap {
-    std::unordered_map<nce::KeyCode, KeyState> keys;
-    bool is_pressed(nce::KeyCode code);
-    bool is_down(nce::KeyCode code);
-    void invalidate() { for (auto& e : keys) { e.second.invalidate(); } };
-};
 
 namespace window {
     template<typename T> struct WindowVec2 {
@@ -80,17 +70,13 @@ namespace window {
             background_color(bg_color), dimensions(dimensions), position(position), name(name), resizable(resizable) {}
     };
 
-    struct EventQueue {
-        std::unique_ptr<xcb_generic_event_t, CFreeDeleter> prev;
-        std::unique_ptr<xcb_generic_event_t, CFreeDeleter> curr;
-        std::unique_ptr<xcb_generic_event_t, CFreeDeleter> next;
-
-        EventQueue() : prev(nullptr), curr(nullptr), next(nullptr) {}
-        void push(std::unique_ptr<xcb_generic_event_t, CFreeDeleter>&& e) {
-            prev.swap(e);
-            prev.swap(curr);
-            curr.swap(next);
-        }
+    /// @brief Where WindowBuilder::build spent its time.
+    struct SetupTimings {
+        f64 connect_ms = 0.0;
+        f64 requests_ms = 0.0; ///< sending the atoms, extension queries and the window, nothing waits
+        f64 replies_ms = 0.0; ///< the one wait for every reply
+        f64 keymap_ms = 0.0; ///< properties, mapping, then the keymap and keyboard state
+        f64 total_ms = 0.0;
     };
 
     struct Window {
@@ -98,15 +84,27 @@ namespace window {
             return {"VK_KHR_surface", "VK_KHR_xcb_surface"};
         }
         Attributes attributes;
-        std::unique_ptr<xcb_connection_t, XCBConnectionDeleter> x_connection;
-        xcb_window_t x_window;
+        std::unique_ptr<xcb_connection_t, XCBConnectionDeleter> x_connection; ///< null for a headless window
+        xcb_window_t x_window = XCB_WINDOW_NONE;
+        std::unique_ptr<InputThread> input_thread; ///< null unless built with_input_thread, stopped before the connection closes
         std::unique_ptr<xkb_state, XKBStateDeleter> kb_state;
-        EventQueue event_queue;
-        KeyMap keys;
+        EventFilter event_filter;
+        EventRing event_ring;
+        EventStats event_stats; ///< of the last poll_events call
+        InputLatency input_latency; ///< of every event the input thread handed over
+        nce::KeyMap keys; ///< snapshot of the last poll_events call
+        Pointer pointer; ///< position, motion, buttons and scroll of the last poll_events call
         std::function<void(u32 width, u32 height, void* user_data)> resize_callback = nullptr;
         void* user_data_ptr = nullptr;
-
-        i32 kb_device_id;
+        bool damaged = true; ///< set by Expose, whoever redraws the window clears it
+        std::unique_ptr<InputRecorder> recorder; ///< null unless built with_input_recording, every handled event is appended
+        std::unique_ptr<InputReplay> replay; ///< null unless built with_input_replay, replaces live input
+        u64 frame_index = 0; ///< poll_events calls so far
+        bool close_requested = false; ///< the window manager asked to close the window (WM_DELETE_WINDOW)
+        SetupTimings setup_timings; ///< zero for a headless window
+
+        i32 kb_device_id = -1;
+        std::unique_ptr<xkb_context, XKBContextDeleter> kb_context;
         std::unique_ptr<xkb_keymap, XKBKeyMapDeleter> keymap;
 
         ~Window() = default;
@@ -120,7 +118,21 @@ namespace window {
         Window& operator=(Window& o) = delete;
 
         // methods
+        /// @brief Drain every pending X event, or everything the input thread queued, and handle them in arrival order.
         void poll_events();
+        /// @brief fd that turns readable when input arrives, the input thread's when there is one, -1 when headless.
+        [[nodiscard]] auto wait_fd() const -> i32;
+        /**
+         *  @brief Whether poll_events has something to handle without anything new on wait_fd(): events
+         *  xcb already read while waiting for a reply, events the input thread queued or a replay.
+         */
+        [[nodiscard]] auto has_pending_input() -> bool;
+        /**
+         *  @brief Call after replies were read on the connection outside the window, a Vulkan present does.
+         *  Events xcb queued while waiting for them reach the input thread, without one has_pending_input() finds them.
+         */
+        void notify_replies_read();
+        /// @brief true once the window manager asked to close the window or a replay has handed out its last event.
         bool should_close();
 
         friend struct WindowBuilder;
@@ -128,6 +140,15 @@ namespace window {
             return os << "Window (" << &w << "): { " << "asdf";
         }
         private:
+        void process_events(EventRing& ring);
+        /// @brief Everything about an event that needs no connection, shared by live input and replays.
+        void handle_event(const WindowEvent& event, u32 keysym);
+        /// @brief New keymap and state from the server, two round trips, only after XKB says the keymap changed.
+        void reload_keymap();
+        bool resize_pending = false; ///< dimensions changed since the last resize callback
+        std::unique_ptr<xcb_generic_event_t, CFreeDeleter> peeked; ///< taken off xcb's queue by has_pending_input, handled first
+        u32 exposes = 0; ///< since the start of the current poll_events call
+        u32 round_trips = 0;
         Window() {}
         Window(Attributes attributes, std::unique_ptr<xcb_connection_t, XCBConnectionDeleter>&& x_connection, xcb_window_t x_window, std::unique_ptr<xkb_state, XKBStateDeleter>&& kb_state, std::function<void(u32 width, u32 height, void* user_data)> resize_callback, i32 kb_device_id, std::unique_ptr<xkb_keymap, XKBKeyMapDeleter>&& keymap)
             : attributes(attributes), x_connection(std::move(x_connection)), 
@@ -136,22 +157,15 @@ namespace window {
             resize_callback(resize_callback),
             kb_device_id(kb_device_id),
             keymap(std::move(keymap))
-        {
-            xcb_change_property (this->x_connection.get(),
-                    XCB_PROP_MODE_REPLACE,
-                    this->x_window,
-                    XCB_ATOM_WM_NAME,
-                    XCB_ATOM_STRING,
-                    8,
-                    this->attributes.name.size(),
-                    this->attributes.name);
-
-
-        }
+        {}
     };
     struct WindowBuilder {
         Attributes attributes;
         std::function<void(u32 width, u32 height, void* user_data)> resize_callback = nullptr;
+        bool input_thread = false;
+        bool pointer_history = false;
+        bool input_recording = false;
+        std::optional<InputReplay> input_replay;
         WindowBuilder() {};
         auto with_dimensions(u32 x, u32 y) -> WindowBuilder& {
             attributes.dimensions = WindowVec2<u32>(x, y);
@@ -177,41 +191,73 @@ namespace window {
             this->resize_callback = resize_callback;
             return *this;
         }
+        /// @brief Read events on a dedicated thread instead of in poll_events.
+        auto with_input_thread(bool input_thread) -> WindowBuilder& {
+            this->input_thread = input_thread;
+            return *this;
+        }
+        /// @brief Keep every motion event of a frame in Window::pointer.history(), not only the coalesced delta.
+        auto with_pointer_history(bool pointer_history) -> WindowBuilder& {
+            this->pointer_history = pointer_history;
+            return *this;
+        }
+        /// @brief Keep every handled event in Window::recorder for writing an input log.
+        auto with_input_recording(bool input_recording) -> WindowBuilder& {
+            this->input_recording = input_recording;
+            return *this;
+        }
+        /// @brief Input comes from `replay` instead of the X server, the window's geometry stays live.
+        auto with_input_replay(InputReplay replay) -> WindowBuilder& {
+            input_replay = std::move(replay);
+            return *this;
+        }
+        /**
+         *  @brief A window without a connection, for replaying an input log where there is no X server.
+         *  Recorded configure events resize it and fire the resize callback like they did when recorded.
+         */
+        [[nodiscard]] auto build_headless() -> Window {
+            Window result;
+            result.attributes = attributes;
+            result.resize_callback = resize_callback;
+            set_input(result);
+            return result;
+        }
+        /**
+         *  @brief Connect, create and map the window.
+         *  Every request that does not need a reply is sent before any reply is read: the atoms, the XKB
+         *  extension and core keyboard queries and the window itself. Startup then waits on the server
+         *  once for all of them and once more for the keymap, instead of once per request.
+         */
         [[nodiscard]] auto build() -> Window {
+            using Clock = std::chrono::steady_clock;
+            auto elapsed_ms = [](Clock::time_point from, Clock::time_point to) { return std::chrono::duration<f64, std::milli>(to - from).count(); };
+            auto begin = Clock::now();
+
             /* Open the connection to the X server */
             std::unique_ptr<xcb_connection_t, XCBConnectionDeleter> x_connection(xcb_connect (nullptr, nullptr));
-
-            // Conncet to WM
-            std::string WM_PROTOCOLS_PROPERTY_NAME = "WM_PROTOCOLS";
-            xcb_intern_atom_cookie_t intern_atom_cookie = xcb_intern_atom(x_connection.get(), true, static_cast<u16>(WM_PROTOCOLS_PROPERTY_NAME.size()),
-                    WM_PROTOCOLS_PROPERTY_NAME.c_str());
-            std::unique_ptr<xcb_intern_atom_reply_t, XCBAtomDeleter> intern_atom_reply(xcb_intern_atom_reply(x_connection.get(), intern_atom_cookie, NULL));
-            // [unused var] xcb_atom_t window_manager_protocols_property = intern_atom_reply->atom;
+            if (xcb_connection_has_error(x_connection.get())) { LOGERROR("Couldn't connect to the X server"); std::abort(); }
+            xcb_connection_t* connection = x_connection.get();
+            auto connected = Clock::now();
 
             // keyboard setup
             std::unique_ptr<xkb_context, XKBContextDeleter> kb_context(xkb_context_new(XKB_CONTEXT_NO_FLAGS));
             if (!kb_context) { LOGERROR("Couldn't create keyboard context"); std::abort(); }
 
-            xkb_x11_setup_xkb_extension(x_connection.get(), XKB_X11_MIN_MAJOR_XKB_VERSION, XKB_X11_MIN_MINOR_XKB_VERSION, XKB_X11_SETUP_XKB_EXTENSION_NO_FLAGS, nullptr,  nullptr,  nullptr,  nullptr);
-
-            i32 kb_device_id = xkb_x11_get_core_keyboard_device_id(x_connection.get());
-            if (kb_device_id == -1) { LOGERROR("Couldn't get kb device id"); std::abort(); }
-
-            std::unique_ptr<xkb_keymap, XKBKeyMapDeleter> keymap(xkb_x11_keymap_new_from_device(kb_context.get(), x_connection.get(), kb_device_id, XKB_KEYMAP_COMPILE_NO_FLAGS));
-            if (!keymap) { LOGERROR("Couldn't get kb device id"); std::abort(); }
-
-
-
-            std::unique_ptr<xkb_state, XKBStateDeleter> kb_state(xkb_x11_state_new_from_device(keymap.get(), x_connection.get(), kb_device_id));
-            if (!kb_state) { LOGERROR("Couldn't get kb device id"); std::abort(); }
+            // Phase 1: requests, nothing below waits for the server
+            constexpr std::array<std::string_view, 5> atom_names = {"WM_PROTOCOLS", "WM_DELETE_WINDOW", "_NET_WM_NAME", "_NET_WM_PID", "UTF8_STRING"};
+            std::array<xcb_intern_atom_cookie_t, atom_names.size()> atom_cookies{};
+            for (size_t i = 0; i < atom_names.size(); i++) {
+                atom_cookies[i] = xcb_intern_atom(connection, false, static_cast<u16>(atom_names[i].size()), atom_names[i].data());
+            }
+            // what xkb_x11_setup_xkb_extension and xkb_x11_get_core_keyboard_device_id ask, without waiting in between
+            xcb_prefetch_extension_data(connection, &xcb_xkb_id);
+            xcb_xkb_use_extension_cookie_t xkb_use_cookie = xcb_xkb_use_extension(connection, XKB_X11_MIN_MAJOR_XKB_VERSION, XKB_X11_MIN_MINOR_XKB_VERSION);
+            xcb_xkb_get_device_info_cookie_t xkb_device_cookie = xcb_xkb_get_device_info(connection, XCB_XKB_ID_USE_CORE_KBD, 0, 0, 0, 0, 0, 0);
 
-            NonOwningPtr<const xcb_setup_t> x_setup = xcb_get_setup(x_connection.get());
+            NonOwningPtr<const xcb_setup_t> x_setup = xcb_get_setup(connection);
             xcb_screen_iterator_t x_iter            = xcb_setup_roots_iterator (x_setup);
             NonOwningPtr<xcb_screen_t> x_screen     = x_iter.data;
-            xcb_window_t window = xcb_generate_id(x_connection.get());
-
-
-
+            xcb_window_t window = xcb_generate_id(connection);
 
             xcb_create_window_value_list_t value_window = {};
             value_window.background_pixel = static_cast<u32>(attributes.background_color.b) << 16u 
@@ -226,7 +272,6 @@ namespace window {
                 | XCB_EVENT_MASK_ENTER_WINDOW
                 | XCB_EVENT_MASK_LEAVE_WINDOW
                 | XCB_EVENT_MASK_POINTER_MOTION
-                | XCB_EVENT_MASK_POINTER_MOTION_HINT
                 | XCB_EVENT_MASK_BUTTON_1_MOTION
                 | XCB_EVENT_MASK_BUTTON_2_MOTION
                 | XCB_EVENT_MASK_BUTTON_3_MOTION
@@ -247,7 +292,7 @@ namespace window {
                 value_window.event_mask |= XCB_EVENT_MASK_RESIZE_REDIRECT;
             }
 
-            xcb_create_window_aux(x_connection.get(),
+            xcb_create_window_aux(connection,
                     x_screen->root_depth,
                     window,
                     x_screen->root,
@@ -257,6 +302,14 @@ namespace window {
                     x_screen->root_visual,
                     XCB_CW_EVENT_MASK | XCB_CW_BACK_PIXEL, 
                     &value_window);
+            xcb_change_property (connection,
+                    XCB_PROP_MODE_REPLACE,
+                    window,
+                    XCB_ATOM_WM_NAME,
+                    XCB_ATOM_STRING,
+                    8,
+                    attributes.name.size(),
+                    attributes.name);
 
             fmt::println("Resizable is {}", attributes.resizable);
             if (!attributes.resizable) {
@@ -264,15 +317,99 @@ namespace window {
                 xcb_icccm_size_hints_set_min_size(&window_size_hints, static_cast<i32>(attributes.dimensions.x), static_cast<i32>(attributes.dimensions.y));
                 xcb_icccm_size_hints_set_max_size(&window_size_hints, static_cast<i32>(attributes.dimensions.x), static_cast<i32>(attributes.dimensions.y));
 
-                xcb_icccm_set_wm_size_hints(x_connection.get(), window, XCB_ATOM_WM_NORMAL_HINTS, &window_size_hints);
+                xcb_icccm_set_wm_size_hints(connection, window, XCB_ATOM_WM_NORMAL_HINTS, &window_size_hints);
+            }
+            xcb_flush(connection);
+            auto requested = Clock::now();
+
+            // Phase 2: replies, the first one waits for the server to get through everything above
+            std::array<xcb_atom_t, atom_names.size()> atoms{};
+            for (size_t i = 0; i < atom_names.size(); i++) {
+                std::unique_ptr<xcb_intern_atom_reply_t, XCBAtomDeleter> reply(xcb_intern_atom_reply(connection, atom_cookies[i], nullptr));
+                atoms[i] = reply ? reply->atom : xcb_atom_t{XCB_ATOM_NONE};
+            }
+            const auto [wm_protocols, wm_delete_window, net_wm_name, net_wm_pid, utf8_string] = atoms;
+
+            const xcb_query_extension_reply_t* xkb_extension = xcb_get_extension_data(connection, &xcb_xkb_id);
+            if (!xkb_extension || !xkb_extension->present) { LOGERROR("The X server has no XKB extension"); std::abort(); }
+            std::unique_ptr<xcb_xkb_use_extension_reply_t, CFreeDeleter> xkb_use(xcb_xkb_use_extension_reply(connection, xkb_use_cookie, nullptr));
+            if (!xkb_use || !xkb_use->supported) { LOGERROR("Couldn't set up the XKB extension"); std::abort(); }
+            std::unique_ptr<xcb_xkb_get_device_info_reply_t, CFreeDeleter> xkb_device(xcb_xkb_get_device_info_reply(connection, xkb_device_cookie, nullptr));
+            if (!xkb_device) { LOGERROR("Couldn't get kb device id"); std::abort(); }
+            i32 kb_device_id = xkb_device->deviceID;
+            u8 xkb_first_event = xkb_extension->first_event;
+            auto replied = Clock::now();
+
+            // Phase 3: what needed the replies, the window is mapped before the keymap is fetched so the
+            // server maps it while the keymap requests are answered
+            if (wm_protocols != XCB_ATOM_NONE && wm_delete_window != XCB_ATOM_NONE) {
+                xcb_atom_t protocols[] = {wm_delete_window};
+                xcb_icccm_set_wm_protocols(connection, window, wm_protocols, 1, protocols);
+            }
+            if (net_wm_name != XCB_ATOM_NONE && utf8_string != XCB_ATOM_NONE) {
+                xcb_change_property(connection, XCB_PROP_MODE_REPLACE, window, net_wm_name, utf8_string, 8, attributes.name.size(), attributes.name);
+            }
+            if (net_wm_pid != XCB_ATOM_NONE) {
+                u32 pid = static_cast<u32>(getpid());
+                xcb_change_property(connection, XCB_PROP_MODE_REPLACE, window, net_wm_pid, XCB_ATOM_CARDINAL, 32, 1, &pid);
             }
 
-            /* Map the window on the screen */
-            xcb_map_window(x_connection.get(), window);
-            xcb_flush(x_connection.get());
+            // Modifier state follows StateNotify and the keymap is only reloaded on NewKeyboardNotify/MapNotify,
+            // nothing has to ask the server for the keyboard state while events are handled
+            constexpr u16 xkb_events = XCB_XKB_EVENT_TYPE_NEW_KEYBOARD_NOTIFY
+                | XCB_XKB_EVENT_TYPE_MAP_NOTIFY
+                | XCB_XKB_EVENT_TYPE_STATE_NOTIFY;
+            constexpr u16 xkb_map_parts = XCB_XKB_MAP_PART_KEY_TYPES
+                | XCB_XKB_MAP_PART_KEY_SYMS
+                | XCB_XKB_MAP_PART_MODIFIER_MAP
+                | XCB_XKB_MAP_PART_EXPLICIT_COMPONENTS
+                | XCB_XKB_MAP_PART_KEY_ACTIONS
+                | XCB_XKB_MAP_PART_VIRTUAL_MODS
+                | XCB_XKB_MAP_PART_VIRTUAL_MOD_MAP;
+            constexpr u16 xkb_state_details = XCB_XKB_STATE_PART_MODIFIER_BASE
+                | XCB_XKB_STATE_PART_MODIFIER_LATCH
+                | XCB_XKB_STATE_PART_MODIFIER_LOCK
+                | XCB_XKB_STATE_PART_GROUP_BASE
+                | XCB_XKB_STATE_PART_GROUP_LATCH
+                | XCB_XKB_STATE_PART_GROUP_LOCK;
+            xcb_xkb_select_events_details_t xkb_details = {};
+            xkb_details.affectNewKeyboard = XCB_XKB_NKN_DETAIL_KEYCODES;
+            xkb_details.newKeyboardDetails = XCB_XKB_NKN_DETAIL_KEYCODES;
+            xkb_details.affectState = xkb_state_details;
+            xkb_details.stateDetails = xkb_state_details;
+            xcb_xkb_select_events_aux(connection, static_cast<xcb_xkb_device_spec_t>(kb_device_id), xkb_events, 0, 0, xkb_map_parts, xkb_map_parts, &xkb_details);
 
+            /* Map the window on the screen */
+            xcb_map_window(connection, window);
+            xcb_flush(connection);
 
-            return Window(attributes, std::move(x_connection), window, std::move(kb_state), resize_callback, kb_device_id, std::move(keymap));
+            std::unique_ptr<xkb_keymap, XKBKeyMapDeleter> keymap(xkb_x11_keymap_new_from_device(kb_context.get(), connection, kb_device_id, XKB_KEYMAP_COMPILE_NO_FLAGS));
+            if (!keymap) { LOGERROR("Couldn't get kb device id"); std::abort(); }
+            std::unique_ptr<xkb_state, XKBStateDeleter> kb_state(xkb_x11_state_new_from_device(keymap.get(), connection, kb_device_id));
+            if (!kb_state) { LOGERROR("Couldn't get kb device id"); std::abort(); }
+            auto end = Clock::now();
+
+            Window result(attributes, std::move(x_connection), window, std::move(kb_state), resize_callback, kb_device_id, std::move(keymap));
+            result.kb_context = std::move(kb_context);
+            result.event_filter = EventFilter{window, xkb_first_event, wm_protocols, wm_delete_window};
+            result.setup_timings = SetupTimings{elapsed_ms(begin, connected), elapsed_ms(connected, requested), elapsed_ms(requested, replied),
+                elapsed_ms(replied, end), elapsed_ms(begin, end)};
+            set_input(result);
+            if (input_thread) {
+                result.input_thread = std::make_unique<InputThread>(result.x_connection.get(), result.event_filter);
+            }
+            return result;
+        }
+        private:
+        void set_input(Window& result) {
+            result.pointer = Pointer(pointer_history);
+            if (input_recording) {
+                result.recorder = std::make_unique<InputRecorder>(input_clock_ns());
+            }
+            if (input_replay) {
+                result.replay = std::make_unique<InputReplay>(std::move(*input_replay));
+                input_replay.reset();
+            }
         }
     };
 }
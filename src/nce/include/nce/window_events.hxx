@@ -0,0 +1,150 @@
+#pragma once
+#include <xcb/xcb.h>
+#include <xcb/xproto.h>
+#include <xcb/xkb.h>
+
+#include <nce/carray.hxx>
+
+#include <array>
+#include <memory>
+#include <optional>
+
+namespace window {
+
+enum class EventType : u8 {
+    key_press,
+    key_release,
+    button_press,
+    button_release,
+    motion,
+    configure, ///< the window was moved or resized
+    expose,
+    focus_in,
+    focus_out,
+    keyboard_state, ///< XKB modifier or group change
+    keyboard_changed, ///< XKB keymap change or a new keyboard, the keymap has to be reloaded
+    close_requested, ///< WM_DELETE_WINDOW from the window manager, time is its server time
+};
+
+/**
+ *  @brief An X event reduced to what the window handles, small enough to queue thousands per frame.
+ *  Decoding needs no connection and no keyboard state, keycodes are translated to keysyms when the
+ *  event is processed so modifier changes apply in event order.
+ *  keyboard_state packs the XKB state into the same fields: detail is the locked modifiers, state the
+ *  base modifiers | latched modifiers << 8, x, y and width the base, latched and locked group.
+ */
+struct WindowEvent {
+    EventType type;
+    u8 detail = 0; ///< keycode or button
+    u16 state = 0; ///< modifier and button mask
+    u32 time = 0; ///< server time in milliseconds, 0 for configure and expose
+    i16 x = 0; ///< pointer position, or the window position for configure and the damaged rect for expose
+    i16 y = 0;
+    u16 width = 0; ///< configure and expose
+    u16 height = 0;
+};
+
+/// @brief Which events decode_event keeps.
+struct EventFilter {
+    xcb_window_t window = XCB_WINDOW_NONE;
+    u8 xkb_first_event = 0; ///< response type of XKB events, 0 when XKB events are not selected
+    xcb_atom_t wm_protocols = XCB_ATOM_NONE; ///< close requests are ignored until both atoms are known
+    xcb_atom_t wm_delete_window = XCB_ATOM_NONE;
+};
+
+/// @brief std::nullopt for events the window ignores or that belong to another window.
+[[nodiscard]] auto decode_event(const xcb_generic_event_t& event, const EventFilter& filter) -> std::optional<WindowEvent>;
+
+/// @brief Fixed capacity FIFO of decoded events, nothing is allocated while events are pumped.
+class EventRing {
+public:
+    constexpr static u32 CAPACITY = 1024;
+
+    /// @brief false when the ring is full.
+    auto push(const WindowEvent& event) -> bool {
+        if (count == CAPACITY) { return false; }
+        events[(head + count) % CAPACITY] = event;
+        count++;
+        return true;
+    }
+    auto pop() -> WindowEvent {
+        WindowEvent event = events[head];
+        head = (head + 1) % CAPACITY;
+        count--;
+        return event;
+    }
+    /// @brief Takes back the newest event.
+    auto pop_back() -> WindowEvent {
+        count--;
+        return events[(head + count) % CAPACITY];
+    }
+    [[nodiscard]] auto front() const -> const WindowEvent& { return events[head]; }
+    [[nodiscard]] auto back() const -> const WindowEvent& { return events[(head + count - 1) % CAPACITY]; }
+    [[nodiscard]] auto size() const -> u32 { return count; }
+    [[nodiscard]] auto empty() const -> bool { return count == 0; }
+    [[nodiscard]] auto full() const -> bool { return count == CAPACITY; }
+
+private:
+    std::array<WindowEvent, CAPACITY> events{};
+    u32 head = 0;
+    u32 count = 0;
+};
+
+/// @brief What one poll_events call did.
+struct EventStats {
+    u32 received = 0; ///< X events read from the connection
+    u32 processed = 0; ///< decoded events handled, the rest were ignored
+    u32 batches = 0; ///< times the ring was handed to the handler, more than one when a burst overflowed it
+    u32 max_depth = 0; ///< most events queued in the ring at once
+    u32 exposes = 0;
+    u32 resizes = 0; ///< resize callbacks, at most one per call however many ConfigureNotify arrived
+    u32 round_trips = 0; ///< requests that waited for the X server, only keymap reloads
+    f64 poll_ms = 0.0; ///< time spent in poll_events
+};
+
+/**
+ *  @brief Hand a full ring to `flush` in the middle of a drain. A key release at its end is held back and
+ *  queued again first, the press of its auto-repeat pair may be the next event and process_events only
+ *  looks ahead within the ring.
+ */
+template<typename Flush>
+void flush_full_ring(EventRing& ring, Flush&& flush) {
+    std::optional<WindowEvent> release;
+    if (ring.back().type == EventType::key_release) { release = ring.pop_back(); }
+    flush();
+    if (release) { ring.push(*release); }
+}
+
+/**
+ *  @brief Drain every pending event: decode each one into `ring`, hand the ring to `process` whenever it
+ *  fills up and once more at the end. `next` returns the next pending event or nullptr, `process`
+ *  pops everything it is given.
+ */
+template<typename Next, typename Process>
+auto pump_events(EventRing& ring, const EventFilter& filter, Next&& next, Process&& process) -> EventStats {
+    EventStats stats;
+    auto flush = [&] {
+        if (ring.empty()) { return; }
+        stats.max_depth = std::max(stats.max_depth, ring.size());
+        stats.processed += ring.size();
+        stats.batches++;
+        process(ring);
+    };
+    while (std::unique_ptr<xcb_generic_event_t, CFreeDeleter> event{next()}) {
+        stats.received++;
+        auto decoded = decode_event(*event, filter);
+        if (!decoded) { continue; }
+        if (ring.full()) { flush_full_ring(ring, flush); }
+        ring.push(*decoded);
+    }
+    flush();
+    return stats;
+}
+
+/// @brief X auto-repeat sends a release and a press with the same time, the key never went up.
+[[nodiscard]] inline auto is_auto_repeat(const WindowEvent& release, const WindowEvent& next) -> bool {
+    return release.type == EventType::key_release && next.type == EventType::key_press
+        && next.detail == release.detail && next.time == release.time;
+}
+
+}
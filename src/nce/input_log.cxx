@@ -0,0 +1,161 @@
+#include <nce/input_log.hxx>
+#include <nce/mapped_file.hxx>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace {
+    constexpr std::array<std::byte, 4> MAGIC = {std::byte{'N'}, std::byte{'C'}, std::byte{'E'}, std::byte{'I'}};
+    constexpr size_t HEADER_SIZE = MAGIC.size() + sizeof(u32) + sizeof(u64);
+    /// @brief Encoded WindowEvent: type, detail, state, time, x, y, width, height.
+    constexpr size_t EVENT_SIZE = 16;
+    constexpr u8 LAST_EVENT_TYPE = static_cast<u8>(window::EventType::close_requested);
+
+    void write_le(std::vector<std::byte>& out, u64 value, size_t bytes) {
+        for (size_t i = 0; i < bytes; i++) { out.push_back(static_cast<std::byte>(value >> (8 * i))); }
+    }
+    void write_varint(std::vector<std::byte>& out, u64 value) {
+        for (; value >= 0x80; value >>= 7) { out.push_back(static_cast<std::byte>(value | 0x80)); }
+        out.push_back(static_cast<std::byte>(value));
+    }
+
+    /// @brief Reads from the front of a log, every read fails once the data runs out.
+    struct Reader {
+        std::span<const std::byte> bytes;
+
+        auto le(size_t size) -> std::optional<u64> {
+            if (bytes.size() < size) { return std::nullopt; }
+            u64 value = 0;
+            for (size_t i = 0; i < size; i++) { value |= static_cast<u64>(bytes[i]) << (8 * i); }
+            bytes = bytes.subspan(size);
+            return value;
+        }
+        auto varint() -> std::optional<u64> {
+            u64 value = 0;
+            for (u32 shift = 0; shift < 64; shift += 7) {
+                if (bytes.empty()) { return std::nullopt; }
+                u64 byte = static_cast<u64>(bytes.front());
+                bytes = bytes.subspan(1);
+                value |= (byte & 0x7f) << shift;
+                if (!(byte & 0x80)) { return value; }
+            }
+            return std::nullopt;
+        }
+    };
+}
+
+namespace window {
+    auto encode_input_log(std::span<const RecordedEvent> events) -> std::vector<std::byte> {
+        std::vector<std::byte> out;
+        out.reserve(HEADER_SIZE + events.size() * (EVENT_SIZE + 4));
+        out.insert(out.end(), MAGIC.begin(), MAGIC.end());
+        write_le(out, INPUT_LOG_VERSION, sizeof(u32));
+        write_le(out, events.size(), sizeof(u64));
+        u64 frame = 0;
+        i64 offset = 0;
+        for (const RecordedEvent& recorded : events) {
+            write_varint(out, recorded.frame - frame);
+            write_varint(out, static_cast<u64>(recorded.offset_ns - offset));
+            frame = recorded.frame;
+            offset = recorded.offset_ns;
+            const WindowEvent& event = recorded.event;
+            write_le(out, static_cast<u8>(event.type), 1);
+            write_le(out, event.detail, 1);
+            write_le(out, event.state, 2);
+            write_le(out, event.time, 4);
+            write_le(out, static_cast<u16>(event.x), 2);
+            write_le(out, static_cast<u16>(event.y), 2);
+            write_le(out, event.width, 2);
+            write_le(out, event.height, 2);
+            write_varint(out, recorded.keysym);
+        }
+        return out;
+    }
+
+    auto decode_input_log(std::span<const std::byte> log) -> std::optional<std::vector<RecordedEvent>> {
+        if (log.size() < HEADER_SIZE || !std::equal(MAGIC.begin(), MAGIC.end(), log.begin())) { return std::nullopt; }
+        Reader reader{log.subspan(MAGIC.size())};
+        if (reader.le(sizeof(u32)) != INPUT_LOG_VERSION) { return std::nullopt; }
+        u64 count = *reader.le(sizeof(u64));
+        // every record takes at least EVENT_SIZE + 3 bytes, a corrupt count must not reserve gigabytes
+        if (count > reader.bytes.size() / (EVENT_SIZE + 3)) { return std::nullopt; }
+
+        std::vector<RecordedEvent> events;
+        events.reserve(count);
+        u64 frame = 0;
+        i64 offset = 0;
+        for (u64 i = 0; i < count; i++) {
+            auto frame_delta = reader.varint();
+            auto offset_delta = reader.varint();
+            if (!frame_delta || !offset_delta || reader.bytes.size() < EVENT_SIZE) { return std::nullopt; }
+            u8 type = static_cast<u8>(*reader.le(1));
+            if (type > LAST_EVENT_TYPE) { return std::nullopt; }
+            RecordedEvent recorded;
+            frame += *frame_delta;
+            offset += static_cast<i64>(*offset_delta);
+            recorded.frame = frame;
+            recorded.offset_ns = offset;
+            recorded.event.type = static_cast<EventType>(type);
+            recorded.event.detail = static_cast<u8>(*reader.le(1));
+            recorded.event.state = static_cast<u16>(*reader.le(2));
+            recorded.event.time = static_cast<u32>(*reader.le(4));
+            recorded.event.x = static_cast<i16>(*reader.le(2));
+            recorded.event.y = static_cast<i16>(*reader.le(2));
+            recorded.event.width = static_cast<u16>(*reader.le(2));
+            recorded.event.height = static_cast<u16>(*reader.le(2));
+            auto keysym = reader.varint();
+            if (!keysym || *keysym > std::numeric_limits<u32>::max()) { return std::nullopt; }
+            recorded.keysym = static_cast<u32>(*keysym);
+            events.push_back(recorded);
+        }
+        if (!reader.bytes.empty()) { return std::nullopt; }
+        return events;
+    }
+
+    InputRecorder::InputRecorder(i64 start_ns) : start_ns(start_ns) {}
+
+    void InputRecorder::record(u64 frame, i64 now_ns, const WindowEvent& event, u32 keysym) {
+        // the encoder stores deltas, a clock that stepped back is clamped rather than wrapped
+        i64 offset = now_ns - start_ns;
+        if (!recorded.empty()) {
+            offset = std::max(offset, recorded.back().offset_ns);
+            frame = std::max(frame, recorded.back().frame);
+        }
+        recorded.push_back(RecordedEvent{frame, std::max<i64>(offset, 0), event, keysym});
+    }
+
+    auto InputRecorder::write(const std::filesystem::path& path) const -> bool {
+        std::vector<std::byte> log = encode();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(log.data()), static_cast<std::streamsize>(log.size()));
+        return static_cast<bool>(out);
+    }
+
+    InputReplay::InputReplay(std::vector<RecordedEvent> events, ReplaySpeed speed)
+        : events(std::move(events)), speed(speed), frame(this->events.empty() ? 0 : this->events.front().frame) {}
+
+    auto InputReplay::open(const std::filesystem::path& path, ReplaySpeed speed) -> std::optional<InputReplay> {
+        auto file = vke::MappedFile::open(path);
+        if (!file) { return std::nullopt; }
+        auto events = decode_input_log(file->bytes());
+        if (!events) { return std::nullopt; }
+        return InputReplay(std::move(*events), speed);
+    }
+
+    auto InputReplay::next_frame(i64 now_ns) -> std::span<const RecordedEvent> {
+        size_t first = next;
+        if (speed == ReplaySpeed::fast) {
+            // frames that handled no events are replayed as empty frames
+            while (next < events.size() && events[next].frame == frame) { next++; }
+            frame++;
+        } else {
+            if (!start_ns) { start_ns = now_ns; }
+            i64 elapsed = now_ns - *start_ns;
+            while (next < events.size() && events[next].offset_ns <= elapsed) { next++; }
+        }
+        return std::span(events).subspan(first, next - first);
+    }
+}
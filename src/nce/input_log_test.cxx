@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/input_log.hxx>
+
+#include <filesystem>
+#include <fmt/format.h>
+#include <unistd.h>
+#include <vector>
+
+
+namespace {
+    using window::EventType;
+    using window::RecordedEvent;
+
+    constexpr u32 KEY_W = 0x77;
+    constexpr u32 KEY_ESCAPE = 0xff1b;
+
+    auto key(u64 frame, i64 offset_ns, EventType type, u8 keycode, u32 keysym) -> RecordedEvent {
+        return {frame, offset_ns, {type, keycode, 0, static_cast<u32>(offset_ns / 1'000'000)}, keysym};
+    }
+    auto motion(u64 frame, i64 offset_ns, i16 x, i16 y) -> RecordedEvent {
+        return {frame, offset_ns, {EventType::motion, 0, 0x100, static_cast<u32>(offset_ns / 1'000'000), x, y}, 0};
+    }
+
+    // a short session: move, a click with the left button, W held over two frames, a resize, escape
+    const std::vector<RecordedEvent> SESSION = {
+        motion(0, 1'200'000, 10, 20), motion(0, 5'000'000, -4, 7'000),
+        {0, 5'100'000, {EventType::button_press, 1, 0, 5, -4, 7'000}, 0},
+        key(1, 17'000'000, EventType::key_press, 25, KEY_W),
+        {1, 18'000'000, {EventType::button_release, 1, 0x100, 18, -4, 7'000}, 0},
+        key(3, 51'000'000, EventType::key_release, 25, KEY_W),
+        {3, 52'000'000, {EventType::configure, 0, 0, 0, 100, 50, 1920, 1080}, 0},
+        key(6, 100'000'000, EventType::key_press, 9, KEY_ESCAPE),
+    };
+
+    auto same(const RecordedEvent& a, const RecordedEvent& b) -> bool {
+        return a.frame == b.frame && a.offset_ns == b.offset_ns && a.keysym == b.keysym
+            && a.event.type == b.event.type && a.event.detail == b.event.detail && a.event.state == b.event.state
+            && a.event.time == b.event.time && a.event.x == b.event.x && a.event.y == b.event.y
+            && a.event.width == b.event.width && a.event.height == b.event.height;
+    }
+}
+
+TEST_CASE( "An input log round-trips every field", "[input_log]" ) {
+    auto log = window::encode_input_log(SESSION);
+    auto decoded = window::decode_input_log(log);
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->size() == SESSION.size());
+    for (size_t i = 0; i < SESSION.size(); i++) {
+        CHECK(same((*decoded)[i], SESSION[i]));
+    }
+    // deltas keep records well under the size of the struct
+    CHECK(log.size() < 16 + SESSION.size() * 24);
+
+    CHECK(window::decode_input_log(window::encode_input_log({}))->empty());
+}
+
+TEST_CASE( "Logs of another version or cut short are rejected", "[input_log]" ) {
+    auto log = window::encode_input_log(SESSION);
+
+    auto other_version = log;
+    other_version[4] = std::byte{window::INPUT_LOG_VERSION + 1};
+    CHECK_FALSE(window::decode_input_log(other_version).has_value());
+
+    auto bad_magic = log;
+    bad_magic[0] = std::byte{'X'};
+    CHECK_FALSE(window::decode_input_log(bad_magic).has_value());
+
+    for (size_t size = 0; size < log.size(); size++) {
+        CHECK_FALSE(window::decode_input_log(std::span(log).first(size)).has_value());
+    }
+
+    auto trailing = log;
+    trailing.push_back(std::byte{0});
+    CHECK_FALSE(window::decode_input_log(trailing).has_value());
+
+    // the first record's type follows the header, a one byte frame delta and a three byte offset
+    auto bad_type = log;
+    bad_type[16 + 1 + 3] = std::byte{0xff};
+    CHECK_FALSE(window::decode_input_log(bad_type).has_value());
+    bad_type[16 + 1 + 3] = std::byte{static_cast<u8>(EventType::motion)};
+    CHECK(window::decode_input_log(bad_type).has_value());
+}
+
+TEST_CASE( "The recorder keeps offsets and frames from going backwards", "[input_log]" ) {
+    window::InputRecorder recorder(1'000);
+    recorder.record(0, 2'000, {EventType::motion}, 0);
+    recorder.record(1, 1'500, {EventType::motion}, 0);
+    recorder.record(0, 3'000, {EventType::key_press, 38}, 0x61);
+    auto events = recorder.events();
+    REQUIRE(events.size() == 3);
+    CHECK(events[0].offset_ns == 1'000);
+    CHECK(events[1].offset_ns == 1'000);
+    CHECK(events[2].offset_ns == 2'000);
+    CHECK(events[2].frame == 1);
+    CHECK(events[2].keysym == 0x61);
+
+    auto path = std::filesystem::temp_directory_path() / fmt::format("nce_{}_input.log", getpid());
+    REQUIRE(recorder.write(path));
+    auto replay = window::InputReplay::open(path, window::ReplaySpeed::fast);
+    std::filesystem::remove(path);
+    REQUIRE(replay.has_value());
+    CHECK(replay->size() == 3);
+    CHECK(replay->recorded_frames() == 2);
+}
+
+TEST_CASE( "A fast replay hands out one recorded frame per call", "[input_log]" ) {
+    window::InputReplay replay(SESSION, window::ReplaySpeed::fast);
+    CHECK(replay.recorded_frames() == 7);
+    std::vector<size_t> sizes;
+    while (!replay.finished()) {
+        // the clock does not matter, a frame that took a second still gets only its own events
+        sizes.push_back(replay.next_frame(static_cast<i64>(sizes.size()) * 1'000'000'000).size());
+    }
+    CHECK(sizes == std::vector<size_t>{3, 2, 0, 2, 0, 0, 1});
+    CHECK(replay.next_frame(0).empty());
+}
+
+TEST_CASE( "A realtime replay hands out what is due", "[input_log]" ) {
+    window::InputReplay replay(SESSION, window::ReplaySpeed::realtime);
+    constexpr i64 start = 7'000'000'000;
+    CHECK(replay.next_frame(start).empty());
+    CHECK(replay.next_frame(start + 5'000'000).size() == 2);
+    CHECK(replay.next_frame(start + 5'000'000).empty());
+    // a long frame catches up on everything it missed
+    auto late = replay.next_frame(start + 60'000'000);
+    REQUIRE(late.size() == 5);
+    CHECK(late.front().event.type == EventType::button_press);
+    CHECK(late.back().event.type == EventType::configure);
+    CHECK_FALSE(replay.finished());
+    CHECK(replay.next_frame(start + 100'000'000).size() == 1);
+    CHECK(replay.finished());
+}
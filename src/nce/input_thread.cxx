@@ -0,0 +1,76 @@
+#include <nce/input_thread.hxx>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fmt/format.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace window {
+    InputThread::InputThread(xcb_connection_t* connection, const EventFilter& filter)
+        : connection(connection), filter(filter), wake_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)), ready(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+        if (wake_fd < 0 || ready < 0) { fmt::println("input thread: eventfd failed: {}", std::strerror(errno)); std::abort(); }
+        thread = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+
+    InputThread::~InputThread() {
+        thread.request_stop();
+        wake();
+        thread.join();
+        close(wake_fd);
+        close(ready);
+    }
+
+    void InputThread::wake() {
+        u64 one = 1;
+        [[maybe_unused]] auto written = write(wake_fd, &one, sizeof(one));
+    }
+
+    void InputThread::acknowledge() {
+        u64 count = 0;
+        [[maybe_unused]] auto read_bytes = read(ready, &count, sizeof(count));
+    }
+
+    void InputThread::read_pending() {
+        bool queued = false;
+        while (std::unique_ptr<xcb_generic_event_t, CFreeDeleter> event{xcb_poll_for_event(connection)}) {
+            i64 arrival = input_clock_ns();
+            auto decoded = decode_event(*event, filter);
+            if (!decoded) { continue; }
+            if (!events.try_push(TimedEvent{*decoded, arrival})) {
+                dropped_events.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            queued = true;
+        }
+        if (queued) {
+            u64 one = 1;
+            [[maybe_unused]] auto written = write(ready, &one, sizeof(one));
+        }
+    }
+
+    void InputThread::run(std::stop_token stop) {
+        std::array<pollfd, 2> fds = {
+            pollfd{xcb_get_file_descriptor(connection), POLLIN, 0},
+            pollfd{wake_fd, POLLIN, 0},
+        };
+        while (!stop.stop_requested()) {
+            read_pending();
+            if (xcb_connection_has_error(connection)) {
+                fmt::println("input thread: the X connection failed, stopping");
+                return;
+            }
+            // no timeout, events that replies pulled into xcb's queue come with a wake()
+            if (poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR) {
+                fmt::println("input thread: poll failed: {}", std::strerror(errno));
+                return;
+            }
+            if (fds[1].revents & POLLIN) {
+                u64 count = 0;
+                [[maybe_unused]] auto read_bytes = read(wake_fd, &count, sizeof(count));
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/input_thread.hxx>
+
+#include <vector>
+
+
+namespace {
+    auto key_event(u32 sequence) -> window::TimedEvent {
+        return window::TimedEvent{window::WindowEvent{window::EventType::key_press, 38, 0, sequence}, window::input_clock_ns()};
+    }
+}
+
+TEST_CASE( "Draining the input queue batches events through the ring", "[input_thread]" ) {
+    window::InputQueue queue;
+    window::EventRing ring;
+    window::InputLatency latency;
+    constexpr u32 COUNT = 3000;
+    for (u32 i = 0; i < COUNT; i++) {
+        REQUIRE(queue.try_push(key_event(i)));
+    }
+
+    std::vector<u32> seen;
+    auto stats = window::drain_input(queue, ring, latency, [&](window::EventRing& batch) {
+            while (!batch.empty()) { seen.push_back(batch.pop().time); }
+            });
+    REQUIRE(stats.received == COUNT);
+    REQUIRE(stats.processed == COUNT);
+    REQUIRE(stats.batches == (COUNT + window::EventRing::CAPACITY - 1) / window::EventRing::CAPACITY);
+    REQUIRE(stats.max_depth == window::EventRing::CAPACITY);
+    REQUIRE(seen.size() == COUNT);
+    for (u32 i = 0; i < COUNT; i++) {
+        REQUIRE(seen[i] == i);
+    }
+    REQUIRE(latency.events == COUNT);
+    REQUIRE(latency.max_ms >= latency.mean_ms());
+    REQUIRE(latency.mean_ms() >= 0.0);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE( "Frames consume events while another thread produces them", "[input_thread]" ) {
+    constexpr u32 COUNT = 200'000;
+    window::InputQueue queue;
+    window::EventRing ring;
+    window::InputLatency latency;
+    u32 expected = 0;
+    {
+        std::jthread producer([&] {
+            for (u32 i = 0; i < COUNT; i++) {
+                while (!queue.try_push(key_event(i))) { std::this_thread::yield(); }
+            }
+        });
+        while (expected < COUNT) {
+            auto stats = window::drain_input(queue, ring, latency, [&](window::EventRing& batch) {
+                    while (!batch.empty()) {
+                        REQUIRE(batch.pop().time == expected);
+                        expected++;
+                    }
+                    });
+            REQUIRE(stats.processed == stats.received);
+            std::this_thread::yield();
+        }
+    }
+    REQUIRE(latency.events == COUNT);
+    REQUIRE(queue.empty());
+}
@@ -0,0 +1,31 @@
+#include <nce/key_map.hxx>
+
+namespace nce {
+    void KeyMap::press(u32 keysym) {
+        u32 slot = key_slot(keysym);
+        pressed_this_frame[slot] = pressed_this_frame[slot] | !down[slot];
+        down[slot] = true;
+    }
+
+    void KeyMap::release(u32 keysym) {
+        u32 slot = key_slot(keysym);
+        tapped[slot] = tapped[slot] | pressed_this_frame[slot];
+        down[slot] = false;
+    }
+
+    void KeyMap::invalidate() {
+        down.reset();
+        pressed_this_frame.reset();
+        tapped.reset();
+    }
+
+    void KeyMap::end_frame() {
+        KeySnapshot& next = snapshots[front ^ 1];
+        next.previous = snapshots[front].current;
+        next.current = down;
+        next.tapped = tapped;
+        front ^= 1;
+        pressed_this_frame.reset();
+        tapped.reset();
+    }
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <nce/key_map.hxx>
+
+#include <unordered_map>
+
+/**
+ *  The dozen key queries main runs every frame, against the unordered_map KeyMap they replace
+ *  (find then operator[], a press consumed by writing to the map). Not registered with ctest.
+ */
+
+namespace {
+    constexpr std::array FRAME_QUERIES = {
+        nce::KeyCode::space, nce::KeyCode::q, nce::KeyCode::a, nce::KeyCode::A, nce::KeyCode::s, nce::KeyCode::d,
+        nce::KeyCode::f, nce::KeyCode::w, nce::KeyCode::Control_L, nce::KeyCode::c, nce::KeyCode::Alt_L, nce::KeyCode::Shift_L,
+    };
+
+    struct HashedKeyMap {
+        struct KeyState {
+            bool prev = false;
+            bool curr = false;
+            bool key_down = false;
+        };
+        std::unordered_map<nce::KeyCode, KeyState> keys;
+
+        auto is_pressed(nce::KeyCode code) -> bool {
+            if (keys.find(code) == keys.end()) { return false; }
+            auto& state = keys[code];
+            bool pressed = state.curr && !state.prev;
+            if (pressed) { state.prev = state.curr; state.curr = false; }
+            return pressed;
+        }
+        auto is_down(nce::KeyCode code) -> bool {
+            if (keys.find(code) == keys.end()) { return false; }
+            return keys[code].key_down;
+        }
+    };
+}
+
+TEST_CASE( "Key queries per frame", "[!benchmark][key_map]" ) {
+    nce::KeyMap flat;
+    HashedKeyMap hashed;
+    // a typical frame: a few keys down, a few dozen seen since startup
+    for (u32 keysym = 0x20; keysym < 0x7f; keysym += 3) {
+        flat.press(keysym);
+        hashed.keys[static_cast<nce::KeyCode>(keysym)] = {false, true, true};
+    }
+    for (u32 keysym = 0x20; keysym < 0x7f; keysym += 6) { flat.release(keysym); }
+    flat.end_frame();
+
+    BENCHMARK("flat snapshot, 12 queries") {
+        u32 hits = 0;
+        for (auto code : FRAME_QUERIES) {
+            hits += flat.is_pressed(code) ? 1u : 0u;
+            hits += flat.is_down(code) ? 1u : 0u;
+        }
+        return hits;
+    };
+    BENCHMARK("unordered_map, 12 queries") {
+        u32 hits = 0;
+        for (auto code : FRAME_QUERIES) {
+            hits += hashed.is_pressed(code) ? 1u : 0u;
+            hits += hashed.is_down(code) ? 1u : 0u;
+        }
+        return hits;
+    };
+    BENCHMARK("publish a snapshot") {
+        flat.press(0x61);
+        flat.end_frame();
+        return flat.snapshot().current.count();
+    };
+}
@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/key_map.hxx>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace {
+    constexpr auto keysym(nce::KeyCode code) -> u32 { return static_cast<u32>(code); }
+}
+
+TEST_CASE( "Every named keysym has its own slot", "[key_map]" ) {
+    std::vector<std::pair<u32, u32>> slots; // slot, keysym
+    for (nce::KeyCode code : nce::KEY_CODES) {
+        u32 slot = nce::key_slot(code);
+        REQUIRE(slot < nce::KEY_SLOTS);
+        REQUIRE((slot != 0 || code == nce::KeyCode::NoSymbol));
+        slots.emplace_back(slot, keysym(code));
+    }
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end()); // aliases
+    for (size_t i = 1; i < slots.size(); i++) {
+        REQUIRE(slots[i - 1].first != slots[i].first);
+    }
+
+    static_assert(nce::key_slot(nce::KeyCode::a) == 0x61);
+    static_assert(nce::key_slot(nce::KeyCode::Escape) == 0x100 + 0x1b);
+    static_assert(nce::key_slot(nce::KeyCode::ygrave) >= nce::KEY_DENSE_SLOTS);
+    // keysyms keycode.hxx does not name fall into the NoSymbol slot
+    REQUIRE(nce::key_slot(0x1002000u) == 0);
+    REQUIRE(nce::key_slot(0x7fffu) == 0);
+}
+
+TEST_CASE( "Pressed, released and held follow frame edges", "[key_map]" ) {
+    nce::KeyMap keys;
+    keys.end_frame();
+    REQUIRE_FALSE(keys.is_down(nce::KeyCode::w));
+
+    keys.press(keysym(nce::KeyCode::w));
+    keys.end_frame();
+    REQUIRE(keys.is_down(nce::KeyCode::w));
+    REQUIRE(keys.is_pressed(nce::KeyCode::w));
+    REQUIRE(keys.is_pressed(nce::KeyCode::w)); // asking again does not consume it
+    REQUIRE_FALSE(keys.is_held(nce::KeyCode::w));
+    REQUIRE_FALSE(keys.is_pressed(nce::KeyCode::W));
+
+    // auto-repeat reaches the map as another press of a key that is down
+    keys.press(keysym(nce::KeyCode::w));
+    keys.end_frame();
+    REQUIRE(keys.is_held(nce::KeyCode::w));
+    REQUIRE_FALSE(keys.is_pressed(nce::KeyCode::w));
+
+    keys.release(keysym(nce::KeyCode::w));
+    keys.end_frame();
+    REQUIRE(keys.is_released(nce::KeyCode::w));
+    REQUIRE_FALSE(keys.is_down(nce::KeyCode::w));
+
+    keys.end_frame();
+    REQUIRE_FALSE(keys.is_released(nce::KeyCode::w));
+}
+
+TEST_CASE( "A tap within one frame is both pressed and released", "[key_map]" ) {
+    nce::KeyMap keys;
+    keys.press(keysym(nce::KeyCode::space));
+    keys.release(keysym(nce::KeyCode::space));
+    keys.press(keysym(nce::KeyCode::ygrave));
+    keys.release(keysym(nce::KeyCode::ygrave));
+    keys.end_frame();
+    for (auto code : { nce::KeyCode::space, nce::KeyCode::ygrave }) {
+        REQUIRE(keys.is_pressed(code));
+        REQUIRE(keys.is_released(code));
+        REQUIRE_FALSE(keys.is_down(code));
+    }
+    keys.end_frame();
+    REQUIRE_FALSE(keys.is_pressed(nce::KeyCode::space));
+}
+
+TEST_CASE( "Snapshots stay unchanged until published over twice", "[key_map]" ) {
+    nce::KeyMap keys;
+    keys.press(keysym(nce::KeyCode::Control_L));
+    keys.end_frame();
+    const nce::KeySnapshot& frame = keys.snapshot();
+
+    keys.release(keysym(nce::KeyCode::Control_L));
+    keys.press(keysym(nce::KeyCode::c));
+    REQUIRE(frame.is_pressed(nce::KeyCode::Control_L));
+    REQUIRE_FALSE(frame.is_down(nce::KeyCode::c));
+
+    keys.end_frame();
+    REQUIRE(frame.is_down(nce::KeyCode::Control_L));
+    REQUIRE(keys.is_pressed(nce::KeyCode::c));
+    REQUIRE(keys.is_released(nce::KeyCode::Control_L));
+
+    keys.invalidate();
+    keys.end_frame();
+    REQUIRE(keys.is_released(nce::KeyCode::c));
+    REQUIRE_FALSE(keys.is_down(nce::KeyCode::Control_L));
+}
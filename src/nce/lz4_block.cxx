@@ -0,0 +1,133 @@
+#include <nce/lz4_block.hxx>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t LAST_LITERALS = 5; ///< a block always ends with at least this many literals
+    constexpr size_t MATCH_START_LIMIT = 12; ///< the last match starts at least this far from the end
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr u32 HASH_BITS = 16;
+    /// @brief Short literal runs and matches are copied with one fixed size copy when both sides have the room,
+    /// the bytes past their end are overwritten by the next sequence.
+    constexpr size_t WILD_COPY = 16;
+
+    auto read_u32(const std::byte* bytes) -> u32 {
+        u32 value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    auto hash(u32 sequence) -> u32 {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    /// @brief 15 in the token nibble, then bytes of 255 until the remainder.
+    void write_length(std::vector<std::byte>& out, size_t length) {
+        for (; length >= 255; length -= 255) { out.push_back(std::byte{255}); }
+        out.push_back(static_cast<std::byte>(length));
+    }
+
+    void write_sequence(std::vector<std::byte>& out, std::span<const std::byte> literals, size_t offset, size_t match_length) {
+        size_t literal_nibble = std::min<size_t>(literals.size(), 15);
+        size_t match_nibble = match_length == 0 ? 0 : std::min<size_t>(match_length - MIN_MATCH, 15);
+        out.push_back(static_cast<std::byte>(literal_nibble << 4 | match_nibble));
+        if (literal_nibble == 15) { write_length(out, literals.size() - 15); }
+        out.insert(out.end(), literals.begin(), literals.end());
+        if (match_length == 0) { return; }
+        out.push_back(static_cast<std::byte>(offset & 0xff));
+        out.push_back(static_cast<std::byte>(offset >> 8));
+        if (match_nibble == 15) { write_length(out, match_length - MIN_MATCH - 15); }
+    }
+
+    /// @brief Add the 255-continued extension of a nibble that was 15, false when it runs past the input.
+    auto read_length(std::span<const std::byte> source, size_t& in, size_t& length) -> bool {
+        u8 byte = 255;
+        while (byte == 255) {
+            if (in >= source.size()) { return false; }
+            byte = static_cast<u8>(source[in++]);
+            length += byte;
+        }
+        return true;
+    }
+}
+
+namespace vke {
+    auto lz4_compress(std::span<const std::byte> source) -> std::vector<std::byte> {
+        std::vector<std::byte> out;
+        out.reserve(source.size() + source.size() / 255 + 16);
+        size_t anchor = 0;
+        if (source.size() > MATCH_START_LIMIT) {
+            // position + 1 of the last sequence with this hash, 0 is empty
+            std::vector<u32> table(size_t{1} << HASH_BITS, 0);
+            size_t match_end_limit = source.size() - LAST_LITERALS;
+            size_t position = 0;
+            while (position + MATCH_START_LIMIT <= source.size()) {
+                u32 sequence = read_u32(source.data() + position);
+                u32& slot = table[hash(sequence)];
+                size_t candidate = slot;
+                slot = static_cast<u32>(position + 1);
+                if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read_u32(source.data() + candidate - 1) != sequence) {
+                    position++;
+                    continue;
+                }
+                candidate--;
+                size_t length = MIN_MATCH;
+                while (position + length < match_end_limit && source[candidate + length] == source[position + length]) {
+                    length++;
+                }
+                write_sequence(out, source.subspan(anchor, position - anchor), position - candidate, length);
+                position += length;
+                anchor = position;
+            }
+        }
+        write_sequence(out, source.subspan(anchor), 0, 0);
+        return out;
+    }
+
+    auto lz4_decompress(std::span<const std::byte> source, std::span<std::byte> destination) -> bool {
+        size_t in = 0;
+        size_t out = 0;
+        while (in < source.size()) {
+            u8 token = static_cast<u8>(source[in++]);
+            size_t literals = token >> 4;
+            if (literals == 15 && !read_length(source, in, literals)) { return false; }
+            if (literals > source.size() - in || literals > destination.size() - out) { return false; }
+            if (literals <= WILD_COPY && source.size() - in >= WILD_COPY && destination.size() - out >= WILD_COPY) {
+                std::memcpy(destination.data() + out, source.data() + in, WILD_COPY);
+            } else {
+                std::copy_n(source.data() + in, literals, destination.data() + out);
+            }
+            in += literals;
+            out += literals;
+            // the last sequence has no match
+            if (in == source.size()) { break; }
+
+            if (source.size() - in < 2) { return false; }
+            size_t offset = static_cast<size_t>(source[in]) | static_cast<size_t>(source[in + 1]) << 8;
+            in += 2;
+            if (offset == 0 || offset > out) { return false; }
+            size_t length = token & 0xfu;
+            if (length == 15 && !read_length(source, in, length)) { return false; }
+            length += MIN_MATCH;
+            if (length > destination.size() - out) { return false; }
+            if (offset >= WILD_COPY && length <= WILD_COPY && destination.size() - out >= WILD_COPY) {
+                std::memcpy(destination.data() + out, destination.data() + out - offset, WILD_COPY);
+                out += length;
+                continue;
+            }
+            // A match may overlap the bytes it produces. Everything from offset bytes before the match repeats
+            // with period offset, so copy chunks no longer than their distance and double the distance each time.
+            size_t distance = offset;
+            while (length > 0) {
+                size_t chunk = std::min(distance, length);
+                std::memcpy(destination.data() + out, destination.data() + out - distance, chunk);
+                out += chunk;
+                length -= chunk;
+                distance *= 2;
+            }
+        }
+        return out == destination.size();
+    }
+}
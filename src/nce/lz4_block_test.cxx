@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/lz4_block.hxx>
+
+#include <random>
+
+
+namespace {
+    auto bytes_of(std::string_view text) -> std::vector<std::byte> {
+        const auto* data = reinterpret_cast<const std::byte*>(text.data());
+        return std::vector<std::byte>(data, data + text.size());
+    }
+
+    auto round_trip(const std::vector<std::byte>& source) -> std::vector<std::byte> {
+        auto compressed = vke::lz4_compress(source);
+        std::vector<std::byte> decompressed(source.size());
+        REQUIRE(vke::lz4_decompress(compressed, decompressed));
+        return decompressed;
+    }
+}
+
+TEST_CASE( "Blocks round trip", "[lz4]" ) {
+    REQUIRE(round_trip({}).empty());
+    auto tiny = bytes_of("hello");
+    REQUIRE(round_trip(tiny) == tiny);
+
+    std::string obj;
+    for (u32 i = 0; i < 2000; i++) { obj += fmt::format("v {} 0.5 {}\nvt 0.25 0.75\n", i % 17, i % 5); }
+    auto text = bytes_of(obj);
+    REQUIRE(vke::lz4_compress(text).size() < text.size() / 2);
+    REQUIRE(round_trip(text) == text);
+
+    // long literal runs and long matches both need length extension bytes
+    std::mt19937 rng(7);
+    std::vector<std::byte> mixed(300000);
+    for (size_t i = 0; i < mixed.size(); i++) {
+        bool noise = (i / 4096) % 2 == 0;
+        mixed[i] = static_cast<std::byte>(noise ? rng() : i % 3);
+    }
+    REQUIRE(round_trip(mixed) == mixed);
+}
+
+TEST_CASE( "Blocks written by other LZ4 encoders decode", "[lz4]" ) {
+    // "abc", then a match of 20 at offset 3 that overlaps its own output, then the last 5 literals
+    std::vector<u8> block = { 0x3f, 'a', 'b', 'c', 0x03, 0x00, 0x01, 0x50, 'a', 'b', 'c', 'a', 'b' };
+    std::vector<std::byte> decompressed(28);
+    REQUIRE(vke::lz4_decompress(std::as_bytes(std::span(block)), decompressed));
+    REQUIRE(decompressed == bytes_of("abcabcabcabcabcabcabcababcab"));
+}
+
+TEST_CASE( "Malformed blocks are rejected", "[lz4]" ) {
+    auto source = bytes_of("the quick brown fox jumps over the quick brown fox jumps over the lazy dog");
+    auto compressed = vke::lz4_compress(source);
+    std::vector<std::byte> decompressed(source.size());
+
+    SECTION( "truncated" ) {
+        auto truncated = std::span(compressed).first(compressed.size() - 3);
+        REQUIRE_FALSE(vke::lz4_decompress(truncated, decompressed));
+    }
+    SECTION( "wrong size" ) {
+        std::vector<std::byte> small(source.size() - 1);
+        REQUIRE_FALSE(vke::lz4_decompress(compressed, small));
+    }
+    SECTION( "offset before the start" ) {
+        std::vector<u8> block = { 0x10, 'a', 0x05, 0x00, 0x50, 'a', 'b', 'c', 'd', 'e' };
+        REQUIRE_FALSE(vke::lz4_decompress(std::as_bytes(std::span(block)), decompressed));
+    }
+}
@@ -0,0 +1,84 @@
+#include <nce/mapped_file.hxx>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+    /// @brief Closes the descriptor on every return path, a mapping stays valid after close.
+    struct FileDescriptor {
+        int fd;
+        ~FileDescriptor() { if (fd >= 0) { close(fd); } }
+    };
+
+    auto stream_all(int fd, std::vector<std::byte>& buffer) -> bool {
+        constexpr size_t CHUNK_SIZE = 64 * 1024;
+        size_t size = 0;
+        while (true) {
+            buffer.resize(size + CHUNK_SIZE);
+            ssize_t count = read(fd, buffer.data() + size, CHUNK_SIZE);
+            if (count < 0 && errno == EINTR) { continue; }
+            if (count < 0) { return false; }
+            if (count == 0) { break; }
+            size += static_cast<size_t>(count);
+        }
+        buffer.resize(size);
+        return true;
+    }
+}
+
+namespace vke {
+    auto MappedFile::open(const std::filesystem::path& path) -> std::optional<MappedFile> {
+        FileDescriptor file{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (file.fd < 0) { return std::nullopt; }
+        struct stat status{};
+        if (fstat(file.fd, &status) != 0) { return std::nullopt; }
+
+        MappedFile mapped_file;
+        // mmap rejects a length of 0, and procfs reports 0 for files that do have contents: stream those
+        if (S_ISREG(status.st_mode) && status.st_size > 0) {
+            size_t size = static_cast<size_t>(status.st_size);
+            void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+            if (address != MAP_FAILED) {
+                // loaders read front to back exactly once: read ahead aggressively, drop pages behind
+                madvise(address, size, MADV_SEQUENTIAL);
+                madvise(address, size, MADV_WILLNEED);
+                mapped_file.contents = {static_cast<const std::byte*>(address), size};
+                mapped_file.mapped = true;
+                return mapped_file;
+            }
+        }
+        if (!stream_all(file.fd, mapped_file.streamed)) { return std::nullopt; }
+        mapped_file.contents = mapped_file.streamed;
+        return mapped_file;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : contents(std::exchange(other.contents, {})), mapped(std::exchange(other.mapped, false)), streamed(std::move(other.streamed)) {}
+
+    auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+        if (this != &other) {
+            release();
+            contents = std::exchange(other.contents, {});
+            mapped = std::exchange(other.mapped, false);
+            streamed = std::move(other.streamed);
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        release();
+    }
+
+    void MappedFile::release() {
+        if (mapped) {
+            munmap(const_cast<std::byte*>(contents.data()), contents.size());
+        }
+        contents = {};
+        mapped = false;
+        streamed.clear();
+    }
+}
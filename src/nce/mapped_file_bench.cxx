@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <nce/mapped_file.hxx>
+
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/**
+ *  Large file read throughput of the old ifstream path against MappedFile, and the peak RSS each leaves behind.
+ *  Not registered with ctest. ru_maxrss only ever grows, so compare peak RSS by running one case per process:
+ *      ./mapped_file_bench "[ifstream]"
+ *      ./mapped_file_bench "[mapped]"
+ *  The file is read once before measuring, both paths are timed against a warm page cache.
+ */
+
+namespace {
+    constexpr size_t FILE_SIZE = 256ull * 1024 * 1024;
+
+    /// @brief Removes the file with the last case that uses it.
+    struct BenchFile {
+        std::filesystem::path path;
+
+        BenchFile() : path(std::filesystem::temp_directory_path() / fmt::format("nce_{}_bench.bin", getpid())) {
+            std::ofstream file(path, std::ios::binary);
+            std::vector<char> chunk(1024 * 1024);
+            for (size_t i = 0; i < chunk.size(); i++) { chunk[i] = static_cast<char>(i * 31); }
+            for (size_t written = 0; written < FILE_SIZE; written += chunk.size()) {
+                file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            }
+        }
+        ~BenchFile() { std::filesystem::remove(path); }
+    };
+
+    /// @brief What a loader does with the bytes at minimum: look at every one of them.
+    auto checksum(std::span<const std::byte> bytes) -> u64 {
+        u64 sum = 0;
+        for (std::byte b : bytes) { sum += static_cast<u64>(b); }
+        return sum;
+    }
+
+    /// @brief The loading code MappedFile replaced: seek to the end, allocate, copy.
+    auto read_with_ifstream(const std::filesystem::path& path) -> std::vector<std::byte> {
+        std::ifstream file(path, std::ios::ate | std::ios::binary);
+        std::vector<std::byte> buffer(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        return buffer;
+    }
+
+    void print_peak_rss(std::string_view name) {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        fmt::println("{}: peak RSS {:.1f} MiB for a {} MiB file", name, static_cast<f64>(usage.ru_maxrss) / 1024.0, FILE_SIZE >> 20);
+    }
+}
+
+TEST_CASE( "Reading a large file with ifstream", "[!benchmark][ifstream]" ) {
+    BenchFile file;
+    REQUIRE(checksum(read_with_ifstream(file.path)) > 0);
+
+    BENCHMARK("ifstream into a vector") {
+        return checksum(read_with_ifstream(file.path));
+    };
+    print_peak_rss("ifstream");
+}
+
+TEST_CASE( "Reading a large file through a mapping", "[!benchmark][mapped]" ) {
+    BenchFile file;
+    REQUIRE(checksum(vke::MappedFile::open(file.path)->bytes()) > 0);
+
+    BENCHMARK("MappedFile") {
+        auto mapped = vke::MappedFile::open(file.path);
+        return checksum(mapped->bytes());
+    };
+    print_peak_rss("mapped");
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/mapped_file.hxx>
+
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+
+namespace {
+    auto temp_file(std::string_view name, std::string_view contents) -> std::filesystem::path {
+        auto path = std::filesystem::temp_directory_path() / fmt::format("nce_{}_{}", getpid(), name);
+        std::ofstream file(path, std::ios::binary);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        return path;
+    }
+
+    auto as_string(std::span<const std::byte> bytes) -> std::string {
+        return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+}
+
+TEST_CASE( "Regular files are mapped", "[mapped_file]" ) {
+    auto path = temp_file("regular", "#version 450\nvoid main() {}\n");
+    auto file = vke::MappedFile::open(path);
+    std::filesystem::remove(path);
+
+    REQUIRE(file.has_value());
+    REQUIRE(file->is_mapped());
+    REQUIRE(as_string(file->bytes()) == "#version 450\nvoid main() {}\n");
+    // SPIR-V is read as u32 words
+    REQUIRE(reinterpret_cast<uintptr_t>(file->data()) % alignof(u32) == 0);
+}
+
+TEST_CASE( "Moving keeps the view valid", "[mapped_file]" ) {
+    auto path = temp_file("moved", "contents");
+    auto file = vke::MappedFile::open(path);
+    std::filesystem::remove(path);
+    REQUIRE(file.has_value());
+
+    const std::byte* data = file->data();
+    vke::MappedFile moved = std::move(*file);
+    REQUIRE(moved.data() == data);
+    REQUIRE(as_string(moved.bytes()) == "contents");
+    REQUIRE(file->empty());
+}
+
+TEST_CASE( "Empty files open as an empty view", "[mapped_file]" ) {
+    auto path = temp_file("empty", "");
+    auto file = vke::MappedFile::open(path);
+    std::filesystem::remove(path);
+
+    REQUIRE(file.has_value());
+    REQUIRE(file->empty());
+}
+
+TEST_CASE( "Files without a size are streamed", "[mapped_file]" ) {
+    // procfs reports a size of 0 for files that do have contents
+    auto file = vke::MappedFile::open("/proc/self/status");
+
+    REQUIRE(file.has_value());
+    REQUIRE_FALSE(file->is_mapped());
+    REQUIRE(as_string(file->bytes()).starts_with("Name:"));
+}
+
+TEST_CASE( "Pipes are streamed", "[mapped_file]" ) {
+    std::array<int, 2> fds{};
+    REQUIRE(pipe(fds.data()) == 0);
+    std::string contents(200 * 1024, 'x');
+    std::jthread writer([&] {
+        std::string_view remaining = contents;
+        while (!remaining.empty()) {
+            ssize_t count = write(fds[1], remaining.data(), remaining.size());
+            if (count <= 0) { break; }
+            remaining.remove_prefix(static_cast<size_t>(count));
+        }
+        close(fds[1]);
+    });
+    auto file = vke::MappedFile::open(fmt::format("/proc/self/fd/{}", fds[0]));
+    writer.join();
+    close(fds[0]);
+
+    REQUIRE(file.has_value());
+    REQUIRE_FALSE(file->is_mapped());
+    REQUIRE(as_string(file->bytes()) == contents);
+}
+
+TEST_CASE( "Missing files are reported", "[mapped_file]" ) {
+    REQUIRE_FALSE(vke::MappedFile::open("/nonexistent/shader.spv").has_value());
+}
@@ -0,0 +1,107 @@
+#include <nce/memory_budget.hxx>
+
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace vke {
+    auto memory_category_name(MemoryCategory category) -> std::string_view {
+        switch (category) {
+            case MemoryCategory::vertex: return "vertex";
+            case MemoryCategory::index: return "index";
+            case MemoryCategory::texture: return "texture";
+            case MemoryCategory::staging: return "staging";
+            case MemoryCategory::attachment: return "attachment";
+            case MemoryCategory::uniform: return "uniform";
+            case MemoryCategory::storage: return "storage";
+        }
+        return "unknown";
+    }
+
+    void MemoryBudget::update_heaps(std::span<const VkDeviceSize> sizes, std::span<const VkDeviceSize> budgets, std::span<const VkDeviceSize> usage) {
+        std::scoped_lock lock(mutex);
+        stats.heaps.resize(std::max(stats.heaps.size(), sizes.size()));
+        driver_usage.assign(stats.heaps.size(), 0);
+        allocated_at_update.resize(stats.heaps.size());
+        stats.driver_budget = !budgets.empty();
+        for (u32 heap = 0; heap < sizes.size(); heap++) {
+            auto& heap_stats = stats.heaps[heap];
+            heap_stats.size = sizes[heap];
+            heap_stats.budget = budgets.empty() ? sizes[heap] : budgets[heap];
+            driver_usage[heap] = usage.empty() ? 0 : usage[heap];
+            allocated_at_update[heap] = heap_stats.allocated;
+        }
+    }
+
+    void MemoryBudget::on_allocate(const void* memory, u32 heap, MemoryCategory category, VkDeviceSize size) {
+        std::scoped_lock lock(mutex);
+        if (heap >= stats.heaps.size()) {
+            stats.heaps.resize(heap + 1);
+            driver_usage.resize(heap + 1, 0);
+            allocated_at_update.resize(heap + 1, 0);
+        }
+        allocations[memory] = Allocation{heap, category, size};
+        stats.heaps[heap].allocated += size;
+        auto& category_stats = stats.categories[static_cast<u32>(category)];
+        category_stats.bytes += size;
+        category_stats.allocations++;
+    }
+
+    void MemoryBudget::on_free(const void* memory) {
+        std::scoped_lock lock(mutex);
+        auto it = allocations.find(memory);
+        if (it == allocations.end()) { return; }
+        const auto& allocation = it->second;
+        stats.heaps[allocation.heap].allocated -= allocation.size;
+        auto& category_stats = stats.categories[static_cast<u32>(allocation.category)];
+        category_stats.bytes -= allocation.size;
+        category_stats.allocations--;
+        allocations.erase(it);
+    }
+
+    void MemoryBudget::on_failure() {
+        std::scoped_lock lock(mutex);
+        stats.failed_allocations++;
+    }
+
+    auto MemoryBudget::heap_usage(u32 heap) const -> VkDeviceSize {
+        const auto& heap_stats = stats.heaps[heap];
+        if (!stats.driver_budget) { return heap_stats.allocated; }
+        // the driver's number is as old as the last update, add what we allocated (or freed) since
+        i64 since = static_cast<i64>(heap_stats.allocated) - static_cast<i64>(allocated_at_update[heap]);
+        return static_cast<VkDeviceSize>(std::max<i64>(static_cast<i64>(driver_usage[heap]) + since, 0));
+    }
+
+    auto MemoryBudget::excess(u32 heap, VkDeviceSize size) const -> VkDeviceSize {
+        std::scoped_lock lock(mutex);
+        if (heap >= stats.heaps.size() || stats.heaps[heap].budget == 0) { return 0; }
+        auto limit = static_cast<VkDeviceSize>(static_cast<f64>(stats.heaps[heap].budget) * soft_limit);
+        VkDeviceSize needed = heap_usage(heap) + size;
+        return needed > limit ? needed - limit : 0;
+    }
+
+    auto MemoryBudget::snapshot() const -> MemoryStats {
+        std::scoped_lock lock(mutex);
+        MemoryStats copy = stats;
+        for (u32 heap = 0; heap < copy.heaps.size(); heap++) {
+            copy.heaps[heap].usage = heap_usage(heap);
+        }
+        return copy;
+    }
+
+    void print_memory_stats(const MemoryStats& stats) {
+        constexpr f64 MIB = 1024.0 * 1024.0;
+        fmt::println("device memory ({}):", stats.driver_budget ? "VK_EXT_memory_budget" : "own accounting");
+        for (size_t heap = 0; heap < stats.heaps.size(); heap++) {
+            const auto& heap_stats = stats.heaps[heap];
+            fmt::println("  heap {}: {:.1f} / {:.1f} MiB used, {:.1f} MiB by nce, heap size {:.1f} MiB", heap,
+                    static_cast<f64>(heap_stats.usage) / MIB, static_cast<f64>(heap_stats.budget) / MIB,
+                    static_cast<f64>(heap_stats.allocated) / MIB, static_cast<f64>(heap_stats.size) / MIB);
+        }
+        for (u32 category = 0; category < MEMORY_CATEGORY_COUNT; category++) {
+            const auto& category_stats = stats.categories[category];
+            fmt::println("  {:<10} {:>9.1f} MiB in {} allocations", memory_category_name(static_cast<MemoryCategory>(category)),
+                    static_cast<f64>(category_stats.bytes) / MIB, category_stats.allocations);
+        }
+        fmt::println("  {} failed allocations", stats.failed_allocations);
+    }
+}
@@ -0,0 +1,54 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/memory_budget.hxx>
+
+
+namespace {
+    constexpr VkDeviceSize MIB = 1024 * 1024;
+    // distinct fake VkDeviceMemory handles
+    std::array<int, 8> handles{};
+}
+
+TEST_CASE( "Allocations are accounted by heap and category", "[memory_budget]" ) {
+    vke::MemoryBudget budget;
+    std::array<VkDeviceSize, 2> sizes = { 1024 * MIB, 256 * MIB };
+    budget.update_heaps(sizes, {}, {});
+
+    budget.on_allocate(&handles[0], 0, vke::MemoryCategory::vertex, 10 * MIB);
+    budget.on_allocate(&handles[1], 0, vke::MemoryCategory::texture, 20 * MIB);
+    budget.on_allocate(&handles[2], 1, vke::MemoryCategory::staging, 5 * MIB);
+    budget.on_free(&handles[1]);
+    budget.on_free(&handles[7]); // never allocated, ignored
+
+    auto stats = budget.snapshot();
+    REQUIRE_FALSE(stats.driver_budget);
+    REQUIRE(stats.heaps.size() == 2);
+    REQUIRE(stats.heaps[0].allocated == 10 * MIB);
+    REQUIRE(stats.heaps[0].usage == 10 * MIB);
+    REQUIRE(stats.heaps[0].budget == 1024 * MIB);
+    REQUIRE(stats.heaps[1].allocated == 5 * MIB);
+    REQUIRE(stats.categories[static_cast<u32>(vke::MemoryCategory::vertex)].bytes == 10 * MIB);
+    REQUIRE(stats.categories[static_cast<u32>(vke::MemoryCategory::texture)].bytes == 0);
+    REQUIRE(stats.categories[static_cast<u32>(vke::MemoryCategory::texture)].allocations == 0);
+    REQUIRE(stats.categories[static_cast<u32>(vke::MemoryCategory::staging)].allocations == 1);
+}
+
+TEST_CASE( "The driver's usage counts allocations made since it was queried", "[memory_budget]" ) {
+    vke::MemoryBudget budget;
+    std::array<VkDeviceSize, 1> sizes = { 1024 * MIB };
+    std::array<VkDeviceSize, 1> budgets = { 800 * MIB };
+    std::array<VkDeviceSize, 1> usage = { 300 * MIB }; // other processes and driver internals included
+    budget.update_heaps(sizes, budgets, usage);
+
+    budget.on_allocate(&handles[0], 0, vke::MemoryCategory::texture, 100 * MIB);
+    auto stats = budget.snapshot();
+    REQUIRE(stats.driver_budget);
+    REQUIRE(stats.heaps[0].budget == 800 * MIB);
+    REQUIRE(stats.heaps[0].usage == 400 * MIB);
+
+    // soft limit 0.9 * 800 = 720 MiB
+    REQUIRE(budget.excess(0, 320 * MIB) == 0);
+    REQUIRE(budget.excess(0, 330 * MIB) == 10 * MIB);
+
+    budget.on_free(&handles[0]);
+    REQUIRE(budget.snapshot().heaps[0].usage == 300 * MIB);
+}
@@ -0,0 +1,73 @@
+#include <nce/pointer.hxx>
+
+namespace {
+    constexpr u8 SCROLL_UP = 4;
+    constexpr u8 SCROLL_DOWN = 5;
+    constexpr u8 SCROLL_LEFT = 6;
+    constexpr u8 SCROLL_RIGHT = 7;
+}
+
+namespace window {
+    void Pointer::move_to(i16 x, i16 y) {
+        if (has_position) {
+            live.dx += x - live.x;
+            live.dy += y - live.y;
+        }
+        live.x = x;
+        live.y = y;
+        has_position = true;
+    }
+
+    void Pointer::handle(const WindowEvent& event) {
+        switch (event.type) {
+            case EventType::motion:
+                move_to(event.x, event.y);
+                live.motion_events++;
+                if (record_history) { live_history.push_back(PointerSample{event.x, event.y, event.time}); }
+                break;
+            case EventType::button_press: {
+                move_to(event.x, event.y);
+                // the wheel sends a press and a release per click, the press is the click
+                switch (event.detail) {
+                    case SCROLL_UP: live.scroll_y++; return;
+                    case SCROLL_DOWN: live.scroll_y--; return;
+                    case SCROLL_LEFT: live.scroll_x--; return;
+                    case SCROLL_RIGHT: live.scroll_x++; return;
+                }
+                if (event.detail == 0 || event.detail > 32) { return; }
+                u32 bit = 1u << (event.detail - 1);
+                live.buttons_pressed |= bit & ~live.buttons_down;
+                live.buttons_down |= bit;
+                break;
+            }
+            case EventType::button_release: {
+                move_to(event.x, event.y);
+                if ((event.detail >= SCROLL_UP && event.detail <= SCROLL_RIGHT) || event.detail == 0 || event.detail > 32) { return; }
+                u32 bit = 1u << (event.detail - 1);
+                live.buttons_released |= bit & live.buttons_down;
+                live.buttons_down &= ~bit;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void Pointer::invalidate() {
+        live.buttons_released |= live.buttons_down;
+        live.buttons_down = 0;
+    }
+
+    void Pointer::end_frame() {
+        published = live;
+        live.dx = 0;
+        live.dy = 0;
+        live.scroll_x = 0;
+        live.scroll_y = 0;
+        live.buttons_pressed = 0;
+        live.buttons_released = 0;
+        live.motion_events = 0;
+        published_history.swap(live_history);
+        live_history.clear();
+    }
+}
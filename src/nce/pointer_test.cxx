@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/pointer.hxx>
+
+#include <cmath>
+#include <vector>
+
+
+namespace {
+    using window::EventType;
+
+    /// @brief A recorded stream: frames are separated by an event of type focus_in.
+    constexpr window::WindowEvent FRAME_END{EventType::focus_in};
+
+    auto motion(u32 time, i16 x, i16 y) -> window::WindowEvent { return {EventType::motion, 0, 0, time, x, y}; }
+    auto press(u32 time, u8 button, i16 x, i16 y) -> window::WindowEvent { return {EventType::button_press, button, 0, time, x, y}; }
+    auto release(u32 time, u8 button, i16 x, i16 y) -> window::WindowEvent { return {EventType::button_release, button, 0, time, x, y}; }
+
+    /// @brief Replay `stream` frame by frame, returning the published frames.
+    auto replay(window::Pointer& pointer, const std::vector<window::WindowEvent>& stream) -> std::vector<window::PointerFrame> {
+        std::vector<window::PointerFrame> frames;
+        for (const auto& event : stream) {
+            if (event.type == FRAME_END.type) {
+                pointer.end_frame();
+                frames.push_back(pointer.frame());
+                continue;
+            }
+            pointer.handle(event);
+        }
+        return frames;
+    }
+
+    // left-drag orbit from a trackpad: 3 frames, the button goes down mid frame, a wheel click at the end
+    const std::vector<window::WindowEvent> ORBIT_DRAG = {
+        motion(1000, 400, 300), motion(1004, 402, 301), motion(1008, 405, 301),
+        press(1010, 1, 405, 301), motion(1012, 409, 303),
+        FRAME_END,
+        motion(1016, 415, 306), motion(1020, 422, 309), motion(1024, 430, 313), motion(1028, 437, 316),
+        FRAME_END,
+        motion(1032, 441, 318), release(1034, 1, 441, 318), press(1040, 4, 441, 318), release(1040, 4, 441, 318),
+        press(1041, 4, 441, 318), release(1041, 4, 441, 318), press(1045, 6, 441, 318), release(1045, 6, 441, 318),
+        FRAME_END,
+        FRAME_END,
+    };
+}
+
+TEST_CASE( "Motion within a frame is coalesced into one delta", "[pointer]" ) {
+    window::Pointer pointer;
+    auto frames = replay(pointer, ORBIT_DRAG);
+    REQUIRE(frames.size() == 4);
+
+    // the very first event has nothing to move from
+    REQUIRE(frames[0].dx == 9);
+    REQUIRE(frames[0].dy == 3);
+    REQUIRE(frames[0].x == 409);
+    REQUIRE(frames[0].motion_events == 4);
+    REQUIRE(frames[0].is_pressed(window::MouseButton::left));
+    REQUIRE(frames[0].is_down(window::MouseButton::left));
+
+    REQUIRE(frames[1].dx == 28);
+    REQUIRE(frames[1].dy == 13);
+    REQUIRE(frames[1].motion_events == 4);
+    REQUIRE(frames[1].is_down(window::MouseButton::left));
+    REQUIRE_FALSE(frames[1].is_pressed(window::MouseButton::left));
+
+    REQUIRE(frames[2].dx == 4);
+    REQUIRE(frames[2].is_released(window::MouseButton::left));
+    REQUIRE_FALSE(frames[2].is_down(window::MouseButton::left));
+    REQUIRE(frames[2].scroll_y == 2);
+    REQUIRE(frames[2].scroll_x == -1);
+    REQUIRE(frames[2].buttons_down == 0); // wheel clicks never look held
+
+    REQUIRE(frames[3].dx == 0);
+    REQUIRE(frames[3].scroll_y == 0);
+    REQUIRE(frames[3].buttons_released == 0);
+    REQUIRE(frames[3].x == 441);
+    REQUIRE(frames[3].y == 318);
+    REQUIRE(pointer.history().empty());
+}
+
+TEST_CASE( "History keeps every motion event of the frame", "[pointer]" ) {
+    window::Pointer pointer(true);
+    // a 1000 Hz mouse sketching a circle, 16 ms frames
+    std::vector<window::WindowEvent> stream;
+    constexpr u32 SAMPLES = 160;
+    for (u32 i = 0; i < SAMPLES; i++) {
+        f64 angle = static_cast<f64>(i) * 0.05;
+        stream.push_back(motion(i, static_cast<i16>(500.0 + 200.0 * std::cos(angle)), static_cast<i16>(400.0 + 200.0 * std::sin(angle))));
+        if (i % 16 == 15) { stream.push_back(FRAME_END); }
+    }
+
+    i32 total_dx = 0;
+    i32 total_dy = 0;
+    u32 sample = 0;
+    window::WindowEvent last = stream.front();
+    for (const auto& event : stream) {
+        if (event.type != FRAME_END.type) { pointer.handle(event); last = event; continue; }
+        pointer.end_frame();
+        const auto& frame = pointer.frame();
+        REQUIRE(frame.motion_events == 16);
+        REQUIRE(pointer.history().size() == 16);
+        for (const auto& point : pointer.history()) {
+            REQUIRE(point.time == sample);
+            REQUIRE(point.x == stream[sample + sample / 16].x);
+            sample++;
+        }
+        REQUIRE(frame.x == last.x);
+        REQUIRE(frame.y == last.y);
+        total_dx += frame.dx;
+        total_dy += frame.dy;
+    }
+    REQUIRE(total_dx == last.x - stream.front().x);
+    REQUIRE(total_dy == last.y - stream.front().y);
+
+    pointer.end_frame();
+    REQUIRE(pointer.history().empty());
+}
+
+TEST_CASE( "A click shorter than a frame is pressed and released", "[pointer]" ) {
+    window::Pointer pointer;
+    pointer.handle(press(10, 3, 5, 5));
+    pointer.handle(release(14, 3, 5, 5));
+    pointer.handle(press(15, 1, 5, 5));
+    pointer.end_frame();
+    REQUIRE(pointer.frame().is_pressed(window::MouseButton::right));
+    REQUIRE(pointer.frame().is_released(window::MouseButton::right));
+    REQUIRE_FALSE(pointer.frame().is_down(window::MouseButton::right));
+
+    pointer.invalidate();
+    pointer.end_frame();
+    REQUIRE(pointer.frame().is_released(window::MouseButton::left));
+    REQUIRE(pointer.frame().buttons_down == 0);
+}
@@ -0,0 +1,105 @@
+#include <nce/queues.hxx>
+
+#include <algorithm>
+
+namespace vke {
+    auto QueueFamilyIndices::unique_families() const -> std::vector<u32> {
+        std::vector<u32> families;
+        for (const auto& family : {graphics_family, present_family, transfer_family, compute_family}) {
+            if (family && std::ranges::find(families, *family) == families.end()) {
+                families.push_back(*family);
+            }
+        }
+        return families;
+    }
+
+    auto select_queue_families(std::span<const VkQueueFamilyProperties> families, const std::function<bool(u32 family)>& supports_present) -> QueueFamilyIndices {
+        QueueFamilyIndices indices;
+        std::optional<u32> transfer_only;
+        std::optional<u32> async_compute;
+
+        for (u32 index = 0; index < families.size(); index++) {
+            VkQueueFlags flags = families[index].queueFlags;
+            if (families[index].queueCount == 0) { continue; }
+
+            if ((flags & VK_QUEUE_GRAPHICS_BIT) && !indices.graphics_family) {
+                indices.graphics_family = index;
+            }
+            // presenting from the graphics family avoids an ownership transfer of the swapchain image
+            if (supports_present(index) && (!indices.present_family || indices.graphics_family == index)) {
+                indices.present_family = index;
+            }
+            if (!(flags & VK_QUEUE_GRAPHICS_BIT)) {
+                if ((flags & VK_QUEUE_COMPUTE_BIT) && !async_compute) {
+                    async_compute = index;
+                } else if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_COMPUTE_BIT) && !transfer_only) {
+                    transfer_only = index;
+                }
+            }
+        }
+
+        // compute families implicitly support transfers
+        indices.transfer_family = transfer_only ? transfer_only : async_compute ? async_compute : indices.graphics_family;
+        indices.compute_family = async_compute ? async_compute : indices.graphics_family;
+        return indices;
+    }
+
+    auto transfer_buffer_ownership(VkBuffer buffer, u32 src_family, u32 dst_family,
+            VkPipelineStageFlags2 src_stage, VkAccessFlags2 src_access,
+            VkPipelineStageFlags2 dst_stage, VkAccessFlags2 dst_access) -> BufferOwnershipTransfer {
+        VkBufferMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        barrier.srcStageMask = src_stage;
+        barrier.srcAccessMask = src_access;
+        barrier.dstStageMask = dst_stage;
+        barrier.dstAccessMask = dst_access;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = buffer;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+        if (src_family == dst_family) {
+            return {barrier, std::nullopt};
+        }
+
+        barrier.srcQueueFamilyIndex = src_family;
+        barrier.dstQueueFamilyIndex = dst_family;
+        // destination scopes are ignored on release, source scopes on acquire
+        VkBufferMemoryBarrier2 release = barrier;
+        release.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        release.dstAccessMask = VK_ACCESS_2_NONE;
+        VkBufferMemoryBarrier2 acquire = barrier;
+        acquire.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        acquire.srcAccessMask = VK_ACCESS_2_NONE;
+        return {release, acquire};
+    }
+
+    auto transfer_image_ownership(VkImage image, VkImageAspectFlags aspect, u32 src_family, u32 dst_family,
+            VkPipelineStageFlags2 src_stage, VkAccessFlags2 src_access, VkImageLayout old_layout,
+            VkPipelineStageFlags2 dst_stage, VkAccessFlags2 dst_access, VkImageLayout new_layout) -> ImageOwnershipTransfer {
+        VkImageMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.srcStageMask = src_stage;
+        barrier.srcAccessMask = src_access;
+        barrier.dstStageMask = dst_stage;
+        barrier.dstAccessMask = dst_access;
+        barrier.oldLayout = old_layout;
+        barrier.newLayout = new_layout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange = {aspect, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS};
+        if (src_family == dst_family) {
+            return {barrier, std::nullopt};
+        }
+
+        barrier.srcQueueFamilyIndex = src_family;
+        barrier.dstQueueFamilyIndex = dst_family;
+        ImageOwnershipTransfer transfer{barrier, barrier};
+        transfer.release.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        transfer.release.dstAccessMask = VK_ACCESS_2_NONE;
+        transfer.acquire->srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        transfer.acquire->srcAccessMask = VK_ACCESS_2_NONE;
+        return transfer;
+    }
+}
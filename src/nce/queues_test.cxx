@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/queues.hxx>
+
+
+namespace {
+    auto family(VkQueueFlags flags, u32 count = 1) -> VkQueueFamilyProperties {
+        return VkQueueFamilyProperties{flags, count, 64, {1, 1, 1}};
+    }
+    constexpr VkQueueFlags universal = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+    constexpr VkQueueFlags compute = VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+    constexpr VkQueueFlags transfer = VK_QUEUE_TRANSFER_BIT | VK_QUEUE_SPARSE_BINDING_BIT;
+    auto present_everywhere = [](u32) { return true; };
+}
+
+TEST_CASE( "Single universal family falls back to graphics", "[queues]" ) {
+    std::vector families = { family(universal) };
+    vke::QueueFamilyIndices indices = vke::select_queue_families(families, present_everywhere);
+    REQUIRE(indices.has_value());
+    REQUIRE(indices.transfer_family == 0u);
+    REQUIRE(indices.compute_family == 0u);
+    REQUIRE_FALSE(indices.dedicated_transfer());
+    REQUIRE_FALSE(indices.dedicated_compute());
+    REQUIRE(indices.unique_families() == std::vector<u32>{ 0 });
+}
+
+TEST_CASE( "Dedicated transfer and compute families are preferred", "[queues]" ) {
+    // universal, transfer only, async compute
+    std::vector families = { family(universal, 16), family(transfer, 2), family(compute, 8) };
+    vke::QueueFamilyIndices indices = vke::select_queue_families(families, [](u32 f) { return f == 0; });
+    REQUIRE(indices.graphics_family == 0u);
+    REQUIRE(indices.present_family == 0u);
+    REQUIRE(indices.transfer_family == 1u);
+    REQUIRE(indices.compute_family == 2u);
+    REQUIRE(indices.unique_families() == std::vector<u32>{ 0, 1, 2 });
+}
+
+TEST_CASE( "Transfers use the async compute family without a transfer-only one", "[queues]" ) {
+    std::vector families = { family(universal), family(compute) };
+    vke::QueueFamilyIndices indices = vke::select_queue_families(families, present_everywhere);
+    REQUIRE(indices.transfer_family == 1u);
+    REQUIRE(indices.compute_family == 1u);
+    REQUIRE(indices.unique_families() == std::vector<u32>{ 0, 1 });
+}
+
+TEST_CASE( "Present prefers the graphics family", "[queues]" ) {
+    std::vector families = { family(transfer), family(compute), family(universal), family(universal, 0) };
+    vke::QueueFamilyIndices indices = vke::select_queue_families(families, present_everywhere);
+    REQUIRE(indices.graphics_family == 2u);
+    REQUIRE(indices.present_family == 2u);
+    REQUIRE(indices.transfer_family == 0u);
+
+    // a separate present family still works
+    vke::QueueFamilyIndices split = vke::select_queue_families(families, [](u32 f) { return f == 1; });
+    REQUIRE(split.present_family == 1u);
+    REQUIRE(split.graphics_family == 2u);
+}
+
+TEST_CASE( "Ownership transfers only split across families", "[queues]" ) {
+    auto buffer = reinterpret_cast<VkBuffer>(std::uintptr_t{0x10});
+    auto same = vke::transfer_buffer_ownership(buffer, 0, 0,
+            VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+    REQUIRE_FALSE(same.acquire.has_value());
+    REQUIRE(same.release.srcQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED);
+    REQUIRE(same.release.dstStageMask == VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT);
+
+    auto split = vke::transfer_buffer_ownership(buffer, 1, 0,
+            VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+    REQUIRE(split.acquire.has_value());
+    REQUIRE(split.release.srcQueueFamilyIndex == 1u);
+    REQUIRE(split.release.dstQueueFamilyIndex == 0u);
+    REQUIRE(split.release.dstAccessMask == VK_ACCESS_2_NONE);
+    REQUIRE(split.acquire->srcAccessMask == VK_ACCESS_2_NONE);
+    REQUIRE(split.acquire->dstStageMask == VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT);
+
+    auto image = reinterpret_cast<VkImage>(std::uintptr_t{0x20});
+    auto texture = vke::transfer_image_ownership(image, VK_IMAGE_ASPECT_COLOR_BIT, 1, 0,
+            VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    // both halves must describe the same layout transition
+    REQUIRE(texture.release.oldLayout == texture.acquire->oldLayout);
+    REQUIRE(texture.release.newLayout == texture.acquire->newLayout);
+    REQUIRE(texture.acquire->dstQueueFamilyIndex == 0u);
+}
@@ -0,0 +1,280 @@
+#include <nce/render_graph.hxx>
+
+#include <algorithm>
+
+namespace vke {
+    auto image_state(VkImageLayout layout) -> ImageState {
+        switch (layout) {
+            case VK_IMAGE_LAYOUT_UNDEFINED:
+            case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+                return { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, layout };
+            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+                return image_state(ResourceUsage::transfer_dst);
+            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+                return image_state(ResourceUsage::transfer_src);
+            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                         VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, layout };
+            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+                return image_state(ResourceUsage::color_attachment_write);
+            case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL:
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: {
+                ImageState state = image_state(ResourceUsage::depth_attachment_write);
+                state.layout = layout;
+                return state;
+            }
+            case VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_OPTIMAL:
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                         VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, layout };
+            default:
+                return { VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT, layout };
+        }
+    }
+
+    auto CompiledGraph::barrier_batch_count() const -> u32 {
+        u32 count = static_cast<u32>(std::ranges::count_if(passes, [](const CompiledPass& p) { return !p.barriers.empty(); }));
+        return final_barriers.empty() ? count : count + 1;
+    }
+
+    auto plan_transient_memory(const CompiledGraph& compiled, std::span<const VkMemoryRequirements> requirements) -> TransientMemoryPlan {
+        TransientMemoryPlan plan;
+        plan.allocation_of.assign(compiled.physical_slots.size(), CompiledGraph::NO_SLOT);
+        for (ResourceHandle r = 0; r < compiled.physical_slots.size(); r++) {
+            u32 slot = compiled.physical_slots[r];
+            if (slot == CompiledGraph::NO_SLOT) { continue; }
+            const VkMemoryRequirements& required = requirements[r];
+            auto allocation = std::ranges::find_if(plan.allocations, [&](const TransientMemoryPlan::Allocation& a) {
+                    return a.slot == slot && (a.memory_type_bits & required.memoryTypeBits) != 0;
+                    });
+            if (allocation == plan.allocations.end()) {
+                // no memory type fits every image, split the slot
+                plan.allocations.push_back({slot});
+                allocation = plan.allocations.end() - 1;
+            }
+            // offsets are always 0, so the largest image decides the size and alignment is implied
+            allocation->size = std::max(allocation->size, required.size);
+            allocation->memory_type_bits &= required.memoryTypeBits;
+            plan.allocation_of[r] = static_cast<u32>(allocation - plan.allocations.begin());
+        }
+        return plan;
+    }
+
+    auto RenderGraph::PassBuilder::read(ResourceHandle resource, ResourceUsage usage) -> PassBuilder& {
+        auto& accesses = graph.passes[pass].accesses;
+        auto existing = std::ranges::find(accesses, resource, &Access::resource);
+        if (existing == accesses.end()) {
+            accesses.push_back({resource, usage});
+        } else if (!is_write(existing->usage)) {
+            existing->usage = usage;
+        }
+        return *this;
+    }
+    auto RenderGraph::PassBuilder::write(ResourceHandle resource, ResourceUsage usage) -> PassBuilder& {
+        auto& accesses = graph.passes[pass].accesses;
+        auto existing = std::ranges::find(accesses, resource, &Access::resource);
+        if (existing == accesses.end()) {
+            accesses.push_back({resource, usage});
+        } else {
+            // a write supersedes any read of the same image, the write state covers both
+            existing->usage = usage;
+        }
+        return *this;
+    }
+    auto RenderGraph::PassBuilder::side_effect() -> PassBuilder& {
+        graph.passes[pass].side_effect = true;
+        return *this;
+    }
+
+    auto RenderGraph::import_image(std::string name, ImageDesc desc, VkImage image, VkImageLayout initial_layout, std::optional<VkImageLayout> final_layout) -> ResourceHandle {
+        return import_image(std::move(name), desc, image, ImageState{VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, initial_layout}, final_layout);
+    }
+    auto RenderGraph::import_image(std::string name, ImageDesc desc, VkImage image, ImageState initial, std::optional<VkImageLayout> final_layout) -> ResourceHandle {
+        resources.push_back(Resource{std::move(name), desc, true, initial, final_layout, image});
+        return static_cast<ResourceHandle>(resources.size() - 1);
+    }
+    auto RenderGraph::create_image(std::string name, ImageDesc desc) -> ResourceHandle {
+        return create_image(std::move(name), desc, ImageState{VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_UNDEFINED});
+    }
+    auto RenderGraph::create_image(std::string name, ImageDesc desc, ImageState initial) -> ResourceHandle {
+        initial.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        resources.push_back(Resource{std::move(name), desc, false, initial, std::nullopt, VK_NULL_HANDLE});
+        return static_cast<ResourceHandle>(resources.size() - 1);
+    }
+    auto RenderGraph::add_pass(std::string name, const std::function<void(PassBuilder&)>& setup, ExecuteFn execute) -> u32 {
+        passes.push_back(Pass{std::move(name), {}, std::move(execute), false});
+        u32 index = static_cast<u32>(passes.size() - 1);
+        PassBuilder builder{*this, index};
+        setup(builder);
+        return index;
+    }
+
+    auto RenderGraph::compile() const -> CompiledGraph {
+        CompiledGraph compiled;
+
+        // cull: walk backwards from the outputs, a pass survives if it writes something still needed
+        std::vector<bool> needed(resources.size(), false);
+        for (ResourceHandle r = 0; r < resources.size(); r++) {
+            needed[r] = resources[r].imported && resources[r].final_layout.has_value();
+        }
+        std::vector<bool> live(passes.size(), false);
+        for (size_t i = passes.size(); i-- > 0;) {
+            const Pass& pass = passes[i];
+            live[i] = pass.side_effect || std::ranges::any_of(pass.accesses, [&needed](const Access& a) {
+                    return is_write(a.usage) && needed[a.resource];
+                    });
+            if (!live[i]) { continue; }
+            // writes count too: attachments are loaded, so an earlier writer still feeds this pass
+            for (const Access& a : pass.accesses) {
+                needed[a.resource] = true;
+            }
+        }
+
+        std::vector<u32> order;
+        for (u32 i = 0; i < passes.size(); i++) {
+            if (live[i]) { order.push_back(i); } else { compiled.culled_passes.push_back(i); }
+        }
+
+        // lifetimes of transient images in positions of `order`
+        constexpr u32 UNUSED = std::numeric_limits<u32>::max();
+        std::vector<u32> first_use(resources.size(), UNUSED);
+        std::vector<u32> last_use(resources.size(), 0);
+        for (u32 position = 0; position < order.size(); position++) {
+            for (const Access& a : passes[order[position]].accesses) {
+                first_use[a.resource] = std::min(first_use[a.resource], position);
+                last_use[a.resource] = std::max(last_use[a.resource], position);
+            }
+        }
+
+        // alias transient images with disjoint lifetimes, greedily in order of first use
+        // only identical images share a slot, their memory requirements are then the same too
+        struct Slot {
+            u32 last_use;
+            ResourceHandle occupant;
+            ImageDesc desc;
+        };
+        std::vector<Slot> slots;
+        std::vector<ResourceHandle> transients;
+        std::vector<std::optional<ResourceHandle>> previous_occupant(resources.size());
+        compiled.physical_slots.assign(resources.size(), CompiledGraph::NO_SLOT);
+        for (ResourceHandle r = 0; r < resources.size(); r++) {
+            if (!resources[r].imported && first_use[r] != UNUSED) { transients.push_back(r); }
+        }
+        std::ranges::stable_sort(transients, {}, [&first_use](ResourceHandle r) { return first_use[r]; });
+        for (ResourceHandle r : transients) {
+            const ImageDesc& desc = resources[r].desc;
+            auto slot = std::ranges::find_if(slots, [&](const Slot& s) {
+                    return s.last_use < first_use[r] && s.desc == desc;
+                    });
+            if (slot == slots.end()) {
+                slots.push_back(Slot{last_use[r], r, desc});
+                compiled.physical_slots[r] = static_cast<u32>(slots.size() - 1);
+            } else {
+                previous_occupant[r] = slot->occupant;
+                slot->last_use = last_use[r];
+                slot->occupant = r;
+                compiled.physical_slots[r] = static_cast<u32>(slot - slots.begin());
+            }
+        }
+        compiled.physical_slot_count = static_cast<u32>(slots.size());
+
+        // walk the live passes and emit one batch of barriers per pass
+        struct Track {
+            VkImageLayout layout;
+            VkPipelineStageFlags2 sync_stage; ///< stages of the last write or layout transition
+            VkAccessFlags2 sync_access; ///< writes that still have to be made available
+            VkPipelineStageFlags2 read_stages; ///< stages that already see the last write
+        };
+        std::vector<Track> tracks;
+        tracks.reserve(resources.size());
+        for (const Resource& resource : resources) {
+            tracks.push_back(Track{resource.initial.layout, resource.initial.stage, resource.initial.access, VK_PIPELINE_STAGE_2_NONE});
+        }
+
+        for (u32 position = 0; position < order.size(); position++) {
+            CompiledPass compiled_pass{order[position], {}};
+            for (const Access& a : passes[order[position]].accesses) {
+                Track& track = tracks[a.resource];
+                ImageState state = image_state(a.usage);
+                bool write = is_write(a.usage);
+
+                if (!write && state.layout == track.layout) {
+                    // read after read/write in the same layout, only wait if this stage hasn't seen the write yet
+                    if (track.sync_stage != VK_PIPELINE_STAGE_2_NONE && (state.stage & ~track.read_stages) != 0) {
+                        compiled_pass.barriers.push_back({a.resource, track.sync_stage, track.sync_access, state.stage, state.access, track.layout, track.layout});
+                    }
+                    track.read_stages |= state.stage;
+                    continue;
+                }
+
+                VkPipelineStageFlags2 src_stage = track.sync_stage | track.read_stages;
+                VkAccessFlags2 src_access = track.sync_access;
+                if (position == first_use[a.resource] && previous_occupant[a.resource].has_value()) {
+                    // first use of aliased memory has to wait for the previous image in the slot
+                    const Track& previous = tracks[previous_occupant[a.resource].value()];
+                    src_stage |= previous.sync_stage | previous.read_stages;
+                    src_access |= previous.sync_access;
+                }
+                bool no_op = src_stage == VK_PIPELINE_STAGE_2_NONE && state.layout == track.layout;
+                if (!no_op) {
+                    compiled_pass.barriers.push_back({a.resource, src_stage, src_access, state.stage, state.access, track.layout, state.layout});
+                }
+                track.layout = state.layout;
+                track.sync_stage = state.stage;
+                track.sync_access = write ? state.access : VK_ACCESS_2_NONE;
+                track.read_stages = write ? VK_PIPELINE_STAGE_2_NONE : state.stage;
+            }
+            compiled.passes.push_back(std::move(compiled_pass));
+        }
+
+        for (ResourceHandle r = 0; r < resources.size(); r++) {
+            const Resource& resource = resources[r];
+            if (!resource.final_layout.has_value() || tracks[r].layout == resource.final_layout.value()) { continue; }
+            const Track& track = tracks[r];
+            ImageState state = image_state(resource.final_layout.value());
+            compiled.final_barriers.push_back({r, track.sync_stage | track.read_stages, track.sync_access, state.stage, state.access, track.layout, state.layout});
+        }
+        return compiled;
+    }
+
+    void RenderGraph::record_barriers(VkCommandBuffer command_buffer, std::span<const ImageBarrier> barriers, PFN_vkCmdPipelineBarrier2 pipeline_barrier) const {
+        if (barriers.empty()) { return; }
+        std::vector<VkImageMemoryBarrier2> image_barriers;
+        image_barriers.reserve(barriers.size());
+        for (const ImageBarrier& b : barriers) {
+            VkImageMemoryBarrier2 barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+            barrier.srcStageMask = b.src_stage;
+            barrier.srcAccessMask = b.src_access;
+            barrier.dstStageMask = b.dst_stage;
+            barrier.dstAccessMask = b.dst_access;
+            barrier.oldLayout = b.old_layout;
+            barrier.newLayout = b.new_layout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = resources[b.resource].image;
+            barrier.subresourceRange.aspectMask = resources[b.resource].desc.aspect;
+            barrier.subresourceRange.baseMipLevel = 0;
+            barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            barrier.subresourceRange.baseArrayLayer = 0;
+            barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+            image_barriers.push_back(barrier);
+        }
+        VkDependencyInfo dependency_info{};
+        dependency_info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency_info.imageMemoryBarrierCount = static_cast<u32>(image_barriers.size());
+        dependency_info.pImageMemoryBarriers = image_barriers.data();
+        pipeline_barrier(command_buffer, &dependency_info);
+    }
+
+    void RenderGraph::execute(VkCommandBuffer command_buffer, const CompiledGraph& compiled, PFN_vkCmdPipelineBarrier2 pipeline_barrier) const {
+        for (const CompiledPass& compiled_pass : compiled.passes) {
+            record_barriers(command_buffer, compiled_pass.barriers, pipeline_barrier);
+            const Pass& pass = passes[compiled_pass.pass];
+            if (pass.execute) {
+                pass.execute(command_buffer);
+            }
+        }
+        record_barriers(command_buffer, compiled.final_barriers, pipeline_barrier);
+    }
+}
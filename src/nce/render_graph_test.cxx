@@ -0,0 +1,265 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/render_graph.hxx>
+#include <fmt/format.h>
+
+
+namespace {
+    constexpr vke::ImageDesc color_desc { VK_FORMAT_B8G8R8A8_SRGB, {1280, 720}, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_ASPECT_COLOR_BIT };
+    constexpr vke::ImageDesc depth_desc { VK_FORMAT_D32_SFLOAT, {1280, 720}, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_IMAGE_ASPECT_DEPTH_BIT };
+
+    auto find_barrier(const std::vector<vke::ImageBarrier>& barriers, vke::ResourceHandle resource) -> const vke::ImageBarrier* {
+        for (const auto& b : barriers) {
+            if (b.resource == resource) { return &b; }
+        }
+        return nullptr;
+    }
+}
+
+TEST_CASE( "Swapchain pass transitions", "[render_graph]" ) {
+    using namespace vke;
+    RenderGraph graph;
+    auto swapchain = graph.import_image("swapchain", color_desc, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    auto depth = graph.create_image("depth", depth_desc);
+    graph.add_pass("main", [&](RenderGraph::PassBuilder& pass) {
+            pass.write(swapchain, ResourceUsage::color_attachment_write)
+                .write(depth, ResourceUsage::depth_attachment_write);
+            });
+
+    CompiledGraph compiled = graph.compile();
+    REQUIRE(compiled.passes.size() == 1);
+    REQUIRE(compiled.culled_passes.empty());
+    REQUIRE(compiled.passes[0].barriers.size() == 2);
+
+    const ImageBarrier* color = find_barrier(compiled.passes[0].barriers, swapchain);
+    REQUIRE(color != nullptr);
+    REQUIRE(color->old_layout == VK_IMAGE_LAYOUT_UNDEFINED);
+    REQUIRE(color->new_layout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    REQUIRE(color->dst_stage == VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+    REQUIRE(compiled.final_barriers.size() == 1);
+    REQUIRE(compiled.final_barriers[0].resource == swapchain);
+    REQUIRE(compiled.final_barriers[0].old_layout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    REQUIRE(compiled.final_barriers[0].new_layout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    REQUIRE(compiled.final_barriers[0].src_access == (VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT));
+    REQUIRE(compiled.barrier_batch_count() == 2);
+}
+
+TEST_CASE( "Unused passes are culled", "[render_graph]" ) {
+    using namespace vke;
+    RenderGraph graph;
+    auto swapchain = graph.import_image("swapchain", color_desc, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    auto picking = graph.create_image("picking", color_desc);
+    auto debug = graph.create_image("debug", color_desc);
+
+    graph.add_pass("picking", [&](RenderGraph::PassBuilder& pass) { pass.write(picking, ResourceUsage::color_attachment_write); });
+    graph.add_pass("debug", [&](RenderGraph::PassBuilder& pass) { pass.write(debug, ResourceUsage::color_attachment_write); });
+    graph.add_pass("outline", [&](RenderGraph::PassBuilder& pass) {
+            pass.read(picking, ResourceUsage::fragment_sampled_read)
+                .write(swapchain, ResourceUsage::color_attachment_write);
+            });
+    graph.add_pass("readback", [&](RenderGraph::PassBuilder& pass) {
+            pass.read(picking, ResourceUsage::transfer_src).side_effect();
+            });
+
+    CompiledGraph compiled = graph.compile();
+    REQUIRE(compiled.culled_passes == std::vector<u32>{ 1 });
+    REQUIRE(compiled.passes.size() == 3);
+    REQUIRE(compiled.physical_slots[debug] == CompiledGraph::NO_SLOT);
+
+    // picking is written, then sampled: the outline pass waits on the color write
+    const ImageBarrier* sampled = find_barrier(compiled.passes[1].barriers, picking);
+    REQUIRE(sampled != nullptr);
+    REQUIRE(sampled->src_stage == VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+    REQUIRE(sampled->dst_stage == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    REQUIRE(sampled->old_layout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    REQUIRE(sampled->new_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    // the readback transition only has to wait for the sampling read, no memory is made available
+    const ImageBarrier* copy = find_barrier(compiled.passes[2].barriers, picking);
+    REQUIRE(copy != nullptr);
+    REQUIRE(copy->src_stage == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    REQUIRE(copy->src_access == VK_ACCESS_2_NONE);
+    REQUIRE(copy->new_layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+}
+
+TEST_CASE( "Reads in the same layout share one barrier", "[render_graph]" ) {
+    using namespace vke;
+    RenderGraph graph;
+    auto swapchain = graph.import_image("swapchain", color_desc, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    auto shadow = graph.create_image("shadow", depth_desc);
+    graph.add_pass("shadow", [&](RenderGraph::PassBuilder& pass) { pass.write(shadow, ResourceUsage::depth_attachment_write); });
+    graph.add_pass("lighting", [&](RenderGraph::PassBuilder& pass) {
+            pass.read(shadow, ResourceUsage::fragment_sampled_read).write(swapchain, ResourceUsage::color_attachment_write);
+            });
+    graph.add_pass("ui", [&](RenderGraph::PassBuilder& pass) {
+            pass.read(shadow, ResourceUsage::fragment_sampled_read).write(swapchain, ResourceUsage::color_attachment_write);
+            });
+
+    CompiledGraph compiled = graph.compile();
+    REQUIRE(compiled.passes.size() == 3);
+    REQUIRE(find_barrier(compiled.passes[1].barriers, shadow) != nullptr);
+    REQUIRE(find_barrier(compiled.passes[2].barriers, shadow) == nullptr);
+
+    // back to back color writes still need a write-after-write barrier without a layout change
+    const ImageBarrier* waw = find_barrier(compiled.passes[2].barriers, swapchain);
+    REQUIRE(waw != nullptr);
+    REQUIRE(waw->old_layout == waw->new_layout);
+    REQUIRE(compiled.passes[2].barriers.size() == 1);
+}
+
+TEST_CASE( "Transient images with disjoint lifetimes alias", "[render_graph]" ) {
+    using namespace vke;
+    RenderGraph graph;
+    auto swapchain = graph.import_image("swapchain", color_desc, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    auto a = graph.create_image("a", color_desc);
+    auto b = graph.create_image("b", color_desc);
+    auto c = graph.create_image("c", color_desc);
+    graph.add_pass("write a", [&](RenderGraph::PassBuilder& pass) { pass.write(a, ResourceUsage::color_attachment_write); });
+    graph.add_pass("a to b", [&](RenderGraph::PassBuilder& pass) {
+            pass.read(a, ResourceUsage::fragment_sampled_read).write(b, ResourceUsage::color_attachment_write);
+            });
+    graph.add_pass("b to c", [&](RenderGraph::PassBuilder& pass) {
+            pass.read(b, ResourceUsage::fragment_sampled_read).write(c, ResourceUsage::color_attachment_write);
+            });
+    graph.add_pass("c to swapchain", [&](RenderGraph::PassBuilder& pass) {
+            pass.read(c, ResourceUsage::fragment_sampled_read).write(swapchain, ResourceUsage::color_attachment_write);
+            });
+
+    CompiledGraph compiled = graph.compile();
+    REQUIRE(compiled.physical_slot_count == 2);
+    REQUIRE(compiled.physical_slots[a] == compiled.physical_slots[c]);
+    REQUIRE(compiled.physical_slots[a] != compiled.physical_slots[b]);
+    REQUIRE(compiled.physical_slots[swapchain] == CompiledGraph::NO_SLOT);
+
+    // c reuses a's memory, its first write waits for a's last read
+    const ImageBarrier* alias = find_barrier(compiled.passes[2].barriers, c);
+    REQUIRE(alias != nullptr);
+    REQUIRE(alias->old_layout == VK_IMAGE_LAYOUT_UNDEFINED);
+    REQUIRE((alias->src_stage & VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT) != 0);
+}
+
+TEST_CASE( "Imported images wait on their previous access", "[render_graph]" ) {
+    using namespace vke;
+    RenderGraph graph;
+    auto swapchain = graph.import_image("swapchain", color_desc, VK_NULL_HANDLE,
+            ImageState{VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_UNDEFINED},
+            VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    auto depth = graph.import_image("depth", depth_desc, VK_NULL_HANDLE, image_state(ResourceUsage::depth_attachment_write));
+    graph.add_pass("main", [&](RenderGraph::PassBuilder& pass) {
+            pass.write(swapchain, ResourceUsage::color_attachment_write)
+                .write(depth, ResourceUsage::depth_attachment_write);
+            });
+
+    CompiledGraph compiled = graph.compile();
+    REQUIRE(compiled.passes[0].barriers.size() == 2);
+    const ImageBarrier* color = find_barrier(compiled.passes[0].barriers, swapchain);
+    REQUIRE(color->src_stage == VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+    REQUIRE(color->old_layout == VK_IMAGE_LAYOUT_UNDEFINED);
+
+    // same layout, but the previous frame's depth writes are still in flight
+    const ImageBarrier* waw = find_barrier(compiled.passes[0].barriers, depth);
+    REQUIRE(waw->src_access == (VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT));
+    REQUIRE(waw->old_layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+    REQUIRE(compiled.final_barriers.size() == 1);
+}
+
+TEST_CASE( "Transient images reused across frames wait on the previous frame", "[render_graph]" ) {
+    using namespace vke;
+    RenderGraph graph;
+    auto swapchain = graph.import_image("swapchain", color_desc, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    auto depth = graph.create_image("depth", depth_desc, image_state(ResourceUsage::depth_attachment_write));
+    auto scratch = graph.create_image("scratch", depth_desc);
+    graph.add_pass("main", [&](RenderGraph::PassBuilder& pass) {
+            pass.write(swapchain, ResourceUsage::color_attachment_write)
+                .write(depth, ResourceUsage::depth_attachment_write);
+            });
+    graph.add_pass("overlay", [&](RenderGraph::PassBuilder& pass) {
+            pass.write(swapchain, ResourceUsage::color_attachment_write)
+                .write(scratch, ResourceUsage::depth_attachment_write);
+            });
+
+    CompiledGraph compiled = graph.compile();
+    REQUIRE(compiled.passes.size() == 2);
+    // still transient, it gets memory from the graph and shares it once its lifetime ended
+    REQUIRE(compiled.physical_slot_count == 1);
+    REQUIRE(compiled.physical_slots[depth] == compiled.physical_slots[scratch]);
+
+    // contents are discarded, but the previous frame's depth writes have to finish first
+    const ImageBarrier* first = find_barrier(compiled.passes[0].barriers, depth);
+    REQUIRE(first != nullptr);
+    REQUIRE(first->old_layout == VK_IMAGE_LAYOUT_UNDEFINED);
+    REQUIRE(first->src_stage == (VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT));
+    REQUIRE(first->src_access == (VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT));
+
+    // an ordinary transient waits on nothing outside the graph
+    const ImageBarrier* aliased = find_barrier(compiled.passes[1].barriers, scratch);
+    REQUIRE(aliased != nullptr);
+    REQUIRE(aliased->old_layout == VK_IMAGE_LAYOUT_UNDEFINED);
+}
+
+TEST_CASE( "Only identical transient images alias", "[render_graph]" ) {
+    using namespace vke;
+    constexpr ImageDesc half_desc { VK_FORMAT_B8G8R8A8_SRGB, {640, 360}, color_desc.usage, VK_IMAGE_ASPECT_COLOR_BIT };
+    constexpr ImageDesc hdr_desc { VK_FORMAT_R16G16B16A16_SFLOAT, {1280, 720}, color_desc.usage, VK_IMAGE_ASPECT_COLOR_BIT };
+    RenderGraph graph;
+    auto swapchain = graph.import_image("swapchain", color_desc, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    auto a = graph.create_image("a", color_desc);
+    auto b = graph.create_image("b", color_desc);
+    auto half = graph.create_image("half", half_desc);
+    auto hdr = graph.create_image("hdr", hdr_desc);
+    auto again = graph.create_image("again", color_desc);
+    // a chain where each image is only alive for two passes, same usage and aspect throughout
+    std::array chain = {a, b, half, hdr, again};
+    graph.add_pass("write a", [&](RenderGraph::PassBuilder& pass) { pass.write(a, ResourceUsage::color_attachment_write); });
+    for (size_t i = 1; i < chain.size(); i++) {
+        graph.add_pass("step", [&, i](RenderGraph::PassBuilder& pass) {
+                pass.read(chain[i - 1], ResourceUsage::fragment_sampled_read).write(chain[i], ResourceUsage::color_attachment_write);
+                });
+    }
+    graph.add_pass("present", [&](RenderGraph::PassBuilder& pass) {
+            pass.read(again, ResourceUsage::fragment_sampled_read).write(swapchain, ResourceUsage::color_attachment_write);
+            });
+
+    CompiledGraph compiled = graph.compile();
+    // a smaller or differently formatted image never lands in memory sized for another
+    REQUIRE(compiled.physical_slots[half] != compiled.physical_slots[a]);
+    REQUIRE(compiled.physical_slots[half] != compiled.physical_slots[b]);
+    REQUIRE(compiled.physical_slots[hdr] != compiled.physical_slots[a]);
+    REQUIRE(compiled.physical_slots[hdr] != compiled.physical_slots[b]);
+    REQUIRE(compiled.physical_slots[hdr] != compiled.physical_slots[half]);
+    // the same description still reuses a finished slot
+    REQUIRE(compiled.physical_slots[again] == compiled.physical_slots[a]);
+    REQUIRE(compiled.physical_slot_count == 4);
+}
+
+TEST_CASE( "Transient memory is planned per slot and split when memory types differ", "[render_graph]" ) {
+    using namespace vke;
+    CompiledGraph compiled;
+    // resource 0 is imported, 1 and 2 share slot 0, 3 has slot 1, 4 shares slot 0 but fits none of its types
+    compiled.physical_slots = {CompiledGraph::NO_SLOT, 0, 0, 1, 0};
+    compiled.physical_slot_count = 2;
+    std::array<VkMemoryRequirements, 5> requirements = {{
+        {0, 0, 0},
+        {4096, 256, 0b0110},
+        {8192, 256, 0b0011},
+        {1024, 256, 0b1111},
+        {2048, 256, 0b1000},
+    }};
+
+    TransientMemoryPlan plan = plan_transient_memory(compiled, requirements);
+    REQUIRE(plan.allocations.size() == 3);
+    REQUIRE(plan.allocation_of[0] == CompiledGraph::NO_SLOT);
+    REQUIRE(plan.allocation_of[1] == plan.allocation_of[2]);
+    const auto& shared = plan.allocations[plan.allocation_of[1]];
+    REQUIRE(shared.slot == 0);
+    REQUIRE(shared.size == 8192);
+    REQUIRE(shared.memory_type_bits == 0b0010);
+    REQUIRE(plan.allocations[plan.allocation_of[3]].slot == 1);
+    // the intersection with 0b0010 would be empty, it gets its own memory instead of an invalid type
+    REQUIRE(plan.allocation_of[4] != plan.allocation_of[1]);
+    const auto& split = plan.allocations[plan.allocation_of[4]];
+    REQUIRE(split.slot == 0);
+    REQUIRE(split.size == 2048);
+    REQUIRE(split.memory_type_bits == 0b1000);
+    for (const auto& allocation : plan.allocations) { REQUIRE(allocation.memory_type_bits != 0); }
+}
@@ -0,0 +1,31 @@
+#include <nce/shader_library.hxx>
+
+#include <cstdlib>
+#include <fmt/format.h>
+
+namespace vke {
+    auto load_shader(std::string_view name, std::span<const EmbeddedShader> embedded,
+            const std::optional<std::filesystem::path>& override_dir) -> ShaderCode {
+        ShaderCode shader{};
+        if (override_dir) {
+            auto path = *override_dir / fmt::format("{}.spv", name);
+            shader.file = MappedFile::open(path);
+            if (shader.file) {
+                fmt::println("shader {} overridden by {}", name, path.c_str());
+                return shader;
+            }
+        }
+        shader.embedded = find_embedded_shader(embedded, name);
+        if (shader.embedded.empty()) {
+            fmt::println("shader {} is not embedded", name);
+            std::abort();
+        }
+        return shader;
+    }
+
+    auto shader_override_dir() -> std::optional<std::filesystem::path> {
+        const char* dir = std::getenv("NCE_SHADER_DIR");
+        if (!dir || *dir == '\0') { return std::nullopt; }
+        return std::filesystem::path(dir);
+    }
+}
@@ -0,0 +1,47 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/shader_library.hxx>
+
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+
+namespace {
+    constexpr u32 VERT[] = { 0x07230203, 0x00010000, 1 };
+    constexpr u32 FRAG[] = { 0x07230203, 0x00010000, 2, 3 };
+    constexpr std::array<vke::EmbeddedShader, 2> SHADERS{{
+        { "test.vert", VERT },
+        { "test.frag", FRAG },
+    }};
+
+    static_assert(vke::find_embedded_shader(SHADERS, "test.frag").size() == 4);
+    static_assert(vke::find_embedded_shader(SHADERS, "missing.comp").empty());
+}
+
+TEST_CASE( "Embedded shaders are found by name", "[shader_library]" ) {
+    auto shader = vke::load_shader("test.vert", SHADERS, std::nullopt);
+    REQUIRE_FALSE(shader.file.has_value());
+    REQUIRE(shader.embedded.data() == VERT);
+    REQUIRE(shader.bytes().size() == sizeof(VERT));
+}
+
+TEST_CASE( "The override directory takes precedence", "[shader_library]" ) {
+    auto dir = std::filesystem::temp_directory_path() / fmt::format("nce_{}_shaders", getpid());
+    std::filesystem::create_directories(dir);
+    {
+        std::ofstream file(dir / "test.frag.spv", std::ios::binary);
+        file.write(reinterpret_cast<const char*>(VERT), sizeof(VERT));
+    }
+
+    auto overridden = vke::load_shader("test.frag", SHADERS, dir);
+    REQUIRE(overridden.file.has_value());
+    REQUIRE(overridden.bytes().size() == sizeof(VERT));
+    REQUIRE(std::memcmp(overridden.bytes().data(), VERT, sizeof(VERT)) == 0);
+
+    // only the edited shaders need to be in the directory
+    auto fallback = vke::load_shader("test.vert", SHADERS, dir);
+    REQUIRE_FALSE(fallback.file.has_value());
+    REQUIRE(fallback.embedded.data() == VERT);
+
+    std::filesystem::remove_all(dir);
+}
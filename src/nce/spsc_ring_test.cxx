@@ -0,0 +1,42 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/spsc_ring.hxx>
+
+#include <thread>
+
+
+TEST_CASE( "The ring is FIFO and bounded", "[spsc_ring]" ) {
+    nce::SpscRing<u32, 8> ring;
+    REQUIRE(ring.empty());
+    REQUIRE_FALSE(ring.try_pop().has_value());
+    for (u32 round = 0; round < 5; round++) {
+        for (u32 i = 0; i < 8; i++) {
+            REQUIRE(ring.try_push(round * 8 + i));
+        }
+        REQUIRE_FALSE(ring.try_push(0));
+        REQUIRE(ring.size() == 8);
+        for (u32 i = 0; i < 8; i++) {
+            REQUIRE(ring.try_pop() == round * 8 + i);
+        }
+        REQUIRE(ring.empty());
+    }
+}
+
+TEST_CASE( "One producer and one consumer thread hand over every element in order", "[spsc_ring]" ) {
+    constexpr u64 COUNT = 1'000'000;
+    nce::SpscRing<u64, 256> ring;
+    {
+        std::jthread producer([&] {
+            for (u64 i = 0; i < COUNT; i++) {
+                while (!ring.try_push(i)) { std::this_thread::yield(); }
+            }
+        });
+        u64 expected = 0;
+        while (expected < COUNT) {
+            auto value = ring.try_pop();
+            if (!value) { std::this_thread::yield(); continue; }
+            REQUIRE(*value == expected);
+            expected++;
+        }
+    }
+    REQUIRE(ring.empty());
+}
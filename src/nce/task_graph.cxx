@@ -0,0 +1,101 @@
+#include <nce/task_graph.hxx>
+
+#include <algorithm>
+#include <condition_variable>
+#include <fmt/format.h>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace vke {
+    auto TaskGraph::add(std::string name, std::function<void()> work, std::vector<TaskHandle> dependencies) -> TaskHandle {
+        TaskHandle handle = static_cast<TaskHandle>(tasks.size());
+        for (TaskHandle dependency : dependencies) {
+            if (dependency >= handle) {
+                fmt::println("task {} depends on a task added after it", name);
+                std::abort();
+            }
+        }
+        tasks.push_back(Task{std::move(name), std::move(work), std::move(dependencies)});
+        return handle;
+    }
+
+    auto TaskGraph::run(u32 threads) -> std::vector<StageTiming> {
+        std::vector<StageTiming> timings(tasks.size());
+        std::vector<u32> waiting(tasks.size());
+        std::vector<std::vector<TaskHandle>> dependents(tasks.size());
+        // lowest handle first, keeps the order of add() among ready stages
+        std::priority_queue<TaskHandle, std::vector<TaskHandle>, std::greater<>> ready;
+        for (TaskHandle task = 0; task < tasks.size(); task++) {
+            waiting[task] = static_cast<u32>(tasks[task].dependencies.size());
+            for (TaskHandle dependency : tasks[task].dependencies) {
+                dependents[dependency].push_back(task);
+            }
+            if (waiting[task] == 0) { ready.push(task); }
+        }
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        size_t finished = 0;
+        std::exception_ptr error;
+        auto start = std::chrono::steady_clock::now();
+        auto since_start = [start](std::chrono::steady_clock::time_point time) {
+            return std::chrono::duration<f64, std::milli>(time - start).count();
+        };
+
+        auto worker = [&](u32 index) {
+            std::unique_lock lock(mutex);
+            while (true) {
+                wake.wait(lock, [&] { return !ready.empty() || finished == tasks.size() || error; });
+                if (finished == tasks.size() || error) { return; }
+                TaskHandle task = ready.top();
+                ready.pop();
+                lock.unlock();
+
+                auto begin = std::chrono::steady_clock::now();
+                std::exception_ptr task_error;
+                try {
+                    tasks[task].work();
+                } catch (...) {
+                    task_error = std::current_exception();
+                }
+                auto end = std::chrono::steady_clock::now();
+
+                lock.lock();
+                timings[task] = StageTiming{tasks[task].name, since_start(begin), since_start(end), index};
+                finished++;
+                if (task_error && !error) { error = task_error; }
+                for (TaskHandle dependent : dependents[task]) {
+                    if (--waiting[dependent] == 0) { ready.push(dependent); }
+                }
+                wake.notify_all();
+            }
+        };
+
+        {
+            std::vector<std::jthread> pool;
+            for (u32 index = 1; index < threads; index++) {
+                pool.emplace_back(worker, index);
+            }
+            worker(0);
+        }
+        if (error) { std::rethrow_exception(error); }
+        return timings;
+    }
+
+    void print_timeline(std::span<const StageTiming> timings) {
+        constexpr f64 BAR_WIDTH = 48.0;
+        f64 total = 0.0;
+        for (const auto& timing : timings) {
+            total = std::max(total, timing.end_ms);
+        }
+        fmt::println("startup: {:.2f} ms", total);
+        for (const auto& timing : timings) {
+            auto column = [&](f64 ms) { return static_cast<size_t>(total > 0.0 ? ms / total * BAR_WIDTH : 0.0); };
+            size_t begin = column(timing.start_ms);
+            size_t length = std::max<size_t>(column(timing.end_ms) - begin, 1);
+            fmt::println("  {:<20} {:>8.2f} ms  t{} |{}{}", timing.name, timing.end_ms - timing.start_ms, timing.worker,
+                    std::string(begin, ' '), std::string(length, '#'));
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/task_graph.hxx>
+
+#include <latch>
+#include <mutex>
+#include <stdexcept>
+
+
+TEST_CASE( "One thread runs stages in insertion order", "[task_graph]" ) {
+    vke::TaskGraph graph;
+    std::vector<u32> order;
+    auto a = graph.add("a", [&] { order.push_back(0); });
+    graph.add("b", [&] { order.push_back(1); }, {a});
+    graph.add("c", [&] { order.push_back(2); });
+    graph.add("d", [&] { order.push_back(3); }, {a});
+
+    auto timings = graph.run(1);
+    REQUIRE(order == std::vector<u32>{ 0, 1, 2, 3 });
+    REQUIRE(timings.size() == 4);
+    REQUIRE(timings[1].name == "b");
+    REQUIRE(timings[1].worker == 0);
+}
+
+TEST_CASE( "Stages start after their dependencies finished", "[task_graph]" ) {
+    vke::TaskGraph graph;
+    std::mutex mutex;
+    std::vector<vke::TaskHandle> order;
+    auto record = [&](vke::TaskHandle task) {
+        return [&, task] { std::scoped_lock lock(mutex); order.push_back(task); };
+    };
+    // a diamond with a long independent chain next to it
+    auto device = graph.add("device", record(0));
+    auto pipeline = graph.add("pipeline", record(1), {device});
+    auto pool = graph.add("pool", record(2), {device});
+    auto draw = graph.add("draw", record(3), {pipeline, pool});
+    auto model = graph.add("model", record(4));
+    graph.add("vertices", record(5), {model, draw});
+
+    auto timings = graph.run(4);
+    REQUIRE(order.size() == 6);
+    auto position = [&](vke::TaskHandle task) { return std::ranges::find(order, task) - order.begin(); };
+    for (const auto& task : graph.tasks) {
+        for (vke::TaskHandle dependency : task.dependencies) {
+            REQUIRE(timings[dependency].end_ms <= timings[static_cast<size_t>(&task - graph.tasks.data())].start_ms);
+        }
+    }
+    REQUIRE(position(device) < position(pipeline));
+    REQUIRE(position(pipeline) < position(draw));
+    REQUIRE(position(pool) < position(draw));
+    REQUIRE(position(draw) < position(5));
+}
+
+TEST_CASE( "Independent stages run concurrently", "[task_graph]" ) {
+    vke::TaskGraph graph;
+    // each stage waits for the other, this only finishes if both run at the same time
+    std::latch both(2);
+    graph.add("texture", [&] { both.arrive_and_wait(); });
+    graph.add("model", [&] { both.arrive_and_wait(); });
+    auto timings = graph.run(2);
+    REQUIRE(timings[0].worker != timings[1].worker);
+}
+
+TEST_CASE( "A failing stage stops its dependents and rethrows", "[task_graph]" ) {
+    vke::TaskGraph graph;
+    bool dependent_ran = false;
+    auto load = graph.add("load", [] { throw std::runtime_error("missing model"); });
+    graph.add("upload", [&] { dependent_ran = true; }, {load});
+    REQUIRE_THROWS_AS(graph.run(2), std::runtime_error);
+    REQUIRE_FALSE(dependent_ran);
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/triple_buffer.hxx>
+
+#include <thread>
+
+
+TEST_CASE( "The reader gets the newest published value", "[triple_buffer]" ) {
+    nce::TripleBuffer<u32> buffer(7);
+    REQUIRE_FALSE(buffer.has_new());
+    REQUIRE(buffer.read() == 7);
+
+    buffer.write_buffer() = 1;
+    buffer.publish();
+    REQUIRE(buffer.has_new());
+    REQUIRE(buffer.read() == 1);
+    REQUIRE_FALSE(buffer.has_new());
+    // nothing new, the same value again
+    REQUIRE(buffer.read() == 1);
+
+    // values the reader was too slow for are skipped
+    for (u32 value = 2; value <= 5; value++) {
+        buffer.write_buffer() = value;
+        buffer.publish();
+    }
+    REQUIRE(buffer.read() == 5);
+
+    // an unpublished write is invisible
+    buffer.write_buffer() = 6;
+    REQUIRE(buffer.read() == 5);
+}
+
+TEST_CASE( "A reader thread never sees a torn or older value", "[triple_buffer]" ) {
+    struct Pair {
+        u64 a = 0;
+        u64 b = 0; ///< always 3 * a once published
+    };
+    constexpr u64 COUNT = 200'000;
+    nce::TripleBuffer<Pair> buffer;
+    u64 reads = 0;
+    {
+        std::jthread writer([&] {
+            for (u64 i = 1; i <= COUNT; i++) {
+                Pair& pair = buffer.write_buffer();
+                pair.a = i;
+                pair.b = 3 * i;
+                buffer.publish();
+            }
+        });
+        u64 last = 0;
+        while (last < COUNT) {
+            const Pair& pair = buffer.read();
+            REQUIRE(pair.b == 3 * pair.a);
+            REQUIRE(pair.a >= last);
+            last = pair.a;
+            reads++;
+        }
+    }
+    REQUIRE(reads > 0);
+}
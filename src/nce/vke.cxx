@@ -3,45 +3,64 @@
 #include <vulkan/vulkan_core.h>
 #include <stb/stb_image.h>
 #include <tiny_obj_loader.h>
+#include <nce/embedded_shaders.hxx>
+#include <spanstream>
+#include <sys/resource.h>
 
 
 
-[[nodiscard]] static auto read_file(std::filesystem::path shader_path) -> std::vector<std::byte> {
-    std::ifstream file(shader_path, std::ios::ate | std::ios::binary);
-
-    if (!file.is_open()) {
-        fmt::println("Failed to open {}", shader_path.c_str());
+[[nodiscard]] static auto map_file(const std::filesystem::path& path) -> vke::MappedFile {
+    auto file = vke::MappedFile::open(path);
+    if (!file) {
+        fmt::println("Failed to open {}", path.c_str());
         std::abort();
     }
+    return std::move(*file);
+}
+
+/// @brief Channel order of a swapchain format captures can be encoded from, std::nullopt for anything but 8 bit RGBA/BGRA.
+[[nodiscard]] static auto readback_pixel_order(VkFormat format) -> std::optional<vke::PixelOrder> {
+    switch (format) {
+        case VK_FORMAT_B8G8R8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+            return vke::PixelOrder::bgra;
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_R8G8B8A8_UNORM:
+            return vke::PixelOrder::rgba;
+        default:
+            return std::nullopt;
+    }
+}
 
-    std::size_t file_size = static_cast<size_t>(file.tellg());
-    std::vector<std::byte> buffer(file_size);
-    file.seekg(0);
-    file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(file_size));
-    fmt::println("Buffer size {}", buffer.size());
-    file.close();
-    return buffer;
+/// @brief Embedded SPIR-V of `name`, or NCE_SHADER_DIR/`name`.spv when that is set.
+[[nodiscard]] static auto shader_spirv(std::string_view name) -> vke::ShaderCode {
+    static const auto override_dir = vke::shader_override_dir();
+    return vke::load_shader(name, vke::EMBEDDED_SHADERS, override_dir);
 }
+// every shader a pipeline is built from, a missing one fails the build instead of startup
+static_assert(std::ranges::all_of(std::array<std::string_view, 4>{ "hello.vert", "hello.frag", "cull.comp", "hiz.comp" },
+        [](std::string_view name) { return !vke::find_embedded_shader(vke::EMBEDDED_SHADERS, name).empty(); }));
 
 namespace vke {
     //static members
+    MemoryBudget Instance::memory_budget; // first, so it outlives every static that frees device memory
     std::unique_ptr<VkInstance_T, VKEInstanceDeleter> Instance::instance(nullptr);
-    std::unique_ptr<VkSurfaceKHR_T, VKESurfaceDeleter> Instance::surface(nullptr);
     VkPhysicalDevice Instance::physical_device(nullptr);
     std::unique_ptr<VkDevice_T, VKEDeviceDeleter> Instance::logical_device(nullptr);
     const std::string Instance::MODEL_PATH = "assets/models/viking_room.obj";
-    const std::string Instance::TEXTURE_PATH = "assets/models/viking_room.png";
+    const std::array<std::string, 2> Instance::TEXTURE_PATHS = { "assets/models/viking_room.png", "assets/texture.jpg" };
+    const std::string Instance::ASSET_PACK_PATH = "assets.pack";
 
     // function definitions
-    auto Instance::create_image_view(VkImage image, VkFormat format, VkImageAspectFlags aspect_flags) -> VkImageView {
+    auto Instance::create_image_view(VkImage image, VkFormat format, VkImageAspectFlags aspect_flags, u32 base_mip, u32 mip_count) -> VkImageView {
         VkImageViewCreateInfo view_info{};
         view_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
         view_info.image = image;
         view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
         view_info.format = format;
         view_info.subresourceRange.aspectMask = aspect_flags;
-        view_info.subresourceRange.baseMipLevel = 0;
-        view_info.subresourceRange.levelCount = 1;
+        view_info.subresourceRange.baseMipLevel = base_mip;
+        view_info.subresourceRange.levelCount = mip_count;
         view_info.subresourceRange.baseArrayLayer = 0;
         view_info.subresourceRange.layerCount = 1;
 
@@ -69,21 +88,31 @@ namespace vke {
         return find_supported_format(
                 {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
                 VK_IMAGE_TILING_OPTIMAL,
-                VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+                VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_MINMAX_BIT
                 );
     }
     auto Instance::has_stencil_component(VkFormat format) -> bool {
         return format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT;
     }
-    void Instance::create_depth_resources() {
-        VkFormat depth_format = find_depth_format();
-        depth_image.reset(nullptr);
-        depth_image_memory.reset(nullptr);
-        create_image(swapchain_extent.width, swapchain_extent.height, depth_format, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depth_image, depth_image_memory);
-        depth_image_view.reset(create_image_view(depth_image.get(), depth_format, VK_IMAGE_ASPECT_DEPTH_BIT));
+    void Instance::create_hiz_resources(Viewport& viewport) {
+        viewport.hiz_size = hiz_extent(viewport.swapchain_extent);
+        u32 mip_count = hiz_mip_count(viewport.hiz_size);
+        viewport.hiz_mip_views.clear();
+        viewport.hiz_view.reset(nullptr);
+        viewport.hiz_image.reset(nullptr);
+        viewport.hiz_memory.reset(nullptr);
+        create_image(viewport.hiz_size.width, viewport.hiz_size.height, VK_FORMAT_R32_SFLOAT, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::attachment, viewport.hiz_image, viewport.hiz_memory, mip_count);
+        viewport.hiz_view.reset(create_image_view(viewport.hiz_image.get(), VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, 0, mip_count));
+        for (u32 mip = 0; mip < mip_count; mip++) {
+            viewport.hiz_mip_views.emplace_back(create_image_view(viewport.hiz_image.get(), VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, mip));
+        }
+        // the first early phase binds the pyramid before anything was written to it
+        transition_image_layout(viewport.hiz_image.get(), VK_FORMAT_R32_SFLOAT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
     }
     void Instance::create_texture_image_view() {
-        texture_image_view.reset(create_image_view(texture_image.get(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT));
+        for (auto& texture : textures) {
+            texture.view.reset(create_image_view(texture.image.get(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT));
+        }
     }
     void Instance::create_texture_sampler() {
         VkSamplerCreateInfo sampler_info{};
@@ -108,8 +137,76 @@ namespace vke {
         vke::Result result = vkCreateSampler(logical_device.get(), &sampler_info, nullptr, reinterpret_cast<VkSampler*>(&texture_sampler));
         VKE_RESULT_CRASH(result);
     }
-    void Instance::copy_buffer_to_image(VkBuffer buffer, VkImage image, u32 width, u32 height) {
-        VkCommandBuffer command_buffer = begin_single_time_commands();
+    auto Instance::begin_upload() -> UploadBatch {
+        UploadBatch upload{};
+        VkCommandBufferAllocateInfo alloc_info{};
+        alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        alloc_info.commandPool = transfer_command_pool.get();
+        alloc_info.commandBufferCount = 1;
+        vke::Result result = vkAllocateCommandBuffers(logical_device.get(), &alloc_info, &upload.command_buffer);
+        VKE_RESULT_CRASH(result);
+
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        result = vkBeginCommandBuffer(upload.command_buffer, &begin_info);
+        VKE_RESULT_CRASH(result);
+        return upload;
+    }
+    void Instance::upload_buffer(UploadBatch& upload, VkBuffer dst, const void* data, VkDeviceSize size, VkPipelineStageFlags2 dst_stage, VkAccessFlags2 dst_access) {
+        auto& staging_memory = upload.staging_memory.emplace_back(nullptr);
+        auto& staging_buffer = upload.staging_buffers.emplace_back(nullptr);
+        create_buffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::staging, staging_buffer, staging_memory);
+
+        void* mapped;
+        vkMapMemory(logical_device.get(), staging_memory.get(), 0, size, 0, &mapped); {
+            memcpy(mapped, data, static_cast<size_t>(size));
+        } vkUnmapMemory(logical_device.get(), staging_memory.get());
+
+        VkBufferCopy copy_region{};
+        copy_region.size = size;
+        vkCmdCopyBuffer(upload.command_buffer, staging_buffer.get(), dst, 1, &copy_region);
+
+        BufferOwnershipTransfer transfer = transfer_buffer_ownership(dst,
+                queue_families.transfer_family.value(), queue_families.graphics_family.value(),
+                VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                dst_stage, dst_access);
+        VkDependencyInfo dependency{};
+        dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.bufferMemoryBarrierCount = 1;
+        dependency.pBufferMemoryBarriers = &transfer.release;
+        vkCmdPipelineBarrier2(upload.command_buffer, &dependency);
+        if (transfer.acquire) { upload.buffer_acquires.push_back(*transfer.acquire); }
+    }
+    void Instance::upload_image(UploadBatch& upload, VkImage image, const void* data, VkDeviceSize size, u32 width, u32 height) {
+        auto& staging_memory = upload.staging_memory.emplace_back(nullptr);
+        auto& staging_buffer = upload.staging_buffers.emplace_back(nullptr);
+        create_buffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::staging, staging_buffer, staging_memory);
+
+        void* mapped;
+        vkMapMemory(logical_device.get(), staging_memory.get(), 0, size, 0, &mapped); {
+            memcpy(mapped, data, static_cast<size_t>(size));
+        } vkUnmapMemory(logical_device.get(), staging_memory.get());
+
+        VkImageMemoryBarrier2 to_transfer{};
+        to_transfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        to_transfer.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        to_transfer.srcAccessMask = VK_ACCESS_2_NONE;
+        to_transfer.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        to_transfer.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        to_transfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        to_transfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        to_transfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        to_transfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        to_transfer.image = image;
+        to_transfer.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        VkDependencyInfo dependency{};
+        dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.imageMemoryBarrierCount = 1;
+        dependency.pImageMemoryBarriers = &to_transfer;
+        vkCmdPipelineBarrier2(upload.command_buffer, &dependency);
+
         VkBufferImageCopy region{};
         region.bufferOffset = 0;
         region.bufferRowLength = 0;
@@ -126,65 +223,136 @@ namespace vke {
             height,
             1
         };
-        vkCmdCopyBufferToImage(command_buffer, buffer, image,
+        vkCmdCopyBufferToImage(upload.command_buffer, staging_buffer.get(), image,
                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
-        end_single_time_commands(command_buffer);
+        ImageOwnershipTransfer transfer = transfer_image_ownership(image, VK_IMAGE_ASPECT_COLOR_BIT,
+                queue_families.transfer_family.value(), queue_families.graphics_family.value(),
+                VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        dependency.pImageMemoryBarriers = &transfer.release;
+        vkCmdPipelineBarrier2(upload.command_buffer, &dependency);
+        if (transfer.acquire) { upload.image_acquires.push_back(*transfer.acquire); }
+    }
+    void Instance::submit_upload(UploadBatch&& upload) {
+        vke::Result result = vkEndCommandBuffer(upload.command_buffer);
+        VKE_RESULT_CRASH(result);
+
+        upload.timeline_value = ++upload_timeline_value;
+        VkSemaphoreSubmitInfo signal{};
+        signal.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        signal.semaphore = upload_timeline.get();
+        signal.value = upload.timeline_value;
+        signal.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        submit(transfer_queue, upload.command_buffer, {}, std::span(&signal, 1), VK_NULL_HANDLE);
+
+        pending_buffer_acquires.insert(pending_buffer_acquires.end(), upload.buffer_acquires.begin(), upload.buffer_acquires.end());
+        pending_image_acquires.insert(pending_image_acquires.end(), upload.image_acquires.begin(), upload.image_acquires.end());
+        uploads_in_flight.push_back(std::move(upload));
     }
-    void Instance::transition_image_layout(VkImage image, [[maybe_unused]] VkFormat format, VkImageLayout old_layout, VkImageLayout new_layout) {
+    void Instance::collect_uploads() {
+        if (uploads_in_flight.empty()) { return; }
+        u64 completed = 0;
+        dispatch.GetSemaphoreCounterValue(logical_device.get(), upload_timeline.get(), &completed);
+        std::erase_if(uploads_in_flight, [&](UploadBatch& upload) {
+                if (upload.timeline_value > completed) { return false; }
+                vkFreeCommandBuffers(logical_device.get(), transfer_command_pool.get(), 1, &upload.command_buffer);
+                return true;
+                });
+    }
+    void Instance::submit(VkQueue queue, VkCommandBuffer command_buffer, std::span<const VkSemaphoreSubmitInfo> waits, std::span<const VkSemaphoreSubmitInfo> signals, VkFence fence) const {
+        VkCommandBufferSubmitInfo command_buffer_info{};
+        command_buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        command_buffer_info.commandBuffer = command_buffer;
+
+        VkSubmitInfo2 submit_info{};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submit_info.waitSemaphoreInfoCount = static_cast<u32>(waits.size());
+        submit_info.pWaitSemaphoreInfos = waits.data();
+        submit_info.commandBufferInfoCount = 1;
+        submit_info.pCommandBufferInfos = &command_buffer_info;
+        submit_info.signalSemaphoreInfoCount = static_cast<u32>(signals.size());
+        submit_info.pSignalSemaphoreInfos = signals.data();
+        vke::Result result = dispatch.QueueSubmit2(queue, 1, &submit_info, fence);
+        VKE_RESULT_CRASH(result);
+    }
+    void Instance::transition_image_layout(VkImage image, VkFormat format, VkImageLayout old_layout, VkImageLayout new_layout) {
         VkCommandBuffer command_buffer = begin_single_time_commands();
-        VkImageMemoryBarrier barrier{};
-        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        ImageState src = image_state(old_layout);
+        ImageState dst = image_state(new_layout);
+
+        VkImageMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        barrier.srcStageMask = src.stage;
+        barrier.srcAccessMask = src.access;
+        barrier.dstStageMask = dst.stage;
+        barrier.dstAccessMask = dst.access;
         barrier.oldLayout = old_layout;
         barrier.newLayout = new_layout;
         barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier.image = image;
         barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        if (new_layout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL || new_layout == VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL) {
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            if (has_stencil_component(format)) {
+                barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+            }
+        }
         barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
         barrier.subresourceRange.baseArrayLayer = 0;
         barrier.subresourceRange.layerCount = 1;
-        barrier.srcAccessMask = 0; // TODO
-        barrier.dstAccessMask = 0; // TODO
 
+        VkDependencyInfo dependency_info{};
+        dependency_info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency_info.imageMemoryBarrierCount = 1;
+        dependency_info.pImageMemoryBarriers = &barrier;
+        vkCmdPipelineBarrier2(command_buffer, &dependency_info);
 
-        VkPipelineStageFlags source_stage;
-        VkPipelineStageFlags destination_stage;
-
-        if (old_layout == VK_IMAGE_LAYOUT_UNDEFINED && new_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-            barrier.srcAccessMask = 0;
-            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-            source_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-            destination_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        } else if (old_layout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && new_layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-            source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-            destination_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-        } else {
-            fmt::println("unsupported layout transition!");
-            std::abort();
+        end_single_time_commands(command_buffer);
+    }
+    auto Instance::realize_render_graph(RenderGraph& graph, const CompiledGraph& compiled) -> RenderGraphImages {
+        RenderGraphImages realized;
+        realized.images.resize(graph.resources.size());
+        std::vector<VkMemoryRequirements> requirements(graph.resources.size());
+
+        for (ResourceHandle r = 0; r < graph.resources.size(); r++) {
+            if (compiled.physical_slots[r] == CompiledGraph::NO_SLOT) { continue; }
+            const ImageDesc& desc = graph.resources[r].desc;
+
+            VkImageCreateInfo image_info{};
+            image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            image_info.imageType = VK_IMAGE_TYPE_2D;
+            image_info.extent = {desc.extent.width, desc.extent.height, 1};
+            image_info.mipLevels = 1;
+            image_info.arrayLayers = 1;
+            image_info.format = desc.format;
+            image_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+            image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            image_info.usage = desc.usage;
+            image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+            image_info.flags = 0;
+            vke::Result result = vkCreateImage(logical_device.get(), &image_info, nullptr, reinterpret_cast<VkImage*>(&realized.images[r]));
+            VKE_RESULT_CRASH(result);
+            vkGetImageMemoryRequirements(logical_device.get(), realized.images[r].get(), &requirements[r]);
         }
 
+        TransientMemoryPlan plan = plan_transient_memory(compiled, requirements);
+        realized.memory.resize(plan.allocations.size());
+        for (const auto& [memory, allocation] : std::views::zip(realized.memory, plan.allocations)) {
+            VkMemoryRequirements requirements_of_slot{allocation.size, 0, allocation.memory_type_bits};
+            memory = allocate_memory(requirements_of_slot, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::attachment);
+        }
 
-        vkCmdPipelineBarrier(
-                command_buffer, // commandBuffer
-                source_stage,   // srcStageMask  
-                destination_stage,// dstStageMask 
-                0,              // dependencyFlags 
-                0,              // memoryBarrierCount
-                nullptr,        // *pMemoryBarriers
-                0,              // bufferMemoryBarrierCount 
-                nullptr,        // *pBufferMemoryBarriers
-                1,              // imageMemoryBarrierCount
-                &barrier        // *pImageMemoryBarriers
-                );
-
-
-        end_single_time_commands(command_buffer);
+        for (ResourceHandle r = 0; r < graph.resources.size(); r++) {
+            u32 allocation = plan.allocation_of[r];
+            if (allocation == CompiledGraph::NO_SLOT) { continue; }
+            vkBindImageMemory(logical_device.get(), realized.images[r].get(), realized.memory[allocation].get(), 0);
+            graph.bind_image(r, realized.images[r].get());
+        }
+        return realized;
     }
     auto Instance::begin_single_time_commands() const -> VkCommandBuffer {
         VkCommandBufferAllocateInfo alloc_info{};
@@ -218,41 +386,74 @@ namespace vke {
 
         vkFreeCommandBuffers(logical_device.get(), command_pool.get(), 1, &command_buffer);
     }
-    void Instance::create_texture_image() {
+    auto Instance::load_asset(const std::string& path) const -> Asset {
+        if (asset_pack) {
+            if (auto asset = asset_pack->read(path)) { return std::move(*asset); }
+        }
+        Asset asset{};
+        asset.file = map_file(path);
+        asset.bytes = asset.file->bytes();
+        return asset;
+    }
+    auto Instance::decode_texture(const std::string& path) const -> DecodedTexture {
+        Asset file = load_asset(path);
+        if (file.bytes.size() > static_cast<size_t>(std::numeric_limits<i32>::max())) {
+            fmt::println("texture image {} is too large!", path);
+            std::abort();
+        }
         i32 tex_width, tex_height, tex_channels;
-        stbi_uc* pixels = stbi_load(TEXTURE_PATH.c_str(), &tex_width, &tex_height, &tex_channels, STBI_rgb_alpha);
-        VkDeviceSize image_size = static_cast<u64>(tex_width) * static_cast<u64>(tex_height) * 4lu;
-
+        stbi_uc* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file.bytes.data()), static_cast<i32>(file.bytes.size()),
+                &tex_width, &tex_height, &tex_channels, STBI_rgb_alpha);
         if (!pixels) {
-            fmt::println("failed to load texture image!");
+            fmt::println("failed to load texture image {}!", path);
             std::abort();
         }
-
-        std::unique_ptr<VkBuffer_T, VKEBufferDeleter> staging_buffer(nullptr);
-        std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> staging_buffer_memory(nullptr);
-
-        create_buffer(image_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging_buffer, staging_buffer_memory);
-
-        void* data;
-        vkMapMemory(logical_device.get(), staging_buffer_memory.get(), 0, image_size, 0, &data); {
-            memcpy(data, pixels, static_cast<size_t>(image_size));
-        } vkUnmapMemory(logical_device.get(), staging_buffer_memory.get());
-        stbi_image_free(pixels);
-
-        create_image(static_cast<u32>(tex_width), static_cast<u32>(tex_height), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, texture_image, texture_image_memory);
-
-        transition_image_layout(texture_image.get(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL); {
-            copy_buffer_to_image(staging_buffer.get(), texture_image.get(), static_cast<u32>(tex_width), static_cast<u32>(tex_height));
-        } transition_image_layout(texture_image.get(), VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        return DecodedTexture{std::unique_ptr<u8, STBImageDeleter>(pixels), static_cast<u32>(tex_width), static_cast<u32>(tex_height)};
+    }
+    auto Instance::generate_texture(u32 index) -> DecodedTexture {
+        constexpr u32 size = BENCHMARK_TEXTURE_SIZE;
+        // stbi_image_free is free() unless STBI_FREE is overridden, the deleter releases these like decoded images
+        auto* pixels = static_cast<u8*>(std::malloc(static_cast<size_t>(size) * size * 4));
+        if (!pixels) {
+            fmt::println("failed to allocate benchmark texture {}!", index);
+            std::abort();
+        }
+        // a different color per index from a multiplicative hash
+        u32 color = (index + 1) * 2654435761u;
+        for (u32 y = 0; y < size; y++) {
+            for (u32 x = 0; x < size; x++) {
+                u8* texel = pixels + (static_cast<size_t>(y) * size + x) * 4;
+                u8 shade = ((x / 8 + y / 8) % 2 == 0) ? 255 : 160;
+                texel[0] = static_cast<u8>(((color >> 24) & 0xff) * shade / 255);
+                texel[1] = static_cast<u8>(((color >> 16) & 0xff) * shade / 255);
+                texel[2] = static_cast<u8>(((color >> 8) & 0xff) * shade / 255);
+                texel[3] = 255;
+            }
+        }
+        return DecodedTexture{std::unique_ptr<u8, STBImageDeleter>(pixels), size, size};
+    }
+    auto Instance::load_texture(UploadBatch& upload, const DecodedTexture& decoded) -> Texture {
+        Texture texture{};
+        VkDeviceSize image_size = static_cast<u64>(decoded.width) * static_cast<u64>(decoded.height) * 4lu;
+        create_image(decoded.width, decoded.height, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::texture, texture.image, texture.memory);
+        upload_image(upload, texture.image.get(), decoded.pixels.get(), image_size, decoded.width, decoded.height);
+        return texture;
+    }
+    void Instance::create_texture_image(std::span<const DecodedTexture> decoded) {
+        UploadBatch upload = begin_upload();
+        for (const auto& image : decoded) {
+            textures.push_back(load_texture(upload, image));
+        }
+        submit_upload(std::move(upload));
     }
-    void Instance::create_image(u32 width, u32 height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, std::unique_ptr<VkImage_T, VKEImageDeleter>& image, std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>& image_memory) {
+    void Instance::create_image(u32 width, u32 height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, MemoryCategory category, std::unique_ptr<VkImage_T, VKEImageDeleter>& image, std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>& image_memory, u32 mip_levels) {
         VkImageCreateInfo image_info{};
         image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         image_info.imageType = VK_IMAGE_TYPE_2D;
         image_info.extent.width = static_cast<uint32_t>(width);
         image_info.extent.height = static_cast<uint32_t>(height);
         image_info.extent.depth = 1;
-        image_info.mipLevels = 1;
+        image_info.mipLevels = mip_levels;
         image_info.arrayLayers = 1;
         image_info.format = format;
         image_info.tiling = tiling;
@@ -268,105 +469,409 @@ namespace vke {
         VkMemoryRequirements mem_requirements;
         vkGetImageMemoryRequirements(logical_device.get(), image.get(), &mem_requirements);
 
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = mem_requirements.size;
-        alloc_info.memoryTypeIndex = find_memory_type(mem_requirements.memoryTypeBits, properties);
-
-        result = vkAllocateMemory(logical_device.get(), &alloc_info, nullptr, reinterpret_cast<VkDeviceMemory*>(&image_memory));
-        VKE_RESULT_CRASH(result);
+        image_memory = allocate_memory(mem_requirements, properties, category);
         vkBindImageMemory(logical_device.get(), image.get(), image_memory.get(), 0);
 
     }
-    void Instance::create_descriptor_sets() {
-        std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptor_set_layout.get());
-        VkDescriptorSetAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        alloc_info.descriptorPool = descriptor_pool.get();
-        alloc_info.descriptorSetCount = static_cast<u32>(MAX_FRAMES_IN_FLIGHT);
-        alloc_info.pSetLayouts = layouts.data();
-
-        descriptor_sets.resize(MAX_FRAMES_IN_FLIGHT);
-        vke::Result result = vkAllocateDescriptorSets(logical_device.get(), &alloc_info, descriptor_sets.data());
-        VKE_RESULT_CRASH(result);
-
+    void Instance::create_descriptor_sets(Viewport& viewport) {
+        viewport.descriptor_sets.resize(MAX_FRAMES_IN_FLIGHT);
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            VkDescriptorBufferInfo buffer_info{};
-            buffer_info.buffer = uniform_buffers[i].get();
-            buffer_info.offset = 0;
-            buffer_info.range = sizeof(UniformBufferObject);
+            DescriptorSetKey key{descriptor_set_layout, {
+                DescriptorWrite{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, viewport.uniform_buffers[i].get(), 0, sizeof(CameraMatrices)}
+            }};
+            viewport.descriptor_sets[i] = descriptor_cache.set(key, [this](const DescriptorSetKey& k) {
+                VkDescriptorSet set = static_descriptors.allocate(k.layout);
+
+                VkDescriptorBufferInfo buffer_info{};
+                buffer_info.buffer = static_cast<VkBuffer>(k.writes[0].handle);
+                buffer_info.offset = k.writes[0].offset;
+                buffer_info.range = k.writes[0].range;
+
+                VkWriteDescriptorSet descriptor_write{};
+                descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                descriptor_write.dstSet = set;
+                descriptor_write.dstBinding = k.writes[0].binding;
+                descriptor_write.dstArrayElement = 0;
+                descriptor_write.descriptorType = k.writes[0].type;
+                descriptor_write.descriptorCount = 1;
+                descriptor_write.pBufferInfo = &buffer_info;
+
+                vkUpdateDescriptorSets(logical_device.get(), 1, &descriptor_write, 0, nullptr);
+                return set;
+            });
+        }
+    }
+    auto Instance::register_texture(VkImageView view) -> u32 {
+        std::optional<u32> slot = texture_slots.allocate();
+        if (!slot) {
+            fmt::println("bindless texture array is full ({} textures)", MAX_BINDLESS_TEXTURES);
+            std::abort();
+        }
 
-            VkDescriptorImageInfo image_info{};
-            image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            image_info.imageView = texture_image_view.get();
-            image_info.sampler = texture_sampler.get();
+        VkDescriptorImageInfo image_info{};
+        image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        image_info.imageView = view;
+        image_info.sampler = texture_sampler.get();
+
+        VkWriteDescriptorSet descriptor_write{};
+        descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet = bindless_set;
+        descriptor_write.dstBinding = bindless_textures;
+        descriptor_write.dstArrayElement = *slot;
+        descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptor_write.descriptorCount = 1;
+        descriptor_write.pImageInfo = &image_info;
+
+        // update after bind: safe while the set is bound in command buffers that don't use this slot
+        vkUpdateDescriptorSets(logical_device.get(), 1, &descriptor_write, 0, nullptr);
+        return *slot;
+    }
+    auto Instance::register_storage_buffer(VkBuffer buffer, VkDeviceSize range) -> u32 {
+        std::optional<u32> slot = storage_buffer_slots.allocate();
+        if (!slot) {
+            fmt::println("bindless storage buffer array is full ({} buffers)", MAX_BINDLESS_STORAGE_BUFFERS);
+            std::abort();
+        }
 
-            std::array<VkWriteDescriptorSet, 2> descriptor_writes{};
+        VkDescriptorBufferInfo buffer_info{};
+        buffer_info.buffer = buffer;
+        buffer_info.offset = 0;
+        buffer_info.range = range;
+
+        VkWriteDescriptorSet descriptor_write{};
+        descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet = bindless_set;
+        descriptor_write.dstBinding = bindless_storage_buffers;
+        descriptor_write.dstArrayElement = *slot;
+        descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptor_write.descriptorCount = 1;
+        descriptor_write.pBufferInfo = &buffer_info;
+
+        vkUpdateDescriptorSets(logical_device.get(), 1, &descriptor_write, 0, nullptr);
+        return *slot;
+    }
+    void Instance::create_object_buffer() {
+        objects.resize(object_grid * object_grid);
+        constexpr f32 spacing = 2.5f;
+        const f32 offset = spacing * static_cast<f32>(object_grid - 1) / 2.0f;
+        for (u32 i = 0; i < objects.size(); i++) {
+            glm::vec3 position(spacing * static_cast<f32>(i % object_grid) - offset, spacing * static_cast<f32>(i / object_grid) - offset, 0.0f);
+            objects[i].model = glm::translate(glm::mat4(1.0f), position);
+            objects[i].texture_index = textures[i % textures.size()].slot;
+        }
 
-            descriptor_writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptor_writes[0].dstSet = descriptor_sets[i];
-            descriptor_writes[0].dstBinding = 0;
-            descriptor_writes[0].dstArrayElement = 0;
-            descriptor_writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-            descriptor_writes[0].descriptorCount = 1;
-            descriptor_writes[0].pBufferInfo = &buffer_info;
+        VkDeviceSize buffer_size = sizeof(objects[0]) * objects.size();
+        create_buffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::storage, object_buffer, object_buffer_memory);
 
-            descriptor_writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptor_writes[1].dstSet = descriptor_sets[i];
-            descriptor_writes[1].dstBinding = 1;
-            descriptor_writes[1].dstArrayElement = 0;
-            descriptor_writes[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            descriptor_writes[1].descriptorCount = 1;
-            descriptor_writes[1].pImageInfo = &image_info;
+        UploadBatch upload = begin_upload();
+        upload_buffer(upload, object_buffer.get(), objects.data(), buffer_size, VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT);
+        submit_upload(std::move(upload));
+        object_buffer_slot = register_storage_buffer(object_buffer.get(), buffer_size);
+    }
+    void Instance::create_cull_buffers() {
+        std::vector<ObjectBounds> bounds(objects.size());
+        for (u32 i = 0; i < objects.size(); i++) {
+            bounds[i] = transform_bounds(mesh_bounds, objects[i].model);
+        }
 
+        VkDeviceSize bounds_size = sizeof(bounds[0]) * bounds.size();
+        create_buffer(bounds_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::storage, object_bounds_buffer, object_bounds_memory);
+        UploadBatch upload = begin_upload();
+        upload_buffer(upload, object_bounds_buffer.get(), bounds.data(), bounds_size, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT);
+        submit_upload(std::move(upload));
+        object_bounds_slot = register_storage_buffer(object_bounds_buffer.get(), bounds_size);
 
-            vkUpdateDescriptorSets(logical_device.get(), static_cast<u32>(descriptor_writes.size()), descriptor_writes.data(), 0, nullptr);
+        for (auto& viewport : viewports) {
+            create_draw_buffers(*viewport);
         }
-
     }
-    void Instance::create_descriptor_pool() {
-        std::array<VkDescriptorPoolSize, 2> pool_sizes{};
-        pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        pool_sizes[0].descriptorCount = static_cast<u32>(MAX_FRAMES_IN_FLIGHT);
-        pool_sizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        pool_sizes[1].descriptorCount = static_cast<u32>(MAX_FRAMES_IN_FLIGHT);
-
-        VkDescriptorPoolCreateInfo pool_info{};
-        pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        pool_info.poolSizeCount = static_cast<u32>(pool_sizes.size());
-        pool_info.pPoolSizes = pool_sizes.data();
-        pool_info.maxSets = static_cast<u32>(MAX_FRAMES_IN_FLIGHT);
-
-        vke::Result result = vkCreateDescriptorPool(logical_device.get(), &pool_info, nullptr, reinterpret_cast<VkDescriptorPool*>(&descriptor_pool));
+    void Instance::create_draw_buffers(Viewport& viewport) {
+        // every object is visible last frame before the first frame
+        std::vector<u32> visibility(objects.size(), 1);
+        VkDeviceSize visibility_size = sizeof(visibility[0]) * visibility.size();
+        create_buffer(visibility_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::storage, viewport.visibility_buffer, viewport.visibility_memory);
+        UploadBatch upload = begin_upload();
+        upload_buffer(upload, viewport.visibility_buffer.get(), visibility.data(), visibility_size, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT);
+        submit_upload(std::move(upload));
+        viewport.visibility_slot = register_storage_buffer(viewport.visibility_buffer.get(), visibility_size);
+
+        // room for every object in both phases, the counts at the front are cleared by the early phase
+        VkDeviceSize draws_size = CULL_DRAWS_OFFSET + 2 * sizeof(VkDrawIndexedIndirectCommand) * objects.size();
+        viewport.draw_buffers.resize(MAX_FRAMES_IN_FLIGHT);
+        viewport.draw_buffers_memory.resize(MAX_FRAMES_IN_FLIGHT);
+        viewport.draw_buffer_slots.resize(MAX_FRAMES_IN_FLIGHT);
+        for (const auto& [buffer, buffer_memory, slot] : std::views::zip(viewport.draw_buffers, viewport.draw_buffers_memory, viewport.draw_buffer_slots)) {
+            create_buffer(draws_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::storage, buffer, buffer_memory);
+            slot = register_storage_buffer(buffer.get(), draws_size);
+        }
+    }
+    void Instance::create_frame_stats() {
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(physical_device, &properties);
+        timestamp_period = properties.limits.timestampComputeAndGraphics ? properties.limits.timestampPeriod : 0.0f;
+
+        VkQueryPoolCreateInfo query_pool_info{};
+        query_pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        query_pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        query_pool_info.queryCount = 2 * MAX_FRAMES_IN_FLIGHT;
+        vke::Result result = vkCreateQueryPool(logical_device.get(), &query_pool_info, nullptr, reinterpret_cast<VkQueryPool*>(&timestamp_pool));
         VKE_RESULT_CRASH(result);
     }
-    void Instance::update_uniform_buffer(u32 current_image) {
-        static auto start_time = std::chrono::high_resolution_clock::now();
+    void Instance::create_stats_buffers(Viewport& viewport) {
+        // the late cull pass copies both draw counts here
+        VkDeviceSize buffer_size = 2 * sizeof(u32);
+        viewport.stats_buffers.resize(MAX_FRAMES_IN_FLIGHT);
+        viewport.stats_buffers_memory.resize(MAX_FRAMES_IN_FLIGHT);
+        viewport.stats_buffers_mapped.resize(MAX_FRAMES_IN_FLIGHT);
+        for (const auto& [buffer, buffer_memory, buffer_map] : std::views::zip(viewport.stats_buffers, viewport.stats_buffers_memory, viewport.stats_buffers_mapped)) {
+            create_buffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                    | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    MemoryCategory::storage,
+                    buffer,
+                    buffer_memory);
+            vkMapMemory(logical_device.get(), buffer_memory.get(), 0, buffer_size, 0, &buffer_map);
+            memset(buffer_map, 0, buffer_size);
+        }
+    }
+    void Instance::read_frame_stats() {
+        u64 triangles_per_object = indices.size() / 3;
+        u64 views = 0;
+        frame_stats.early_draws = 0;
+        frame_stats.late_draws = 0;
+        for (auto& viewport : viewports) {
+            if (!viewport->drawn[current_frame]) { continue; }
+            viewport->drawn[current_frame] = false;
+            std::array<u32, 2> counts{};
+            memcpy(counts.data(), viewport->stats_buffers_mapped[current_frame], sizeof(counts));
+            frame_stats.early_draws += counts[cull_early];
+            frame_stats.late_draws += counts[cull_late];
+            views++;
+        }
+        frame_stats.triangles = (u64{frame_stats.early_draws} + frame_stats.late_draws) * triangles_per_object;
+        frame_stats.culled_triangles = views * objects.size() * triangles_per_object - frame_stats.triangles;
+        if (views == 0) { return; }
+
+        bool timed = false;
+        if (timestamps_written[current_frame]) {
+            std::array<u64, 2> timestamps{};
+            vke::Result result = dispatch.GetQueryPoolResults(logical_device.get(), timestamp_pool.get(), current_frame * 2, 2,
+                    sizeof(timestamps), timestamps.data(), sizeof(u64), VK_QUERY_RESULT_64_BIT);
+            // the fence was waited on, VK_NOT_READY only happens if the frame was never submitted
+            if (result == VK_SUCCESS) {
+                frame_stats.gpu_ms = static_cast<f64>(timestamps[1] - timestamps[0]) * timestamp_period / 1e6;
+                timed = true;
+            }
+        }
+        (frame_culling[current_frame] ? culled_totals : unculled_totals).add(frame_stats, timed);
+    }
+    void FrameStatsTotals::add(const FrameStats& stats, bool timed) {
+        frames++;
+        draws += u64{stats.early_draws} + stats.late_draws;
+        triangles += stats.triangles;
+        culled_triangles += stats.culled_triangles;
+        if (!timed) { return; }
+        timed_frames++;
+        gpu_ms += stats.gpu_ms;
+        gpu_ms_max = std::max(gpu_ms_max, stats.gpu_ms);
+    }
+    void print_frame_stats(const FrameStatsTotals& culled, const FrameStatsTotals& unculled) {
+        auto print = [](std::string_view name, const FrameStatsTotals& totals) {
+            if (totals.frames == 0) { return; }
+            f64 frames = static_cast<f64>(totals.frames);
+            fmt::println("  culling {}: {} frames, gpu mean {:.3f} ms, max {:.3f} ms, {:.0f} draws, {:.0f} triangles drawn, {:.0f} culled per frame",
+                    name, totals.frames, totals.mean_gpu_ms(), totals.gpu_ms_max, static_cast<f64>(totals.draws) / frames,
+                    static_cast<f64>(totals.triangles) / frames, static_cast<f64>(totals.culled_triangles) / frames);
+        };
+        fmt::println("frame stats:");
+        print("on", culled);
+        print("off", unculled);
+        if (culled.timed_frames > 0 && unculled.timed_frames > 0) {
+            f64 saved = unculled.mean_gpu_ms() - culled.mean_gpu_ms();
+            fmt::println("  culling saves {:.3f} ms of gpu time per frame ({:.1f}%)", saved, saved * 100.0 / unculled.mean_gpu_ms());
+        }
+    }
+    void Instance::request_capture(std::filesystem::path path) {
+        pending_captures.push_back(std::move(path));
+    }
+    void Instance::capture_continuously(std::filesystem::path directory, u32 interval) {
+        capture_directory = std::move(directory);
+        capture_interval = interval;
+    }
+    auto Instance::begin_readback(const Viewport& viewport) -> ReadbackSlot* {
+        bool requested = !pending_captures.empty();
+        bool continuous = capture_interval > 0 && frames_drawn % capture_interval == 0;
+        if (!requested && !continuous) { return nullptr; }
+        auto begin = std::chrono::steady_clock::now();
+
+        auto order = readback_pixel_order(viewport.swapchain_image_format);
+        if (!viewport.swapchain_readable || !order) {
+            fmt::println("the swapchain cannot be read back, dropping {} captures", pending_captures.size() + (continuous ? 1 : 0));
+            pending_captures.clear();
+            capture_interval = 0;
+            return nullptr;
+        }
+        auto slot = std::ranges::find_if(readback_slots, [](const ReadbackSlot& slot) {
+                return slot.state.load(std::memory_order_acquire) == ReadbackState::free;
+                });
+        if (slot == readback_slots.end()) {
+            // every slot is in flight or still being encoded, requested captures wait, continuous ones are skipped
+            if (!requested) { captures_skipped++; }
+            return nullptr;
+        }
 
-        auto current_time = std::chrono::high_resolution_clock::now();
-        float time = std::chrono::duration<float, std::chrono::seconds::period>(current_time - start_time).count();
+        VkDeviceSize size = VkDeviceSize{viewport.swapchain_extent.width} * viewport.swapchain_extent.height * 4;
+        if (slot->size < size) {
+            // the worker reads every byte, uncached reads would make encoding several times slower
+            VkPhysicalDeviceMemoryProperties mem_properties;
+            vkGetPhysicalDeviceMemoryProperties(physical_device, &mem_properties);
+            VkMemoryPropertyFlags cached = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            bool has_cached = std::ranges::any_of(std::span(mem_properties.memoryTypes, mem_properties.memoryTypeCount),
+                    [&](const VkMemoryType& type) { return (type.propertyFlags & cached) == cached; });
+            slot->mapped = nullptr;
+            create_buffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                    has_cached ? cached : VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    MemoryCategory::staging,
+                    slot->buffer,
+                    slot->memory);
+            vkMapMemory(logical_device.get(), slot->memory.get(), 0, VK_WHOLE_SIZE, 0, &slot->mapped);
+            slot->size = size;
+        }
+        if (requested) {
+            slot->path = std::move(pending_captures.front());
+            pending_captures.pop_front();
+        } else {
+            slot->path = capture_directory / fmt::format("frame_{:06}.qoi", frames_drawn);
+        }
+        slot->extent = viewport.swapchain_extent;
+        slot->order = *order;
+        slot->frame = current_frame;
+        slot->state.store(ReadbackState::copying, std::memory_order_relaxed);
+        frame_stats.capture_ms += std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        return &*slot;
+    }
+    void Instance::record_readback(const Viewport& viewport, VkCommandBuffer command_buffer) {
+        // the graph moved the swapchain image to TRANSFER_SRC and back to PRESENT_SRC after this pass
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {frame_readback->extent.width, frame_readback->extent.height, 1};
+        dispatch.CmdCopyImageToBuffer(command_buffer, viewport.swapchain_images[viewport.image_index], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                frame_readback->buffer.get(), 1, &region);
+
+        VkBufferMemoryBarrier2 barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+        barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = frame_readback->buffer.get();
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+        VkDependencyInfo dependency{};
+        dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.bufferMemoryBarrierCount = 1;
+        dependency.pBufferMemoryBarriers = &barrier;
+        dispatch.CmdPipelineBarrier2(command_buffer, &dependency);
+    }
+    void Instance::collect_readbacks() {
+        auto begin = std::chrono::steady_clock::now();
+        for (auto& slot : readback_slots) {
+            if (slot.frame != current_frame || slot.state.load(std::memory_order_acquire) != ReadbackState::copying) { continue; }
+            // a no-op for coherent memory, required for the host cached types
+            VkMappedMemoryRange range{};
+            range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+            range.memory = slot.memory.get();
+            range.offset = 0;
+            range.size = VK_WHOLE_SIZE;
+            dispatch.InvalidateMappedMemoryRanges(logical_device.get(), 1, &range);
+
+            slot.state.store(ReadbackState::encoding, std::memory_order_relaxed);
+            u32 row_pitch = slot.extent.width * 4;
+            PixelView image{slot.extent.width, slot.extent.height, row_pitch, slot.order,
+                std::span(static_cast<const std::byte*>(slot.mapped), static_cast<size_t>(row_pitch) * slot.extent.height)};
+            // the pixels are handed over in place, the worker frees the slot once it encoded them
+            image_exporter.submit(ExportJob{slot.path, image, [&slot] { slot.state.store(ReadbackState::free, std::memory_order_release); }});
+        }
+        frame_stats.capture_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+    void Instance::create_descriptor_pool() {
+        // pools grow on demand, the ratios only shape how many descriptors of each type a pool holds per set
+        std::vector<DescriptorAllocator::PoolRatio> ratios = {
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f},
+        };
+        static_descriptors.init(logical_device.get(), ratios);
+        for (auto& allocator : frame_descriptors) {
+            allocator.init(logical_device.get(), ratios);
+        }
+
+        std::array<VkDescriptorPoolSize, 2> bindless_pool_sizes{};
+        bindless_pool_sizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindless_pool_sizes[0].descriptorCount = MAX_BINDLESS_TEXTURES;
+        bindless_pool_sizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindless_pool_sizes[1].descriptorCount = MAX_BINDLESS_STORAGE_BUFFERS;
 
-        UniformBufferObject ubo{};
-        ubo.model = glm::rotate(glm::mat4(1.0f), time * glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-        ubo.view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-        ubo.proj = glm::perspective(glm::radians(45.0f), static_cast<float>(swapchain_extent.width) / static_cast<float>(swapchain_extent.height), 0.1f, 10.0f);
-        // ubo.model = glm::mat4(1.0);
-        // ubo.view = glm::mat4(1.0);
-        // ubo.proj = glm::mat4(1.0);
+        VkDescriptorPoolCreateInfo bindless_pool_info{};
+        bindless_pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        bindless_pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        bindless_pool_info.poolSizeCount = static_cast<u32>(bindless_pool_sizes.size());
+        bindless_pool_info.pPoolSizes = bindless_pool_sizes.data();
+        bindless_pool_info.maxSets = 1;
 
-        ubo.proj[1][1] *= -1;
-        memcpy(uniform_buffers_mapped[current_image], &ubo, sizeof(ubo));
+        vke::Result result = vkCreateDescriptorPool(logical_device.get(), &bindless_pool_info, nullptr, reinterpret_cast<VkDescriptorPool*>(&bindless_pool));
+        VKE_RESULT_CRASH(result);
+
+        // one global set for every texture and object buffer of every viewport, slots are written as resources are registered
+        VkDescriptorSetAllocateInfo bindless_alloc_info{};
+        bindless_alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        bindless_alloc_info.descriptorPool = bindless_pool.get();
+        bindless_alloc_info.descriptorSetCount = 1;
+        bindless_alloc_info.pSetLayouts = &bindless_set_layout;
+        result = vkAllocateDescriptorSets(logical_device.get(), &bindless_alloc_info, &bindless_set);
+        VKE_RESULT_CRASH(result);
     }
-    void Instance::create_uniform_buffers() {
-        VkDeviceSize buffer_size = sizeof(UniformBufferObject);
-        uniform_buffers.resize(MAX_FRAMES_IN_FLIGHT);
-        uniform_buffers_memory.resize(MAX_FRAMES_IN_FLIGHT);
-        uniform_buffers_mapped.resize(MAX_FRAMES_IN_FLIGHT);
+    auto Instance::allocate_frame_descriptor_set(VkDescriptorSetLayout layout) -> VkDescriptorSet {
+        return frame_descriptors[current_frame].allocate(layout);
+    }
+    auto Instance::descriptor_stats() const -> DescriptorStats {
+        DescriptorStats stats{};
+        stats.allocations = static_descriptors.allocations;
+        stats.pool_count = static_descriptors.pool_count();
+        for (const auto& allocator : frame_descriptors) {
+            stats.allocations += allocator.allocations;
+            stats.pool_count += allocator.pool_count();
+        }
+        stats.cache_hits = descriptor_cache.hits;
+        stats.cache_misses = descriptor_cache.misses;
+        return stats;
+    }
+    void Instance::update_uniform_buffer(Viewport& viewport, u32 current_image) {
+        // the rotation changes every frame, it travels in the draw's push constants
+        frame_model = glm::rotate(glm::mat4(1.0f), scene_rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+
+        CameraTracker& camera_tracker = viewport.camera_tracker;
+        camera_tracker.set_extent(viewport.swapchain_extent);
+        if (camera_tracker.consume(current_image)) {
+            memcpy(viewport.uniform_buffers_mapped[current_image], &camera_tracker.matrices, sizeof(CameraMatrices));
+        }
+        // the scene rotation is folded in so object bounds can stay in grid space
+        viewport.view_proj = camera_tracker.matrices.proj * camera_tracker.matrices.view * frame_model;
+    }
+    void Instance::create_uniform_buffers(Viewport& viewport) {
+        VkDeviceSize buffer_size = sizeof(CameraMatrices);
+        viewport.uniform_buffers.resize(MAX_FRAMES_IN_FLIGHT);
+        viewport.uniform_buffers_memory.resize(MAX_FRAMES_IN_FLIGHT);
+        viewport.uniform_buffers_mapped.resize(MAX_FRAMES_IN_FLIGHT);
 
-        for (const auto& [buffer, buffer_memory, buffer_map] : std::views::zip(uniform_buffers, uniform_buffers_memory, uniform_buffers_mapped)) {
+        for (const auto& [buffer, buffer_memory, buffer_map] : std::views::zip(viewport.uniform_buffers, viewport.uniform_buffers_memory, viewport.uniform_buffers_mapped)) {
             create_buffer(buffer_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT 
                     | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    MemoryCategory::uniform,
                     buffer,
                     buffer_memory);
 
@@ -375,30 +880,29 @@ namespace vke {
         }
     }
     void Instance::create_descriptor_set_layout() {
-        VkDescriptorSetLayoutBinding ubo_layout_binding{};
-        ubo_layout_binding.binding = 0;
-        ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        ubo_layout_binding.descriptorCount = 1;
-        ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
-        VkDescriptorSetLayoutBinding sampler_layout_binding{};
-        sampler_layout_binding.binding = 1;
-        sampler_layout_binding.descriptorCount = 1;
-        sampler_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        sampler_layout_binding.pImmutableSamplers = nullptr;
-        sampler_layout_binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-        std::array<VkDescriptorSetLayoutBinding, 2> bindings = {ubo_layout_binding, sampler_layout_binding};
-
-        VkDescriptorSetLayoutCreateInfo layout_info{};
-        layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layout_info.bindingCount = static_cast<u32>(bindings.size());
-        layout_info.pBindings = bindings.data();
-        vke::Result result = vkCreateDescriptorSetLayout(logical_device.get(), &layout_info, nullptr, reinterpret_cast<VkDescriptorSetLayout*>(&descriptor_set_layout));
-        VKE_RESULT_CRASH(result);
+        descriptor_cache.device = logical_device.get();
+        descriptor_set_layout = descriptor_cache.layout(DescriptorLayoutKey({
+            {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT},
+        }));
+
+        // unwritten slots are never accessed, written ones may change while the set is bound
+        constexpr VkDescriptorBindingFlags bindless_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+        bindless_set_layout = descriptor_cache.layout(DescriptorLayoutKey({
+            {bindless_textures, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_BINDLESS_TEXTURES, VK_SHADER_STAGE_FRAGMENT_BIT, bindless_flags},
+            {bindless_storage_buffers, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_BINDLESS_STORAGE_BUFFERS, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT, bindless_flags},
+        }, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT));
+
+        // the compute layouts live here too, the cache is not thread safe and the pipelines are built concurrently
+        cull_set_layout = descriptor_cache.layout(DescriptorLayoutKey({
+            {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+        }));
+        hiz_set_layout = descriptor_cache.layout(DescriptorLayoutKey({
+            {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+            {1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT},
+        }));
     };
 
-    void Instance::create_buffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, std::unique_ptr<VkBuffer_T, VKEBufferDeleter>& buffer, std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>& buffer_memory) {
+    void Instance::create_buffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, MemoryCategory category, std::unique_ptr<VkBuffer_T, VKEBufferDeleter>& buffer, std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>& buffer_memory) {
         VkBufferCreateInfo buffer_info{};
         buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         buffer_info.size = size;
@@ -412,17 +916,8 @@ namespace vke {
         VkMemoryRequirements mem_requirements;
         vkGetBufferMemoryRequirements(logical_device.get(), buffer.get(), &mem_requirements);
 
-        VkMemoryAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        alloc_info.allocationSize = mem_requirements.size;
-        alloc_info.memoryTypeIndex = find_memory_type(mem_requirements.memoryTypeBits, properties);
-
         buffer_memory.reset(nullptr);
-        result = vkAllocateMemory(logical_device.get(), &alloc_info, nullptr, reinterpret_cast<VkDeviceMemory*>(&buffer_memory));
-        if (result != VK_SUCCESS) {
-            fmt::println("failed to allocate vertex buffer memory!");
-            VKE_RESULT_CRASH(result);
-        }
+        buffer_memory = allocate_memory(mem_requirements, properties, category);
         vkBindBufferMemory(logical_device.get(), buffer.get(), buffer_memory.get(), 0);
 
     }
@@ -440,186 +935,533 @@ namespace vke {
         std::abort();
 
     }
-    auto Instance::copy_buffer(VkBuffer src_buffer, VkBuffer dst_buffer, VkDeviceSize size) const -> void {
-        VkCommandBuffer command_buffer = begin_single_time_commands();
+    auto Instance::allocate_memory(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, MemoryCategory category) -> std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> {
+        VkPhysicalDeviceMemoryProperties mem_properties;
+        vkGetPhysicalDeviceMemoryProperties(physical_device, &mem_properties);
 
-        VkBufferCopy copy_region{};
-        copy_region.size = size;
-        vkCmdCopyBuffer(command_buffer, src_buffer, dst_buffer, 1, &copy_region);
+        VkMemoryAllocateInfo alloc_info{};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = requirements.size;
+        alloc_info.memoryTypeIndex = find_memory_type(requirements.memoryTypeBits, properties);
+        u32 heap = mem_properties.memoryTypes[alloc_info.memoryTypeIndex].heapIndex;
 
-        end_single_time_commands(command_buffer);
+        // near the soft limit the numbers from the last refresh are too coarse, the budget may have moved since
+        if (memory_budget.excess(heap, requirements.size) > 0) {
+            refresh_memory_budget();
+        }
+
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        vke::Result result = vkAllocateMemory(logical_device.get(), &alloc_info, nullptr, &memory);
+        if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY || result == VK_ERROR_OUT_OF_HOST_MEMORY) {
+            // cleanup pass, the budget was stale or another process took the memory
+            memory_budget.on_failure();
+            refresh_memory_budget();
+            result = vkAllocateMemory(logical_device.get(), &alloc_info, nullptr, &memory);
+        }
+        if (result != VK_SUCCESS) {
+            memory_budget.on_failure();
+            fmt::println("failed to allocate {} bytes of {} memory on heap {}!", requirements.size, memory_category_name(category), heap);
+            print_memory_stats(memory_budget.snapshot());
+            VKE_RESULT_CRASH(result);
+        }
+        memory_budget.on_allocate(memory, heap, category, requirements.size);
+        return std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter>(memory);
+    }
+    void Instance::refresh_memory_budget() {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget_properties{};
+        budget_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        VkPhysicalDeviceMemoryProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        properties.pNext = memory_budget_extension ? &budget_properties : nullptr;
+        instance_dispatch.GetPhysicalDeviceMemoryProperties2(physical_device, &properties);
+
+        u32 heap_count = properties.memoryProperties.memoryHeapCount;
+        std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> sizes{};
+        for (u32 heap = 0; heap < heap_count; heap++) {
+            sizes[heap] = properties.memoryProperties.memoryHeaps[heap].size;
+        }
+        if (memory_budget_extension) {
+            memory_budget.update_heaps(std::span(sizes.data(), heap_count), std::span(budget_properties.heapBudget, heap_count), std::span(budget_properties.heapUsage, heap_count));
+        } else {
+            memory_budget.update_heaps(std::span(sizes.data(), heap_count), {}, {});
+        }
     }
     void Instance::create_index_buffer() {
         VkDeviceSize buffer_size = sizeof(indices[0]) * indices.size();
-        std::unique_ptr<VkBuffer_T, VKEBufferDeleter> staging_buffer(nullptr);
-        std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> staging_buffer_memory(nullptr);
-        create_buffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging_buffer, staging_buffer_memory);
+        create_buffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::index, index_buffer, index_buffer_memory);
 
-
-        void* data;
-        vkMapMemory(logical_device.get(), staging_buffer_memory.get(), 0, buffer_size, 0, &data); {
-            memcpy(data, indices.data(), static_cast<size_t>(buffer_size));
-        } vkUnmapMemory(logical_device.get(), staging_buffer_memory.get());
-
-        create_buffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, index_buffer, index_buffer_memory);
-
-        copy_buffer(staging_buffer.get(), index_buffer.get(), buffer_size);
+        UploadBatch upload = begin_upload();
+        upload_buffer(upload, index_buffer.get(), indices.data(), buffer_size, VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_INDEX_READ_BIT);
+        submit_upload(std::move(upload));
     }
     void Instance::create_vertex_buffer() {
         VkDeviceSize buffer_size = sizeof(vertices[0]) * vertices.size();
-        std::unique_ptr<VkBuffer_T, VKEBufferDeleter> staging_buffer(nullptr);
-        std::unique_ptr<VkDeviceMemory_T, VKEMemoryDeleter> staging_buffer_memory(nullptr);
-        create_buffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, staging_buffer, staging_buffer_memory);
-
-
-        void* data;
-        vkMapMemory(logical_device.get(), staging_buffer_memory.get(), 0, buffer_size, 0, &data); {
-            memcpy(data, vertices.data(), static_cast<size_t>(buffer_size));
-        } vkUnmapMemory(logical_device.get(), staging_buffer_memory.get());
+        create_buffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::vertex, vertex_buffer, vertex_buffer_memory);
 
-        create_buffer(buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertex_buffer, vertex_buffer_memory);
-
-        copy_buffer(staging_buffer.get(), vertex_buffer.get(), buffer_size);
+        UploadBatch upload = begin_upload();
+        upload_buffer(upload, vertex_buffer.get(), vertices.data(), buffer_size, VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+        submit_upload(std::move(upload));
     }
 
     void Instance::draw_frame() {
-        vkWaitForFences(logical_device.get(), 1, 
+        dispatch.WaitForFences(logical_device.get(), 1, 
                 reinterpret_cast<const VkFence*>(&in_flight_fences[current_frame]),
                 VK_TRUE, UINT64_MAX);
 
-        u32 image_index;
-        vke::Result result = vkAcquireNextImageKHR(logical_device.get(),
-                swapchain.get(), UINT64_MAX,
-                image_available_semaphores[current_frame].get(), 
-                VK_NULL_HANDLE, &image_index);
-
-        if (result == VK_ERROR_OUT_OF_DATE_KHR ) {
-            frame_buffer_resized = false;
-            recreate_swapchain();
-            return;
-        } else if (result != VK_SUCCESS) {
-            VKE_RESULT_CRASH(result);
+        // every window acquires before anything is recorded, one whose swapchain is out of date sits this frame out
+        bool any_acquired = false;
+        for (auto& viewport : viewports) {
+            viewport->acquired = false;
+            vke::Result result = dispatch.AcquireNextImageKHR(logical_device.get(),
+                    viewport->swapchain.get(), UINT64_MAX,
+                    viewport->image_available_semaphores[current_frame].get(), 
+                    VK_NULL_HANDLE, &viewport->image_index);
+
+            if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+                viewport->frame_buffer_resized = false;
+                recreate_swapchain(*viewport);
+                continue;
+            } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+                VKE_RESULT_CRASH(result);
+            }
+            viewport->acquired = true;
+            any_acquired = true;
         }
-
-        update_uniform_buffer(current_frame);
-        vkResetFences(logical_device.get(), 1, 
+        if (!any_acquired) { return; }
+
+        // this frame's fence was waited on, slots released the last time it was recorded are free again
+        read_frame_stats();
+        collect_readbacks();
+        frame_descriptors[current_frame].reset();
+        collect_uploads();
+        if (++frames_drawn % MEMORY_BUDGET_INTERVAL == 0) { refresh_memory_budget(); }
+        if (culling_compare_interval > 0 && frames_drawn % culling_compare_interval == 0) { culling = !culling; }
+        texture_slots.next_frame();
+        storage_buffer_slots.next_frame();
+        dispatch.ResetFences(logical_device.get(), 1, 
                 reinterpret_cast<const VkFence*>(&in_flight_fences[current_frame]));
 
 
-        vkResetCommandBuffer(command_buffers[current_frame], 0);
-        record_command_buffer(command_buffers[current_frame], image_index);
-
-        VkSubmitInfo submit_info{};
-        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-
-        VkSemaphore wait_semaphores[] = {image_available_semaphores[current_frame].get()};
-        VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        submit_info.waitSemaphoreCount = 1;
-        submit_info.pWaitSemaphores = wait_semaphores;
-        submit_info.pWaitDstStageMask = wait_stages;
-        submit_info.commandBufferCount = 1;
-        submit_info.pCommandBuffers = &command_buffers[current_frame];
-        VkSemaphore signal_semaphores[] = {render_finished_semaphores[current_frame].get()};
-        submit_info.signalSemaphoreCount = 1;
-        submit_info.pSignalSemaphores = signal_semaphores;
-        result = vkQueueSubmit(graphics_queue, 1, &submit_info, in_flight_fences[current_frame].get());
-        VKE_RESULT_CRASH(result);
+        dispatch.ResetCommandBuffer(command_buffers[current_frame], 0);
+        record_command_buffer(command_buffers[current_frame]);
+
+        // one submission renders every window, it waits for each acquired image and signals each present semaphore
+        std::array<VkSemaphoreSubmitInfo, MAX_VIEWPORTS + 1> waits{};
+        std::array<VkSemaphoreSubmitInfo, MAX_VIEWPORTS> signals{};
+        std::array<Viewport*, MAX_VIEWPORTS> presented{};
+        std::array<VkSwapchainKHR, MAX_VIEWPORTS> swapchains{};
+        std::array<u32, MAX_VIEWPORTS> image_indices{};
+        std::array<VkSemaphore, MAX_VIEWPORTS> present_waits{};
+        std::array<VkResult, MAX_VIEWPORTS> present_results{};
+        u32 present_count = 0;
+        for (auto& viewport : viewports) {
+            if (!viewport->acquired) { continue; }
+            waits[present_count].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            waits[present_count].semaphore = viewport->image_available_semaphores[current_frame].get();
+            waits[present_count].stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            signals[present_count].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            signals[present_count].semaphore = viewport->render_finished_semaphores[current_frame].get();
+            signals[present_count].stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            presented[present_count] = viewport.get();
+            swapchains[present_count] = viewport->swapchain.get();
+            image_indices[present_count] = viewport->image_index;
+            present_waits[present_count] = viewport->render_finished_semaphores[current_frame].get();
+            present_count++;
+        }
+        u32 wait_count = present_count;
+        // uploads submitted since the last frame, their acquire barriers were recorded at the start of this one
+        if (upload_timeline_value > upload_waited_value) {
+            waits[wait_count].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            waits[wait_count].semaphore = upload_timeline.get();
+            waits[wait_count].value = upload_timeline_value;
+            waits[wait_count].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            wait_count++;
+            upload_waited_value = upload_timeline_value;
+        }
+        submit(graphics_queue, command_buffers[current_frame], std::span(waits.data(), wait_count), std::span(signals.data(), present_count), in_flight_fences[current_frame].get());
 
+        // one present for every window, the results tell which swapchains have to be recreated
         VkPresentInfoKHR present_info{};
         present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-
-        present_info.waitSemaphoreCount = 1;
-        present_info.pWaitSemaphores = signal_semaphores;
-        VkSwapchainKHR swapChains[] = {swapchain.get()};
-        present_info.swapchainCount = 1;
-        present_info.pSwapchains = swapChains;
-        present_info.pImageIndices = &image_index;
-        vkQueuePresentKHR(present_queue, &present_info);
-
-        if (result == VK_ERROR_OUT_OF_DATE_KHR
-                || result == VK_SUBOPTIMAL_KHR 
-                || frame_buffer_resized) {
-            frame_buffer_resized = false;
-            recreate_swapchain();
-        } else if (result != VK_SUCCESS) {
-            VKE_RESULT_CRASH(result);
+        present_info.waitSemaphoreCount = present_count;
+        present_info.pWaitSemaphores = present_waits.data();
+        present_info.swapchainCount = present_count;
+        present_info.pSwapchains = swapchains.data();
+        present_info.pImageIndices = image_indices.data();
+        present_info.pResults = present_results.data();
+        dispatch.QueuePresentKHR(present_queue, &present_info);
+
+        for (u32 i = 0; i < present_count; i++) {
+            Viewport& viewport = *presented[i];
+            vke::Result result = present_results[i];
+            if (result == VK_ERROR_OUT_OF_DATE_KHR
+                    || result == VK_SUBOPTIMAL_KHR 
+                    || viewport.frame_buffer_resized) {
+                viewport.frame_buffer_resized = false;
+                recreate_swapchain(viewport);
+            } else if (result != VK_SUCCESS) {
+                VKE_RESULT_CRASH(result);
+            }
         }
 
+        if (!first_frame_presented) {
+            first_frame_presented = true;
+            fmt::println("time to first frame: {:.2f} ms", std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - startup_begin).count());
+            rusage usage{};
+            getrusage(RUSAGE_SELF, &usage);
+            fmt::println("peak RSS at first frame: {:.1f} MiB", static_cast<f64>(usage.ru_maxrss) / 1024.0); // ru_maxrss is in KiB
+            print_memory_stats(memory_stats());
+            print_descriptor_stats(descriptor_stats());
+        }
         current_frame = (current_frame + 1) % MAX_FRAMES_IN_FLIGHT;
     }
     void Instance::create_sync_objects() {
-        image_available_semaphores.resize(MAX_FRAMES_IN_FLIGHT);
-        render_finished_semaphores.resize(MAX_FRAMES_IN_FLIGHT);
         in_flight_fences.resize(MAX_FRAMES_IN_FLIGHT);
 
-        VkSemaphoreCreateInfo semaphore_info{};
-        semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-
         VkFenceCreateInfo fence_info{};
         fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
         fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-        for (const auto& [image_available_semaphore, render_finished_semaphore, in_flight_fence] : std::views::zip(image_available_semaphores, render_finished_semaphores, in_flight_fences)) {
+        for (auto& in_flight_fence : in_flight_fences) {
+            vke::Result result = vkCreateFence(logical_device.get(), &fence_info, nullptr, reinterpret_cast<VkFence*>(&in_flight_fence));
+            VKE_RESULT_CRASH(result);
+        }
+    }
+    void Instance::create_semaphores(Viewport& viewport) {
+        viewport.image_available_semaphores.resize(MAX_FRAMES_IN_FLIGHT);
+        viewport.render_finished_semaphores.resize(MAX_FRAMES_IN_FLIGHT);
+
+        VkSemaphoreCreateInfo semaphore_info{};
+        semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        for (const auto& [image_available_semaphore, render_finished_semaphore] : std::views::zip(viewport.image_available_semaphores, viewport.render_finished_semaphores)) {
             vke::Result result =  vkCreateSemaphore(logical_device.get(), &semaphore_info, nullptr, reinterpret_cast<VkSemaphore*>(&image_available_semaphore));
             VKE_RESULT_CRASH(result);
             result = vkCreateSemaphore(logical_device.get(), &semaphore_info, nullptr, reinterpret_cast<VkSemaphore*>(&render_finished_semaphore));
             VKE_RESULT_CRASH(result);
-            result = vkCreateFence(logical_device.get(), &fence_info, nullptr, reinterpret_cast<VkFence*>(&in_flight_fence));
-            VKE_RESULT_CRASH(result);
         }
     }
-    void Instance::record_command_buffer(VkCommandBuffer command_buffer, u32 image_index) {
-        VkCommandBufferBeginInfo begin_info{};
-        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        begin_info.flags = 0; // Optional
-        begin_info.pInheritanceInfo = nullptr; // Optional
+    void Instance::create_frame_graph(Viewport& viewport) {
+        VkFormat depth_format = find_depth_format();
+        VkImageAspectFlags depth_aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+        if (has_stencil_component(depth_format)) { depth_aspect |= VK_IMAGE_ASPECT_STENCIL_BIT; }
+
+        RenderGraph& frame_graph = viewport.frame_graph;
+        frame_graph.clear();
+        // the old attachments go before new ones are allocated
+        viewport.depth_image_view.reset(nullptr);
+        viewport.graph_images = {};
+        // the acquire semaphore is waited on at color output, chain the layout transition to it
+        ResourceHandle swapchain = frame_graph.import_image("swapchain",
+                ImageDesc{viewport.swapchain_image_format, viewport.swapchain_extent, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | (viewport.swapchain_readable ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0u), VK_IMAGE_ASPECT_COLOR_BIT},
+                VK_NULL_HANDLE,
+                ImageState{VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_UNDEFINED},
+                VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+        viewport.frame_graph_swapchain = swapchain;
+        // transient, the early pass clears it and nothing reads it after the late one. Its memory is
+        // shared by all frames in flight, wait for the previous frame's depth writes
+        ResourceHandle depth = frame_graph.create_image("depth",
+                ImageDesc{depth_format, viewport.swapchain_extent, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, depth_aspect},
+                image_state(ResourceUsage::depth_attachment_write));
+
+        // persistent, left readable for the next frame's early phase which binds it without sampling it
+        ResourceHandle hiz = frame_graph.import_image("hiz",
+                ImageDesc{VK_FORMAT_R32_SFLOAT, viewport.hiz_size, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_IMAGE_ASPECT_COLOR_BIT},
+                viewport.hiz_image.get(),
+                image_state(ResourceUsage::compute_sampled_read),
+                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        // the cull passes only touch buffers, which the graph does not track, they record their own barriers
+        frame_graph.add_pass("cull_early", [](RenderGraph::PassBuilder& pass) {
+                pass.side_effect();
+                }, [this, &viewport](VkCommandBuffer command_buffer) { record_cull_pass(viewport, command_buffer, cull_early); });
+        frame_graph.add_pass("main_early", [&](RenderGraph::PassBuilder& pass) {
+                pass.write(swapchain, ResourceUsage::color_attachment_write)
+                    .write(depth, ResourceUsage::depth_attachment_write);
+                }, [this, &viewport](VkCommandBuffer command_buffer) { record_main_pass(viewport, command_buffer, cull_early); });
+        frame_graph.add_pass("hiz", [&](RenderGraph::PassBuilder& pass) {
+                pass.read(depth, ResourceUsage::compute_sampled_read)
+                    .write(hiz, ResourceUsage::compute_storage_write);
+                }, [this, &viewport](VkCommandBuffer command_buffer) { record_hiz_pass(viewport, command_buffer); });
+        frame_graph.add_pass("cull_late", [&](RenderGraph::PassBuilder& pass) {
+                pass.read(hiz, ResourceUsage::compute_sampled_read)
+                    .side_effect();
+                }, [this, &viewport](VkCommandBuffer command_buffer) { record_cull_pass(viewport, command_buffer, cull_late); });
+        frame_graph.add_pass("main_late", [&](RenderGraph::PassBuilder& pass) {
+                pass.write(swapchain, ResourceUsage::color_attachment_write)
+                    .write(depth, ResourceUsage::depth_attachment_write);
+                }, [this, &viewport](VkCommandBuffer command_buffer) { record_main_pass(viewport, command_buffer, cull_late); });
+        viewport.frame_graph_compiled = frame_graph.compile();
+        // transients get memory per aliasing slot of the compiled graph, the passes only need a view of depth
+        viewport.graph_images = realize_render_graph(frame_graph, viewport.frame_graph_compiled);
+        viewport.depth_image_view.reset(create_image_view(viewport.graph_images.images[depth].get(), depth_format, VK_IMAGE_ASPECT_DEPTH_BIT));
+
+        // compiled again with the readback appended, the passes before it keep their indices so both results stay valid
+        frame_graph.add_pass("readback", [&](RenderGraph::PassBuilder& pass) {
+                pass.read(swapchain, ResourceUsage::transfer_src)
+                    .side_effect();
+                }, [this, &viewport](VkCommandBuffer command_buffer) { record_readback(viewport, command_buffer); });
+        viewport.frame_graph_capture_compiled = frame_graph.compile();
+    }
+    void Instance::record_cull_pass(Viewport& viewport, VkCommandBuffer command_buffer, CullPhase phase) {
+        VkBuffer draw_buffer = viewport.draw_buffers[current_frame].get();
+        std::array<VkBufferMemoryBarrier2, 2> barriers{};
+        for (auto& barrier : barriers) {
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.offset = 0;
+            barrier.size = VK_WHOLE_SIZE;
+        }
+        VkDependencyInfo dependency{};
+        dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.bufferMemoryBarrierCount = static_cast<u32>(barriers.size());
+        dependency.pBufferMemoryBarriers = barriers.data();
+
+        barriers[0].buffer = draw_buffer;
+        barriers[0].dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barriers[0].dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        barriers[1].buffer = viewport.visibility_buffer.get();
+        barriers[1].srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barriers[1].srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        barriers[1].dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barriers[1].dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        if (phase == cull_early) {
+            // clear both counts, visibility was last written by the previous frame's late phase
+            dispatch.CmdFillBuffer(command_buffer, draw_buffer, 0, 2 * sizeof(u32), 0);
+            barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+            barriers[0].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        } else {
+            // the late phase appends behind the early draws and overwrites the visibility the early phase read
+            barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            barriers[0].srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        }
+        dispatch.CmdPipelineBarrier2(command_buffer, &dependency);
+
+        VkDescriptorSet hiz_set = allocate_frame_descriptor_set(cull_set_layout);
+        VkDescriptorImageInfo image_info{};
+        image_info.sampler = hiz_sampler.get();
+        image_info.imageView = viewport.hiz_view.get();
+        image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        VkWriteDescriptorSet descriptor_write{};
+        descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptor_write.dstSet = hiz_set;
+        descriptor_write.dstBinding = 0;
+        descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptor_write.descriptorCount = 1;
+        descriptor_write.pImageInfo = &image_info;
+        dispatch.UpdateDescriptorSets(logical_device.get(), 1, &descriptor_write, 0, nullptr);
+
+        CullPushConstants push_constants{};
+        push_constants.view_proj = viewport.view_proj;
+        push_constants.hiz_size = glm::vec2(static_cast<f32>(viewport.hiz_size.width), static_cast<f32>(viewport.hiz_size.height));
+        push_constants.object_count = static_cast<u32>(objects.size());
+        push_constants.index_count = static_cast<u32>(indices.size());
+        push_constants.bounds_buffer = object_bounds_slot;
+        push_constants.draw_buffer = viewport.draw_buffer_slots[current_frame];
+        push_constants.visibility_buffer = viewport.visibility_slot;
+        push_constants.phase = phase;
+        push_constants.culling = frame_culling[current_frame] ? 1u : 0u;
+        std::array<VkDescriptorSet, 2> sets = {hiz_set, bindless_set};
+        dispatch.CmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, cull_pipeline.get());
+        dispatch.CmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, cull_pipeline_layout.get(), 0, static_cast<u32>(sets.size()), sets.data(), 0, nullptr);
+        dispatch.CmdPushConstants(command_buffer, cull_pipeline_layout.get(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants);
+        dispatch.CmdDispatch(command_buffer, (push_constants.object_count + CULL_WORKGROUP_SIZE - 1) / CULL_WORKGROUP_SIZE, 1, 1);
+
+        dependency.bufferMemoryBarrierCount = 1;
+        barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        barriers[0].srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        barriers[0].dstStageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+        barriers[0].dstAccessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+        if (phase == cull_early) {
+            dispatch.CmdPipelineBarrier2(command_buffer, &dependency);
+            return;
+        }
 
-        vke::Result result = vkBeginCommandBuffer(command_buffer, &begin_info);
-        VKE_RESULT_CRASH(result);
-        //fmt::println("failed to begin recording command buffer!");
-        VkRenderPassBeginInfo render_pass_info{};
-        render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        render_pass_info.renderPass = render_pass.get();
-        render_pass_info.framebuffer = swapchain_framebuffers[image_index].get();
-        render_pass_info.renderArea.offset = {0, 0};
-        render_pass_info.renderArea.extent = swapchain_extent;
-
-        std::array<VkClearValue, 2> clearValues{};
-        clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
-        clearValues[1].depthStencil = {1.0f, 0};
-
-        
-        render_pass_info.clearValueCount = static_cast<u32>(clearValues.size());
-        render_pass_info.pClearValues    = clearValues.data();
-
-        vkCmdBeginRenderPass(command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+        // both counts are final, copy them out for FrameStats
+        barriers[0].dstStageMask |= VK_PIPELINE_STAGE_2_COPY_BIT;
+        barriers[0].dstAccessMask |= VK_ACCESS_2_TRANSFER_READ_BIT;
+        dispatch.CmdPipelineBarrier2(command_buffer, &dependency);
+        VkBufferCopy copy_region{};
+        copy_region.size = 2 * sizeof(u32);
+        dispatch.CmdCopyBuffer(command_buffer, draw_buffer, viewport.stats_buffers[current_frame].get(), 1, &copy_region);
+        barriers[0].buffer = viewport.stats_buffers[current_frame].get();
+        barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        barriers[0].srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barriers[0].dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+        barriers[0].dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+        dispatch.CmdPipelineBarrier2(command_buffer, &dependency);
+        viewport.drawn[current_frame] = true;
+    }
+    void Instance::record_hiz_pass(Viewport& viewport, VkCommandBuffer command_buffer) {
+        dispatch.CmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, hiz_pipeline.get());
+        const VkExtent2D hiz_size = viewport.hiz_size;
+        for (u32 mip = 0; mip < viewport.hiz_mip_views.size(); mip++) {
+            VkExtent2D extent = {std::max(hiz_size.width >> mip, 1u), std::max(hiz_size.height >> mip, 1u)};
+
+            // mip 0 reduces the depth buffer, every other mip the one above it
+            std::array<VkDescriptorImageInfo, 2> image_infos{};
+            image_infos[0].sampler = hiz_sampler.get();
+            image_infos[0].imageView = mip == 0 ? viewport.depth_image_view.get() : viewport.hiz_mip_views[mip - 1].get();
+            image_infos[0].imageLayout = mip == 0 ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+            image_infos[1].imageView = viewport.hiz_mip_views[mip].get();
+            image_infos[1].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+            VkDescriptorSet set = allocate_frame_descriptor_set(hiz_set_layout);
+            std::array<VkWriteDescriptorSet, 2> descriptor_writes{};
+            for (u32 binding = 0; binding < descriptor_writes.size(); binding++) {
+                descriptor_writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                descriptor_writes[binding].dstSet = set;
+                descriptor_writes[binding].dstBinding = binding;
+                descriptor_writes[binding].descriptorCount = 1;
+                descriptor_writes[binding].pImageInfo = &image_infos[binding];
+            }
+            descriptor_writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            descriptor_writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            dispatch.UpdateDescriptorSets(logical_device.get(), static_cast<u32>(descriptor_writes.size()), descriptor_writes.data(), 0, nullptr);
+
+            HiZPushConstants push_constants{glm::vec2(static_cast<f32>(extent.width), static_cast<f32>(extent.height))};
+            dispatch.CmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, hiz_pipeline_layout.get(), 0, 1, &set, 0, nullptr);
+            dispatch.CmdPushConstants(command_buffer, hiz_pipeline_layout.get(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push_constants), &push_constants);
+            dispatch.CmdDispatch(command_buffer, (extent.width + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE, (extent.height + HIZ_WORKGROUP_SIZE - 1) / HIZ_WORKGROUP_SIZE, 1);
+
+            // the next dispatch samples this mip, the graph only synchronizes the image as a whole
+            VkImageMemoryBarrier2 barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+            barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+            barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+            barrier.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = viewport.hiz_image.get();
+            barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, mip, 1, 0, 1};
+            VkDependencyInfo dependency{};
+            dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependency.imageMemoryBarrierCount = 1;
+            dependency.pImageMemoryBarriers = &barrier;
+            dispatch.CmdPipelineBarrier2(command_buffer, &dependency);
+        }
+    }
+    void Instance::record_main_pass(Viewport& viewport, VkCommandBuffer command_buffer, CullPhase phase) {
+        const VkExtent2D swapchain_extent = viewport.swapchain_extent;
+        // the late phase draws on top of the early one, the early depth also feeds the Hi-Z pyramid
+        VkAttachmentLoadOp load_op = phase == cull_early ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+
+        VkRenderingAttachmentInfo color_attachment{};
+        color_attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        color_attachment.imageView = viewport.swapchain_image_views[viewport.image_index].get();
+        color_attachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        color_attachment.loadOp = load_op;
+        color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        color_attachment.clearValue.color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+
+        VkRenderingAttachmentInfo depth_attachment{};
+        depth_attachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        depth_attachment.imageView = viewport.depth_image_view.get();
+        depth_attachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depth_attachment.loadOp = load_op;
+        depth_attachment.storeOp = phase == cull_early ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depth_attachment.clearValue.depthStencil = {1.0f, 0};
+
+        VkRenderingInfo rendering_info{};
+        rendering_info.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        rendering_info.renderArea.offset = {0, 0};
+        rendering_info.renderArea.extent = swapchain_extent;
+        rendering_info.layerCount = 1;
+        rendering_info.colorAttachmentCount = 1;
+        rendering_info.pColorAttachments = &color_attachment;
+        rendering_info.pDepthAttachment = &depth_attachment;
+        // must match the stencil format the pipeline was created with
+        if (has_stencil_component(find_depth_format())) { rendering_info.pStencilAttachment = &depth_attachment; }
+
+        dispatch.CmdBeginRendering(command_buffer, &rendering_info);
         {
-            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline.get());
+            dispatch.CmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline.get());
 
-            VkViewport viewport{};
-            viewport.x = 0.0f;
-            viewport.y = 0.0f;
-            viewport.width = static_cast<f32>(swapchain_extent.width);
-            viewport.height = static_cast<f32>(swapchain_extent.height);
-            viewport.minDepth = 0.0f;
-            viewport.maxDepth = 1.0f;
-            vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+            VkViewport viewport_rect{};
+            viewport_rect.x = 0.0f;
+            viewport_rect.y = 0.0f;
+            viewport_rect.width = static_cast<f32>(swapchain_extent.width);
+            viewport_rect.height = static_cast<f32>(swapchain_extent.height);
+            viewport_rect.minDepth = 0.0f;
+            viewport_rect.maxDepth = 1.0f;
+            dispatch.CmdSetViewport(command_buffer, 0, 1, &viewport_rect);
 
             VkRect2D scissor{};
             scissor.offset = {0, 0};
             scissor.extent = swapchain_extent;
-            vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+            dispatch.CmdSetScissor(command_buffer, 0, 1, &scissor);
 
             VkBuffer vertex_buffers[] = {vertex_buffer.get()};
             VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffers, offsets);
-            vkCmdBindIndexBuffer(command_buffer, index_buffer.get(), 0, VK_INDEX_TYPE_UINT32);
-            vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.get(), 0, 1, &descriptor_sets[current_frame], 0, nullptr);
-            vkCmdDrawIndexed(command_buffer, static_cast<uint32_t>(indices.size()), 1, 0, 0, 0);
+            dispatch.CmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffers, offsets);
+            dispatch.CmdBindIndexBuffer(command_buffer, index_buffer.get(), 0, VK_INDEX_TYPE_UINT32);
+            // textures and object data are indexed in the shaders, no per-draw binds
+            std::array<VkDescriptorSet, 2> sets = {viewport.descriptor_sets[current_frame], bindless_set};
+            dispatch.CmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout.get(), 0, static_cast<u32>(sets.size()), sets.data(), 0, nullptr);
+            DrawPushConstants push_constants{frame_model, object_buffer_slot, 0};
+            dispatch.CmdPushConstants(command_buffer, pipeline_layout.get(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push_constants), &push_constants);
+            // draws and their count come from the cull pass of the same phase
+            VkBuffer draw_buffer = viewport.draw_buffers[current_frame].get();
+            u32 max_draws = static_cast<u32>(objects.size());
+            dispatch.CmdDrawIndexedIndirectCount(command_buffer,
+                    draw_buffer, CULL_DRAWS_OFFSET + phase * max_draws * sizeof(VkDrawIndexedIndirectCommand),
+                    draw_buffer, phase * sizeof(u32),
+                    max_draws, sizeof(VkDrawIndexedIndirectCommand));
+        }
+        dispatch.CmdEndRendering(command_buffer);
+    }
+    void Instance::record_command_buffer(VkCommandBuffer command_buffer) {
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = 0; // Optional
+        begin_info.pInheritanceInfo = nullptr; // Optional
+
+        vke::Result result = dispatch.BeginCommandBuffer(command_buffer, &begin_info);
+        VKE_RESULT_CRASH(result);
+        // the cull passes read it, read_frame_stats files the frame's stats under it
+        frame_culling[current_frame] = culling;
+
+        if (!pending_buffer_acquires.empty() || !pending_image_acquires.empty()) {
+            VkDependencyInfo dependency{};
+            dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependency.bufferMemoryBarrierCount = static_cast<u32>(pending_buffer_acquires.size());
+            dependency.pBufferMemoryBarriers = pending_buffer_acquires.data();
+            dependency.imageMemoryBarrierCount = static_cast<u32>(pending_image_acquires.size());
+            dependency.pImageMemoryBarriers = pending_image_acquires.data();
+            dispatch.CmdPipelineBarrier2(command_buffer, &dependency);
+            pending_buffer_acquires.clear();
+            pending_image_acquires.clear();
+        }
+
+        u32 first_query = current_frame * 2;
+        bool timestamps = timestamp_period > 0.0f;
+        if (timestamps) {
+            dispatch.CmdResetQueryPool(command_buffer, timestamp_pool.get(), first_query, 2);
+            dispatch.CmdWriteTimestamp2(command_buffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, timestamp_pool.get(), first_query);
+        }
+
+        // the viewports share nothing they write, their graphs run one after the other without barriers between them
+        frame_readback = nullptr;
+        for (auto& viewport : viewports) {
+            if (!viewport->acquired) { continue; }
+            update_uniform_buffer(*viewport, current_frame);
+            viewport->frame_graph.bind_image(viewport->frame_graph_swapchain, viewport->swapchain_images[viewport->image_index]);
+            // captures are of the first window
+            ReadbackSlot* readback = viewport == viewports.front() ? begin_readback(*viewport) : nullptr;
+            if (readback) { frame_readback = readback; }
+            viewport->frame_graph.execute(command_buffer, readback ? viewport->frame_graph_capture_compiled : viewport->frame_graph_compiled, dispatch.CmdPipelineBarrier2);
+        }
 
+        if (timestamps) {
+            dispatch.CmdWriteTimestamp2(command_buffer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, timestamp_pool.get(), first_query + 1);
         }
-        vkCmdEndRenderPass(command_buffer);
-        result = vkEndCommandBuffer(command_buffer);
+        timestamps_written[current_frame] = timestamps;
+
+        result = dispatch.EndCommandBuffer(command_buffer);
         VKE_RESULT_CRASH(result);
         // "failed to record command buffer!"
     }
@@ -629,7 +1471,11 @@ namespace vke {
         std::vector<tinyobj::material_t> materials;
         std::string warn, err;
 
-        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, MODEL_PATH.c_str())) {
+        // parse straight out of the pack or the mapping, tinyobj only reads through the stream
+        Asset file = load_asset(MODEL_PATH);
+        std::ispanstream stream(std::span<const char>(reinterpret_cast<const char*>(file.bytes.data()), file.bytes.size()));
+        tinyobj::MaterialFileReader material_reader(std::filesystem::path(MODEL_PATH).parent_path().string() + "/");
+        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, &stream, &material_reader)) {
             throw std::runtime_error(warn + err);
         }
 
@@ -660,7 +1506,12 @@ namespace vke {
             }
         }
 
-
+        glm::vec3 min = vertices.front().pos, max = vertices.front().pos;
+        for (const auto& vertex : vertices) {
+            min = glm::min(min, vertex.pos);
+            max = glm::max(max, vertex.pos);
+        }
+        mesh_bounds = sphere_from_aabb(min, max);
     }
     void Instance::create_command_buffers() {
         command_buffers.resize(MAX_FRAMES_IN_FLIGHT);
@@ -678,37 +1529,31 @@ namespace vke {
 
     }
     void Instance::create_command_pool() {
-        QueueFamilyIndices queue_family_indices = find_queue_families(physical_device);
-
         VkCommandPoolCreateInfo pool_info{};
         pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-        pool_info.queueFamilyIndex = queue_family_indices.graphics_family.value();
+        pool_info.queueFamilyIndex = queue_families.graphics_family.value();
         vke::Result result = vkCreateCommandPool(logical_device.get(), &pool_info, nullptr, reinterpret_cast<VkCommandPool*>(&command_pool));
     }
-    void Instance::create_framebuffers() {
-        swapchain_framebuffers.resize(swapchain_image_views.size());
+    void Instance::create_upload_context() {
+        VkCommandPoolCreateInfo pool_info{};
+        pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        pool_info.queueFamilyIndex = queue_families.transfer_family.value();
+        vke::Result result = vkCreateCommandPool(logical_device.get(), &pool_info, nullptr, reinterpret_cast<VkCommandPool*>(&transfer_command_pool));
+        VKE_RESULT_CRASH(result);
 
-        for (const auto& [index, image_view] : std::views::enumerate(swapchain_image_views)) {
-            std::array<VkImageView, 2> attachments = {
-                image_view.get(),
-                depth_image_view.get()
-            };
-            VkFramebufferCreateInfo framebuffer_info{};
-            framebuffer_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-            framebuffer_info.renderPass = render_pass.get();
-            framebuffer_info.attachmentCount = static_cast<u32>(attachments.size());
-            framebuffer_info.pAttachments = attachments.data();
-            framebuffer_info.width = swapchain_extent.width;
-            framebuffer_info.height = swapchain_extent.height;
-            framebuffer_info.layers = 1;
-
-            swapchain_framebuffers[static_cast<std::size_t>(index)].reset(nullptr);
-            vke::Result result = vkCreateFramebuffer(logical_device.get(), &framebuffer_info, nullptr, reinterpret_cast<VkFramebuffer*>(&(swapchain_framebuffers[static_cast<std::size_t>(index)])));
-            VKE_RESULT_CRASH(result);
-        }
-    };
-    auto Instance::create_shader_module(const std::vector<std::byte>& shader_code) const -> std::unique_ptr<VkShaderModule_T, VKEShaderModuleDeleter> {
+        VkSemaphoreTypeCreateInfo timeline_info{};
+        timeline_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        timeline_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        timeline_info.initialValue = 0;
+        VkSemaphoreCreateInfo semaphore_info{};
+        semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphore_info.pNext = &timeline_info;
+        result = vkCreateSemaphore(logical_device.get(), &semaphore_info, nullptr, reinterpret_cast<VkSemaphore*>(&upload_timeline));
+        VKE_RESULT_CRASH(result);
+    }
+    auto Instance::create_shader_module(std::span<const std::byte> shader_code) const -> std::unique_ptr<VkShaderModule_T, VKEShaderModuleDeleter> {
         VkShaderModuleCreateInfo create_info = {};
         create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
         create_info.codeSize = shader_code.size();
@@ -721,73 +1566,12 @@ namespace vke {
     }
 
 
-    void Instance::create_render_pass() {
-        VkAttachmentDescription depth_attachment{};
-        depth_attachment.format = find_depth_format();
-        depth_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
-        depth_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        depth_attachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        depth_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        depth_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        depth_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        depth_attachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-        VkAttachmentReference depth_attachment_ref{};
-        depth_attachment_ref.attachment = 1;
-        depth_attachment_ref.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-
-        VkAttachmentDescription color_attachment{};
-        color_attachment.format = swapchain_image_format;
-        color_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
-        color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        color_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        color_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        color_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        color_attachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-        VkAttachmentReference color_attachment_ref{};
-        color_attachment_ref.attachment = 0;
-        color_attachment_ref.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-
-        VkSubpassDescription subpass{};
-        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass.colorAttachmentCount = 1;
-        subpass.pColorAttachments = &color_attachment_ref;
-        subpass.pDepthStencilAttachment = &depth_attachment_ref;
-
-        VkSubpassDependency dependency{};
-        dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-        dependency.dstSubpass = 0;
-        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-
-
-        std::array<VkAttachmentDescription, 2> attachments = {color_attachment, depth_attachment};
-
-        VkRenderPassCreateInfo render_pass_info{};
-        render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        render_pass_info.attachmentCount = static_cast<u32>(attachments.size());
-        render_pass_info.pAttachments = attachments.data();
-        render_pass_info.subpassCount = 1;
-        render_pass_info.pSubpasses = &subpass;
-        render_pass_info.dependencyCount = 1;
-        render_pass_info.pDependencies = &dependency;
-
-        vke::Result result = vkCreateRenderPass(logical_device.get(), &render_pass_info, nullptr, reinterpret_cast<VkRenderPass*>(&render_pass));
-        VKE_RESULT_CRASH(result);
-    }
     void Instance::create_graphics_pipeline() {
-        auto vs_source = read_file("shaders/hello.vert.spv");
-        auto fs_source = read_file("shaders/hello.frag.spv");
+        auto vs_source = shader_spirv("hello.vert");
+        auto fs_source = shader_spirv("hello.frag");
 
-        auto vs_module = create_shader_module(vs_source);
-        auto fs_module = create_shader_module(fs_source);
+        auto vs_module = create_shader_module(vs_source.bytes());
+        auto fs_module = create_shader_module(fs_source.bytes());
 
         VkPipelineShaderStageCreateInfo vs_stage_info{};
         vs_stage_info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -820,14 +1604,14 @@ namespace vke {
         VkViewport viewport{};
         viewport.x = 0.0f;
         viewport.y = 0.0f;
-        viewport.width = static_cast<f32>(swapchain_extent.width);
-        viewport.height = static_cast<f32>(swapchain_extent.height);
+        viewport.width = static_cast<f32>(viewports.front()->swapchain_extent.width);
+        viewport.height = static_cast<f32>(viewports.front()->swapchain_extent.height);
         viewport.minDepth = 0.0f;
         viewport.maxDepth = 1.0f;
 
         VkRect2D scissor{};
         scissor.offset = {0, 0};
-        scissor.extent = swapchain_extent;
+        scissor.extent = viewports.front()->swapchain_extent;
 
         std::vector<VkDynamicState> dynamic_states = {
             VK_DYNAMIC_STATE_VIEWPORT,
@@ -889,12 +1673,18 @@ namespace vke {
         color_blending.blendConstants[2] = 0.0f; // Optional
         color_blending.blendConstants[3] = 0.0f; // Optional
 
+        std::array<VkDescriptorSetLayout, 2> set_layouts = {descriptor_set_layout, bindless_set_layout};
+        VkPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(DrawPushConstants);
+
         VkPipelineLayoutCreateInfo pipeline_layout_info{};
         pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipeline_layout_info.setLayoutCount = 1;
-        pipeline_layout_info.pSetLayouts = reinterpret_cast<VkDescriptorSetLayout*>(&descriptor_set_layout);
-        pipeline_layout_info.pushConstantRangeCount = 0;
-        pipeline_layout_info.pPushConstantRanges = nullptr;
+        pipeline_layout_info.setLayoutCount = static_cast<u32>(set_layouts.size());
+        pipeline_layout_info.pSetLayouts = set_layouts.data();
+        pipeline_layout_info.pushConstantRangeCount = 1;
+        pipeline_layout_info.pPushConstantRanges = &push_constant_range;
 
         VkPipelineDepthStencilStateCreateInfo depth_stencil{};
         depth_stencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
@@ -905,6 +1695,15 @@ namespace vke {
         depth_stencil.stencilTestEnable = VK_FALSE;
 
 
+        // dynamic rendering: the pipeline only needs the attachment formats, not a compatible render pass
+        VkFormat depth_format = find_depth_format();
+        VkPipelineRenderingCreateInfo rendering_info{};
+        rendering_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        rendering_info.colorAttachmentCount = 1;
+        rendering_info.pColorAttachmentFormats = &color_format;
+        rendering_info.depthAttachmentFormat = depth_format;
+        rendering_info.stencilAttachmentFormat = has_stencil_component(depth_format) ? depth_format : VK_FORMAT_UNDEFINED;
+
         vke::Result result = vkCreatePipelineLayout(logical_device.get(), &pipeline_layout_info, nullptr, reinterpret_cast<VkPipelineLayout*>(&pipeline_layout));
         VKE_RESULT_CRASH(result);
 
@@ -921,21 +1720,106 @@ namespace vke {
         pipeline_info.pColorBlendState = &color_blending;
         pipeline_info.pDynamicState = &dynamic_state;
         pipeline_info.layout = pipeline_layout.get();
-        pipeline_info.renderPass = render_pass.get();
+        pipeline_info.pNext = &rendering_info;
+        pipeline_info.renderPass = VK_NULL_HANDLE;
         pipeline_info.subpass = 0;
         pipeline_info.basePipelineHandle = VK_NULL_HANDLE; // Optional
         pipeline_info.basePipelineIndex = -1; // Optional
 
-        result = vkCreateGraphicsPipelines(logical_device.get(), VK_NULL_HANDLE, 1, &pipeline_info, nullptr, reinterpret_cast<VkPipeline*>(&graphics_pipeline));
+        result = vkCreateGraphicsPipelines(logical_device.get(), pipeline_cache.get(), 1, &pipeline_info, nullptr, reinterpret_cast<VkPipeline*>(&graphics_pipeline));
+        VKE_RESULT_CRASH(result);
+    }
+    void Instance::create_cull_pipeline() {
+        auto cs_source = shader_spirv("cull.comp");
+        auto cs_module = create_shader_module(cs_source.bytes());
+
+        VkPipelineShaderStageCreateInfo cs_stage_info{};
+        cs_stage_info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        cs_stage_info.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        cs_stage_info.module = cs_module.get();
+        cs_stage_info.pName = "main";
+
+        // set 0 holds the Hi-Z pyramid, the bindless set stays at the same index as in the graphics layout
+        std::array<VkDescriptorSetLayout, 2> set_layouts = {cull_set_layout, bindless_set_layout};
+        VkPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(CullPushConstants);
+
+        VkPipelineLayoutCreateInfo pipeline_layout_info{};
+        pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_info.setLayoutCount = static_cast<u32>(set_layouts.size());
+        pipeline_layout_info.pSetLayouts = set_layouts.data();
+        pipeline_layout_info.pushConstantRangeCount = 1;
+        pipeline_layout_info.pPushConstantRanges = &push_constant_range;
+        vke::Result result = vkCreatePipelineLayout(logical_device.get(), &pipeline_layout_info, nullptr, reinterpret_cast<VkPipelineLayout*>(&cull_pipeline_layout));
+        VKE_RESULT_CRASH(result);
+
+        VkComputePipelineCreateInfo pipeline_info{};
+        pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_info.stage = cs_stage_info;
+        pipeline_info.layout = cull_pipeline_layout.get();
+        result = vkCreateComputePipelines(logical_device.get(), pipeline_cache.get(), 1, &pipeline_info, nullptr, reinterpret_cast<VkPipeline*>(&cull_pipeline));
+        VKE_RESULT_CRASH(result);
+    }
+    void Instance::create_hiz_pipeline() {
+        auto cs_source = shader_spirv("hiz.comp");
+        auto cs_module = create_shader_module(cs_source.bytes());
+
+        // linear filtering with a max reduction returns the farthest of the 2x2 texels instead of their average
+        VkSamplerReductionModeCreateInfo reduction_info{};
+        reduction_info.sType = VK_STRUCTURE_TYPE_SAMPLER_REDUCTION_MODE_CREATE_INFO;
+        reduction_info.reductionMode = VK_SAMPLER_REDUCTION_MODE_MAX;
+        VkSamplerCreateInfo sampler_info{};
+        sampler_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        sampler_info.pNext = &reduction_info;
+        sampler_info.magFilter = VK_FILTER_LINEAR;
+        sampler_info.minFilter = VK_FILTER_LINEAR;
+        sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        sampler_info.minLod = 0.0f;
+        sampler_info.maxLod = VK_LOD_CLAMP_NONE;
+        vke::Result result = vkCreateSampler(logical_device.get(), &sampler_info, nullptr, reinterpret_cast<VkSampler*>(&hiz_sampler));
+        VKE_RESULT_CRASH(result);
+
+        VkPushConstantRange push_constant_range{};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(HiZPushConstants);
+
+        VkPipelineLayoutCreateInfo pipeline_layout_info{};
+        pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipeline_layout_info.setLayoutCount = 1;
+        pipeline_layout_info.pSetLayouts = &hiz_set_layout;
+        pipeline_layout_info.pushConstantRangeCount = 1;
+        pipeline_layout_info.pPushConstantRanges = &push_constant_range;
+        result = vkCreatePipelineLayout(logical_device.get(), &pipeline_layout_info, nullptr, reinterpret_cast<VkPipelineLayout*>(&hiz_pipeline_layout));
+        VKE_RESULT_CRASH(result);
+
+        VkComputePipelineCreateInfo pipeline_info{};
+        pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipeline_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipeline_info.stage.module = cs_module.get();
+        pipeline_info.stage.pName = "main";
+        pipeline_info.layout = hiz_pipeline_layout.get();
+        result = vkCreateComputePipelines(logical_device.get(), pipeline_cache.get(), 1, &pipeline_info, nullptr, reinterpret_cast<VkPipeline*>(&hiz_pipeline));
         VKE_RESULT_CRASH(result);
     }
 
 
-    void Instance::create_swapchain() {
-        SwapChainSupportDetails swapchain_support = query_swapchain_support(this->physical_device, this->surface.get());
+    void Instance::create_swapchain(Viewport& viewport) {
+        SwapChainSupportDetails swapchain_support = query_swapchain_support(this->physical_device, viewport.surface.get());
         VkSurfaceFormatKHR surface_format = choose_swap_surface_format(swapchain_support.formats);
         VkPresentModeKHR present_mode = choose_swap_present_mode(swapchain_support.present_modes);
-        VkExtent2D extent = choose_swap_extent(swapchain_support.capabilities);
+        VkExtent2D extent = choose_swap_extent(swapchain_support.capabilities, viewport.window);
+        // every viewport draws with the one graphics pipeline, which was built for the first swapchain's format
+        if (color_format != VK_FORMAT_UNDEFINED && surface_format.format != color_format) {
+            fmt::println("window surface format {} differs from the first window's {}", static_cast<i32>(surface_format.format), static_cast<i32>(color_format));
+            std::abort();
+        }
 
         u32 image_count = swapchain_support.capabilities.minImageCount + 1;
         if (swapchain_support.capabilities.maxImageCount > 0 && image_count > swapchain_support.capabilities.maxImageCount) {
@@ -943,18 +1827,20 @@ namespace vke {
         }
         VkSwapchainCreateInfoKHR create_info{};
         create_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-        create_info.surface = surface.get();
+        create_info.surface = viewport.surface.get();
         create_info.minImageCount = image_count;
         create_info.imageFormat = surface_format.format;
         create_info.imageColorSpace = surface_format.colorSpace;
         create_info.imageExtent = extent;
         create_info.imageArrayLayers = 1;
         create_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+        // captures copy straight out of the presented image
+        viewport.swapchain_readable = (swapchain_support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0;
+        if (viewport.swapchain_readable) { create_info.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT; }
 
-        QueueFamilyIndices indices = find_queue_families(this->physical_device);
-        u32 queueFamilyIndices[] = {indices.graphics_family.value(), indices.present_family.value()};
+        u32 queueFamilyIndices[] = {queue_families.graphics_family.value(), queue_families.present_family.value()};
 
-        if (indices.graphics_family != indices.present_family) {
+        if (queue_families.graphics_family != queue_families.present_family) {
             create_info.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
             create_info.queueFamilyIndexCount = 2;
             create_info.pQueueFamilyIndices = queueFamilyIndices;
@@ -968,23 +1854,23 @@ namespace vke {
 
         create_info.presentMode = present_mode;
         create_info.clipped = VK_TRUE;
-        create_info.oldSwapchain = swapchain.get();
+        create_info.oldSwapchain = viewport.swapchain.get();
         std::unique_ptr<VkSwapchainKHR_T, VKESwapChainDeleter> swapchain_temp(nullptr);
         vke::Result result =  vkCreateSwapchainKHR(logical_device.get(), &create_info, nullptr, reinterpret_cast<VkSwapchainKHR*>(&swapchain_temp));
-        swapchain.swap(swapchain_temp);
+        viewport.swapchain.swap(swapchain_temp);
         VKE_RESULT_CRASH(result);
 
 
-        vkGetSwapchainImagesKHR(this->logical_device.get(), this->swapchain.get(), &image_count, nullptr);
-        swapchain_images.resize(image_count);
-        vkGetSwapchainImagesKHR(this->logical_device.get(), this->swapchain.get(), &image_count, swapchain_images.data());
-        swapchain_image_format = surface_format.format;
-        swapchain_extent = extent;
+        vkGetSwapchainImagesKHR(this->logical_device.get(), viewport.swapchain.get(), &image_count, nullptr);
+        viewport.swapchain_images.resize(image_count);
+        vkGetSwapchainImagesKHR(this->logical_device.get(), viewport.swapchain.get(), &image_count, viewport.swapchain_images.data());
+        viewport.swapchain_image_format = surface_format.format;
+        viewport.swapchain_extent = extent;
     }
-    void Instance::create_image_views() {
-        swapchain_image_views.resize(swapchain_images.size());
-        for (const auto& [index, image] : std::views::enumerate(swapchain_image_views) ) {
-            image.reset(create_image_view(swapchain_images[static_cast<size_t>(index)], swapchain_image_format, VK_IMAGE_ASPECT_COLOR_BIT));
+    void Instance::create_image_views(Viewport& viewport) {
+        viewport.swapchain_image_views.resize(viewport.swapchain_images.size());
+        for (const auto& [index, image] : std::views::enumerate(viewport.swapchain_image_views) ) {
+            image.reset(create_image_view(viewport.swapchain_images[static_cast<size_t>(index)], viewport.swapchain_image_format, VK_IMAGE_ASPECT_COLOR_BIT));
 
         }
     }
@@ -1013,8 +1899,9 @@ namespace vke {
             vke::Result result = vkCreateInstance(&this->info_create, nullptr, reinterpret_cast<VkInstance*>(&this->instance));
             VKE_RESULT_CRASH(result);
         }
+        instance_dispatch = render_api::InstanceDispatch::load(instance.get());
     }
-    void Instance::create_surface(const window::Window& window) {
+    void Instance::create_surface(Viewport& viewport) {
         // create window surface
         VkXcbSurfaceCreateInfoKHR surface_create_info = {
             // VkStructureType               sType;
@@ -1024,8 +1911,8 @@ namespace vke {
             // xcb_window_t                  window;
         };
         surface_create_info.sType = VK_STRUCTURE_TYPE_XCB_SURFACE_CREATE_INFO_KHR;
-        surface_create_info.connection = window.x_connection.get();
-        surface_create_info.window = window.x_window;
+        surface_create_info.connection = viewport.window.x_connection.get();
+        surface_create_info.window = viewport.window.x_window;
 
         VkSurfaceKHR l_instance = nullptr;
         vke::Result result = vkCreateXcbSurfaceKHR(this->instance.get(), &surface_create_info, nullptr, &l_instance);
@@ -1033,7 +1920,7 @@ namespace vke {
         if (l_instance == nullptr) {
             std::abort();
         }
-        this->surface = std::unique_ptr<VkSurfaceKHR_T, VKESurfaceDeleter>(l_instance);
+        viewport.surface = std::unique_ptr<VkSurfaceKHR_T, VKESurfaceDeleter>(l_instance);
     }
     auto Instance::query_swapchain_support(VkPhysicalDevice device, NonOwningPtr<VkSurfaceKHR_T> surface) const -> SwapChainSupportDetails {
         SwapChainSupportDetails details;
@@ -1107,59 +1994,169 @@ namespace vke {
                 nullptr,                                // const char* const* ppEnabledLayerNames;
                 this->extensions.size(),                      // uint32_t enabledExtensionCount;
                 this->extensions.data()                       // const char* const* ppEnabledExtensionNames;
-                }),
-        swapchain(nullptr),
-        window(window)
+                })
         {
-            window.user_data_ptr = this;
-            create_instance();
-            create_surface(window);
-            pick_physical_device();
-            create_logical_device();
-            create_swapchain();
-            create_image_views();
-            create_render_pass();
-            create_descriptor_set_layout();
-            create_graphics_pipeline();
-            create_command_pool();
-            create_depth_resources();
-            create_framebuffers();
-            create_texture_image();
-            create_texture_image_view();
-            create_texture_sampler();
-            load_model();
-            create_vertex_buffer();
-            create_index_buffer();
-            create_uniform_buffers();
-            create_descriptor_pool();
-            create_descriptor_sets();
-            create_command_buffers();
-            create_sync_objects();
-
-        }
-
-    void Instance::recreate_swapchain() {
+            startup_begin = std::chrono::steady_clock::now();
+            // the first window picks the device and the colour format, add_window() opens more on the same device
+            Viewport& primary = *viewports.emplace_back(std::make_unique<Viewport>(window));
+            set_camera(Camera{{2.0f, 2.0f, 2.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, glm::radians(45.0f), 0.1f, 10.0f});
+            asset_pack = AssetPack::open(ASSET_PACK_PATH);
+            if (!asset_pack) {
+                fmt::println("no asset pack at {}, loading loose files", ASSET_PACK_PATH);
+            }
+            // captures every frame, for measuring what continuous capture costs the frame loop
+            if (const char* capture_dir = std::getenv("NCE_CAPTURE_DIR")) {
+                capture_continuously(capture_dir, 1);
+            }
+            // switches culling on and off every n frames, the stats printed at exit then show what it saves
+            if (const char* compare = std::getenv("NCE_CULLING_COMPARE")) {
+                culling_compare_interval = static_cast<u32>(std::max(std::atoi(compare), 0));
+            }
+
+            // NCE_DRAW_BENCHMARK=n draws the OBJECT_GRID x OBJECT_GRID grid instead, cycling through n more generated
+            // textures, the frame stats printed at exit are the benchmark's result
+            if (const char* benchmark = std::getenv("NCE_DRAW_BENCHMARK")) {
+                object_grid = OBJECT_GRID;
+                benchmark_textures = std::min(static_cast<u32>(std::max(std::atoi(benchmark), 0)), MAX_BINDLESS_TEXTURES - static_cast<u32>(TEXTURE_PATHS.size()));
+                fmt::println("draw benchmark: {} objects, {} textures", object_grid * object_grid, TEXTURE_PATHS.size() + benchmark_textures);
+            }
+
+            // file parsing and decoding need no device, they overlap instance and device creation.
+            // Every stage that records or submits commands depends on the previous one, they share pools and queues.
+            std::vector<DecodedTexture> decoded_textures(TEXTURE_PATHS.size() + benchmark_textures);
+            TaskGraph startup;
+            TaskHandle model = startup.add("load_model", [this] { load_model(); });
+            TaskHandle decode = startup.add("decode_textures", [this, &decoded_textures] {
+                    for (const auto& [decoded, path] : std::views::zip(decoded_textures, TEXTURE_PATHS)) {
+                        decoded = decode_texture(path);
+                    }
+                    for (u32 i = 0; i < benchmark_textures; i++) {
+                        decoded_textures[TEXTURE_PATHS.size() + i] = generate_texture(i);
+                    }
+                    });
+            TaskHandle instance_stage = startup.add("instance", [this, &primary] {
+                    create_instance();
+                    create_surface(primary);
+                    });
+            TaskHandle device = startup.add("device", [this] {
+                    pick_physical_device();
+                    create_logical_device();
+                    create_pipeline_cache();
+                    }, {instance_stage});
+            TaskHandle swapchain_stage = startup.add("swapchain", [this, &primary] {
+                    create_swapchain(primary);
+                    create_image_views(primary);
+                    color_format = primary.swapchain_image_format;
+                    }, {device});
+            TaskHandle layouts = startup.add("descriptor_layouts", [this] { create_descriptor_set_layout(); }, {device});
+            startup.add("graphics_pipeline", [this] { create_graphics_pipeline(); }, {swapchain_stage, layouts});
+            startup.add("cull_pipeline", [this] { create_cull_pipeline(); }, {layouts});
+            startup.add("hiz_pipeline", [this] { create_hiz_pipeline(); }, {layouts});
+            TaskHandle commands = startup.add("command_pools", [this, &primary] {
+                    create_command_pool();
+                    create_upload_context();
+                    create_command_buffers();
+                    create_sync_objects();
+                    create_semaphores(primary);
+                    create_frame_stats();
+                    create_stats_buffers(primary);
+                    }, {device});
+            TaskHandle descriptors = startup.add("descriptor_sets", [this, &primary] {
+                    create_uniform_buffers(primary);
+                    create_descriptor_pool();
+                    create_descriptor_sets(primary);
+                    }, {layouts});
+            TaskHandle attachments = startup.add("attachments", [this, &primary] {
+                    create_hiz_resources(primary);
+                    create_frame_graph(primary);
+                    }, {swapchain_stage, commands});
+            TaskHandle textures_stage = startup.add("textures", [this, &decoded_textures] {
+                    create_texture_image(decoded_textures);
+                    create_texture_image_view();
+                    create_texture_sampler();
+                    for (auto& texture : textures) {
+                        texture.slot = register_texture(texture.view.get());
+                    }
+                    }, {decode, descriptors, attachments});
+            startup.add("geometry", [this] {
+                    create_vertex_buffer();
+                    create_index_buffer();
+                    create_object_buffer();
+                    create_cull_buffers();
+                    }, {model, textures_stage});
+
+            print_timeline(startup.run(STARTUP_THREADS));
+        }
+    Instance::~Instance() {
+        print_frame_stats(culled_totals, unculled_totals);
+        print_memory_stats(memory_stats());
+        print_descriptor_stats(descriptor_stats());
+    }
+
+    void Instance::recreate_swapchain(Viewport& viewport) {
         u32 width = 0, height = 0;
-        width = window.attributes.dimensions.x;
-        height = window.attributes.dimensions.y;
+        width = viewport.window.attributes.dimensions.x;
+        height = viewport.window.attributes.dimensions.y;
         while (width == 0 || height == 0) {
-            width = window.attributes.dimensions.x;
-            height = window.attributes.dimensions.y;
+            width = viewport.window.attributes.dimensions.x;
+            height = viewport.window.attributes.dimensions.y;
         }
 
         vkDeviceWaitIdle(logical_device.get());
 
-        create_swapchain();
-        create_image_views();
-        create_depth_resources();
-        create_framebuffers();
+        create_swapchain(viewport);
+        create_image_views(viewport);
+        create_hiz_resources(viewport);
+        create_frame_graph(viewport);
+    }
+    auto Instance::add_window(window::Window& window) -> Viewport& {
+        if (viewports.size() == MAX_VIEWPORTS) {
+            LOGERROR("Too many windows");
+            std::abort();
+        }
+        Viewport& viewport = *viewports.emplace_back(std::make_unique<Viewport>(window));
+        create_surface(viewport);
+        // the device was picked for the first window's surface, the present queue has to reach this one too
+        VkBool32 present_support = false;
+        vkGetPhysicalDeviceSurfaceSupportKHR(physical_device, queue_families.present_family.value(), viewport.surface.get(), &present_support);
+        if (!present_support) {
+            LOGERROR("Window Not Presentable");
+            std::abort();
+        }
+        create_swapchain(viewport);
+        create_image_views(viewport);
+        create_semaphores(viewport);
+        create_uniform_buffers(viewport);
+        create_descriptor_sets(viewport);
+        create_hiz_resources(viewport);
+        create_draw_buffers(viewport);
+        create_stats_buffers(viewport);
+        create_frame_graph(viewport);
+        viewport.set_camera(Camera{{2.0f, 2.0f, 2.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, glm::radians(45.0f), 0.1f, 10.0f});
+        return viewport;
+    }
+    void Instance::create_pipeline_cache() {
+        // every pipeline is built through it, later variants reuse what the first compiles shared
+        VkPipelineCacheCreateInfo create_info = {
+            // VkStructureType               sType;
+            // const void*                   pNext;
+            // VkPipelineCacheCreateFlags    flags;
+            // size_t                        initialDataSize;
+            // const void*                   pInitialData;
+        };
+        create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+        VkPipelineCache l_cache = nullptr;
+        vke::Result result = vkCreatePipelineCache(logical_device.get(), &create_info, nullptr, &l_cache);
+        VKE_RESULT_CRASH(result);
+        pipeline_cache = std::unique_ptr<VkPipelineCache_T, VKEPipelineCacheDeleter>(l_cache);
     }
     void Instance::create_logical_device() {
         // Specifying the queues to be created
         QueueFamilyIndices indices = find_queue_families(this->physical_device);
 
         std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
-        std::set<u32> unique_queue_families = {indices.graphics_family.value(), indices.present_family.value()};
+        std::vector<u32> unique_queue_families = indices.unique_families();
 
         const float queue_priority = 1.0f;
         for (auto queue_family : unique_queue_families) {
@@ -1181,6 +2178,32 @@ namespace vke {
         // Specifying used device features
         VkPhysicalDeviceFeatures device_features = {};
         device_features.samplerAnisotropy = VK_TRUE;
+        // culled draws are issued with one vkCmdDrawIndexedIndirectCount, the object index travels in firstInstance
+        device_features.multiDrawIndirect = VK_TRUE;
+        device_features.drawIndirectFirstInstance = VK_TRUE;
+        device_features.shaderStorageBufferArrayDynamicIndexing = VK_TRUE;
+
+        // render graph barriers are recorded with vkCmdPipelineBarrier2, passes render without VkRenderPass
+        VkPhysicalDeviceVulkan13Features vulkan13_features{};
+        vulkan13_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        vulkan13_features.synchronization2 = VK_TRUE;
+        vulkan13_features.dynamicRendering = VK_TRUE;
+
+        // bindless textures and object buffers
+        VkPhysicalDeviceVulkan12Features vulkan12_features{};
+        vulkan12_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        vulkan12_features.descriptorIndexing = VK_TRUE;
+        vulkan12_features.runtimeDescriptorArray = VK_TRUE;
+        vulkan12_features.descriptorBindingPartiallyBound = VK_TRUE;
+        vulkan12_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        vulkan12_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        vulkan12_features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        // uploads signal a timeline semaphore instead of blocking on vkQueueWaitIdle
+        vulkan12_features.timelineSemaphore = VK_TRUE;
+        vulkan12_features.drawIndirectCount = VK_TRUE;
+        // the Hi-Z pyramid is built and sampled with a max reduction sampler
+        vulkan12_features.samplerFilterMinmax = VK_TRUE;
+        vulkan13_features.pNext = &vulkan12_features;
 
         // Creating the logical device
         VkDeviceCreateInfo create_info = {
@@ -1196,12 +2219,17 @@ namespace vke {
             // const VkPhysicalDeviceFeatures*    pEnabledFeatures;
         };
         create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        create_info.pNext = &vulkan13_features;
         create_info.pQueueCreateInfos = queue_create_infos.data();
         create_info.queueCreateInfoCount = static_cast<u32>(queue_create_infos.size());
         create_info.pEnabledFeatures = &device_features;
 
-        create_info.enabledExtensionCount = static_cast<u32>(this->device_extensions.size());
-        create_info.ppEnabledExtensionNames = this->device_extensions.data();
+        // VK_EXT_memory_budget is optional, without it the budget falls back to the heap sizes
+        std::vector<CString> extensions(device_extensions.begin(), device_extensions.end());
+        memory_budget_extension = supports_device_extension(physical_device, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        if (memory_budget_extension) { extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME); }
+        create_info.enabledExtensionCount = static_cast<u32>(extensions.size());
+        create_info.ppEnabledExtensionNames = extensions.data();
 
         if (use_validation_layers) {
             create_info.enabledLayerCount = static_cast<u32>(this->validation_layers.size());
@@ -1214,33 +2242,32 @@ namespace vke {
         //create logical device
         vke::Result result = vkCreateDevice(this->physical_device, &create_info, nullptr, reinterpret_cast<VkDevice*>(&this->logical_device));
         VKE_RESULT_CRASH(result)
+        // per-frame calls go straight to the driver instead of through the loader's trampolines
+        dispatch = render_api::DeviceDispatch::load(instance_dispatch, logical_device.get());
+        refresh_memory_budget();
 
-            vkGetDeviceQueue(this->logical_device.get(), indices.graphics_family.value(), 0, &this->graphics_queue);
+        vkGetDeviceQueue(this->logical_device.get(), indices.graphics_family.value(), 0, &this->graphics_queue);
         vkGetDeviceQueue(this->logical_device.get(), indices.present_family.value(), 0, &this->present_queue);
+        vkGetDeviceQueue(this->logical_device.get(), indices.transfer_family.value(), 0, &this->transfer_queue);
+        vkGetDeviceQueue(this->logical_device.get(), indices.compute_family.value(), 0, &this->compute_queue);
+        queue_families = indices;
+        fmt::println("queue families: graphics {}, present {}, transfer {}{}, compute {}{}",
+                *indices.graphics_family, *indices.present_family,
+                *indices.transfer_family, indices.dedicated_transfer() ? " (dedicated)" : "",
+                *indices.compute_family, indices.dedicated_compute() ? " (dedicated)" : "");
     }
     auto Instance::find_queue_families(VkPhysicalDevice device) -> QueueFamilyIndices {
-        QueueFamilyIndices indices;
-
         u32 queue_family_count = 0;
         vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_count, nullptr);
         std::vector<VkQueueFamilyProperties> queue_families;
         queue_families.resize(queue_family_count);
         vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_count, queue_families.data());
 
-        VkBool32 present_support = 0;
-        for (const auto& [index, queue_family] : std::views::enumerate(queue_families) ) {
-            if (queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
-                indices.graphics_family = index;
-            }
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, static_cast<u32>(index), this->surface.get(), &present_support);
-            if (present_support) {
-                indices.present_family = index;
-            }
-            if (indices.has_value()) { return indices; }
-        }
-
-
-        return indices;
+        return select_queue_families(queue_families, [&](u32 family) {
+                VkBool32 present_support = 0;
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, family, viewports.front()->surface.get(), &present_support);
+                return present_support == VK_TRUE;
+                });
     }
     auto Instance::rate_device(VkPhysicalDevice device) -> u32 {
         VkPhysicalDeviceProperties device_properties;
@@ -1272,14 +2299,28 @@ namespace vke {
 
         bool swapchain_adequate = false;
         if (extensions_supported) {
-            SwapChainSupportDetails swapchain_support = query_swapchain_support(device, this->surface.get());
+            SwapChainSupportDetails swapchain_support = query_swapchain_support(device, viewports.front()->surface.get());
             swapchain_adequate = !swapchain_support.formats.empty() && !swapchain_support.present_modes.empty();
         }
 
         VkPhysicalDeviceFeatures supported_features;
         vkGetPhysicalDeviceFeatures(device, &supported_features);
 
-        return indices.has_value() && extensions_supported && swapchain_adequate && supported_features.samplerAnisotropy;
+        VkPhysicalDeviceVulkan12Features vulkan12_features{};
+        vulkan12_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &vulkan12_features;
+        vkGetPhysicalDeviceFeatures2(device, &features2);
+        bool bindless_supported = vulkan12_features.runtimeDescriptorArray
+            && vulkan12_features.descriptorBindingPartiallyBound
+            && vulkan12_features.shaderSampledImageArrayNonUniformIndexing
+            && vulkan12_features.descriptorBindingSampledImageUpdateAfterBind
+            && vulkan12_features.descriptorBindingStorageBufferUpdateAfterBind;
+
+        return indices.has_value() && extensions_supported && swapchain_adequate && supported_features.samplerAnisotropy && bindless_supported && vulkan12_features.timelineSemaphore
+            && vulkan12_features.drawIndirectCount && supported_features.multiDrawIndirect && supported_features.drawIndirectFirstInstance
+            && vulkan12_features.samplerFilterMinmax;
     }
     auto Instance::check_device_extension_support(VkPhysicalDevice device) const -> bool {
         u32 extension_count;
@@ -1297,6 +2338,15 @@ namespace vke {
 
         return requiredExtensions.empty();
     }
+    auto Instance::supports_device_extension(VkPhysicalDevice device, std::string_view name) const -> bool {
+        u32 extension_count;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, nullptr);
+
+        std::vector<VkExtensionProperties> available_extensions(extension_count);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, available_extensions.data());
+
+        return std::ranges::any_of(available_extensions, [&](const VkExtensionProperties& extension) { return name == extension.extensionName; });
+    }
     auto Instance::choose_swap_surface_format(const std::vector<VkSurfaceFormatKHR>& available_formats) const -> VkSurfaceFormatKHR {
         for (const auto& available_format : available_formats) {
             if (available_format.format == VK_FORMAT_B8G8R8A8_SRGB && available_format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
@@ -1322,7 +2372,7 @@ namespace vke {
         return desired;
     }
 
-    auto Instance::choose_swap_extent(const VkSurfaceCapabilitiesKHR& capabilities) const -> VkExtent2D {
+    auto Instance::choose_swap_extent(const VkSurfaceCapabilitiesKHR& capabilities, const window::Window& window) const -> VkExtent2D {
         if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
             return capabilities.currentExtent;
         } else {
@@ -1396,15 +2446,18 @@ namespace vke {
     void VKESurfaceDeleter::operator()(VkSurfaceKHR_T* ptr){ vkDestroySurfaceKHR(Instance::instance.get(), ptr, nullptr); } 
     void VKEShaderModuleDeleter::operator()(VkShaderModule_T* ptr) { vkDestroyShaderModule(Instance::logical_device.get(), ptr, nullptr); }
     void VKEPipelineLayoutDeleter::operator()(VkPipelineLayout_T* ptr) { vkDestroyPipelineLayout(Instance::logical_device.get(), ptr, nullptr); }
-    void VKERenderPassDeleter::operator()(VkRenderPass_T* ptr) { vkDestroyRenderPass(Instance::logical_device.get(), ptr, nullptr); }
     void VKEGraphicsPipelineDeleter::operator()(VkPipeline_T* ptr) { vkDestroyPipeline(Instance::logical_device.get(), ptr, nullptr); }
-    void VKEFramebufferDeleter::operator()(VkFramebuffer_T* ptr) { vkDestroyFramebuffer(Instance::logical_device.get(), ptr, nullptr); }
+    void VKEPipelineCacheDeleter::operator()(VkPipelineCache_T* ptr) { vkDestroyPipelineCache(Instance::logical_device.get(), ptr, nullptr); }
     void VKECommandPoolDeleter::operator()(VkCommandPool_T* ptr) { vkDestroyCommandPool(Instance::logical_device.get(), ptr, nullptr); }
     void VKESemaphoreDeleter::operator()(VkSemaphore_T* ptr) { vkDestroySemaphore(Instance::logical_device.get(), ptr, nullptr); }
     void VKEFenceDeleter::operator()(VkFence_T* ptr) { vkDestroyFence(Instance::logical_device.get(), ptr, nullptr); }
     void VKEBufferDeleter::operator()(VkBuffer_T* ptr) { vkDestroyBuffer(Instance::logical_device.get(), ptr, nullptr); }
-    void VKEMemoryDeleter::operator()(VkDeviceMemory_T* ptr) { vkFreeMemory(Instance::logical_device.get(), ptr, nullptr); }
-    void VKEDescriptorSetLayoutDeleter::operator()(VkDescriptorSetLayout_T* ptr) { vkDestroyDescriptorSetLayout(Instance::logical_device.get(), ptr, nullptr); }
+    void VKEQueryPoolDeleter::operator()(VkQueryPool_T* ptr) { vkDestroyQueryPool(Instance::logical_device.get(), ptr, nullptr); }
+    void STBImageDeleter::operator()(u8* ptr) { stbi_image_free(ptr); }
+    void VKEMemoryDeleter::operator()(VkDeviceMemory_T* ptr) {
+        Instance::memory_budget.on_free(ptr);
+        vkFreeMemory(Instance::logical_device.get(), ptr, nullptr);
+    }
     void VKEDescriptorPoolDeleter::operator()(VkDescriptorPool_T* ptr) { vkDestroyDescriptorPool(Instance::logical_device.get(), ptr, nullptr); }
     void VKEImageDeleter::operator()(VkImage_T* ptr) { vkDestroyImage(Instance::logical_device.get(), ptr, nullptr); }
     void VKESampleDeleter::operator()(VkSampler_T* ptr) { vkDestroySampler(Instance::logical_device.get(), ptr, nullptr); }
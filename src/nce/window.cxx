@@ -2,97 +2,161 @@
 #include <nce/window.hxx>
 #include <xcb/xproto.h>
 
+#include <chrono>
 
 
-bool KeyMap::is_pressed(nce::KeyCode code) {
-    if (keys.find(code) == keys.end()) {
-        return false;
+namespace window {
+void Window::poll_events() {
+    auto begin = std::chrono::steady_clock::now();
+    exposes = 0;
+    round_trips = 0;
+    if (input_thread) {
+        input_thread->acknowledge();
+        event_stats = drain_input(input_thread->queue(), event_ring, input_latency, [this](EventRing& ring) { process_events(ring); });
+    } else if (x_connection) {
+        event_stats = pump_events(event_ring, event_filter,
+                [this] { return peeked ? peeked.release() : xcb_poll_for_event(x_connection.get()); },
+                [this](EventRing& ring) { process_events(ring); });
+    } else {
+        event_stats = {};
     }
-    auto val = keys[code].pressed;
-    bool ret_val = val.curr && !val.prev;
-    if (ret_val) { // consume the key press
-        keys[code].pressed.push(false);
+    if (replay) {
+        for (const RecordedEvent& recorded : replay->next_frame(input_clock_ns())) {
+            // a real window keeps the geometry the server gives it
+            if (x_connection && !is_input_event(recorded.event.type)) { continue; }
+            if (recorder) { recorder->record(frame_index, input_clock_ns(), recorded.event, recorded.keysym); }
+            handle_event(recorded.event, recorded.keysym);
+            event_stats.processed++;
+        }
     }
-    return ret_val;
-}
-bool KeyMap::is_down(nce::KeyCode code) {
-    if (keys.find(code) == keys.end()) {
-        return false;
+    keys.end_frame();
+    pointer.end_frame();
+
+    // a drag resize sends a ConfigureNotify per step, the swapchain only needs the last size
+    if (resize_pending) {
+        resize_pending = false;
+        event_stats.resizes = 1;
+        if (resize_callback) {
+            resize_callback(attributes.dimensions.x, attributes.dimensions.y, user_data_ptr);
+        }
     }
-    return keys[code].key_down;
+    // a keymap reload waited for replies, events that arrived meanwhile sit in xcb's queue
+    if (round_trips > 0) { notify_replies_read(); }
+    event_stats.exposes = exposes;
+    event_stats.round_trips = round_trips;
+    event_stats.poll_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    frame_index++;
 }
-
-namespace window {
-void Window::poll_events() {
-    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> x_event(xcb_poll_for_event(x_connection.get()));
-    if (!x_event) return;
-
-    event_queue.push(std::move(x_event));
-    if (!event_queue.curr) return;
-    //fmt::println("Event Sequence numbers [{}, {}]", event_queue.curr->sequence, event_queue.next->sequence);
-
-
-    switch (event_queue.next->response_type & ~0x80) {
-        case XCB_KEY_PRESS: {
-                                [[maybe_unused]] NonOwningPtr<xcb_key_press_event_t> event = reinterpret_cast<xcb_key_press_event_t*>(event_queue.next.get());
-                                xkb_keysym_t keysym = xkb_state_key_get_one_sym(kb_state.get(), event->detail);
-                                xkb_state_update_key(kb_state.get(), event->detail, XKB_KEY_DOWN);
-
-                                keys.keys[static_cast<nce::KeyCode>(keysym)].pressed.push(true);
-                                keys.keys[static_cast<nce::KeyCode>(keysym)].key_down = true;
+void Window::reload_keymap() {
+    round_trips += 2;
+    std::unique_ptr<xkb_keymap, XKBKeyMapDeleter> new_keymap(xkb_x11_keymap_new_from_device(kb_context.get(), x_connection.get(), kb_device_id, XKB_KEYMAP_COMPILE_NO_FLAGS));
+    if (!new_keymap) { LOGERROR("Couldn't reload the keymap, keeping the old one"); return; }
+    std::unique_ptr<xkb_state, XKBStateDeleter> new_state(xkb_x11_state_new_from_device(new_keymap.get(), x_connection.get(), kb_device_id));
+    if (!new_state) { LOGERROR("Couldn't reload the keyboard state, keeping the old one"); return; }
+    keymap = std::move(new_keymap);
+    kb_state = std::move(new_state);
+    // keysyms of held keys may have changed under them
+    keys.invalidate();
+}
+void Window::notify_replies_read() {
+    if (input_thread) { input_thread->wake(); }
+}
+void Window::process_events(EventRing& ring) {
+    while (!ring.empty()) {
+        WindowEvent event = ring.pop();
+        u32 keysym = 0;
+        switch (event.type) {
+            case EventType::key_press:
+                // modifiers are updated by StateNotify, not by the key events themselves
+                keysym = xkb_state_key_get_one_sym(kb_state.get(), event.detail);
 #if 0
-                                fmt::println("Down Sequence numbers [{}]", event->time);
-                                char keysym_name[64];
-                                xkb_keysym_get_name(keysym, keysym_name, sizeof(keysym_name));
-                                fmt::println("{} : {}", keysym_name, keysym);
-                                LOGINFO(keysym_name);
+                fmt::println("Down Sequence numbers [{}]", event.time);
+                char keysym_name[64];
+                xkb_keysym_get_name(keysym, keysym_name, sizeof(keysym_name));
+                fmt::println("{} : {}", keysym_name, keysym);
+                LOGINFO(keysym_name);
 #endif
-                                break;
-                            } 
-        case XCB_KEY_RELEASE: {
-                                [[maybe_unused]] NonOwningPtr<xcb_key_release_event_t> event = reinterpret_cast<xcb_key_release_event_t*>(event_queue.next.get());
-                                xkb_keysym_t keysym = xkb_state_key_get_one_sym(kb_state.get(), event->detail);
-                                xkb_state_update_key(kb_state.get(), event->detail, XKB_KEY_UP);
-
-                                keys.keys[static_cast<nce::KeyCode>(keysym)].pressed.push(false);
-                                if ((event_queue.curr->response_type & ~0x80) == XCB_KEY_PRESS || 
-                                        (event_queue.curr->response_type & ~0x80) == XCB_KEY_RELEASE) {
-                                    NonOwningPtr<xcb_key_press_event_t> event_prev = reinterpret_cast<xcb_key_press_event_t*>(event_queue.curr.get());
-                                    if (event->time != event_prev->time) {
-                                        keys.keys[static_cast<nce::KeyCode>(keysym)].key_down = false;
-                                    }
-                                }
+                break;
+            case EventType::key_release:
+                // the matching press of an auto-repeat pair is already queued behind the release, the key stays down
+                if (!ring.empty() && is_auto_repeat(event, ring.front())) { continue; }
+                keysym = xkb_state_key_get_one_sym(kb_state.get(), event.detail);
 #if 0
-                                fmt::println("Up Sequence numbers   [{}]", event->time);
+                fmt::println("Up Sequence numbers   [{}]", event.time);
 #endif
-                                break;
-                            }
-        case XCB_BUTTON_PRESS: {
-                                [[maybe_unused]] NonOwningPtr<xcb_button_press_event_t> event = reinterpret_cast<xcb_button_press_event_t*>(event_queue.next.get());
-                                break;
-                            }
-        case XCB_BUTTON_RELEASE: {
-                                [[maybe_unused]] NonOwningPtr<xcb_button_release_event_t> event = reinterpret_cast<xcb_button_release_event_t*>(event_queue.next.get());
-                                break;
-                            }
-        case XCB_EXPOSE: {
-            keys.invalidate();
-            std::unique_ptr<xkb_state, XKBStateDeleter> kb_state_temp(xkb_x11_state_new_from_device(keymap.get(), x_connection.get(), kb_device_id));
-            kb_state.swap(kb_state_temp);
-
-            NonOwningPtr<xcb_expose_event_t> event = reinterpret_cast<xcb_expose_event_t*>(event_queue.next.get());
-            if(event->window == this->x_window) {
-                printf("EXPOSE: Rect(%i, %i, %i, %i)\n", event->x, event->y, event->width, event->height);
-                attributes.dimensions.x = event->width;
-                attributes.dimensions.y = event->height;
-                attributes.position.x = event->x;
-                attributes.position.y = event->y;
-                resize_callback(event->width, event->height, user_data_ptr);
+                break;
+            case EventType::keyboard_state:
+                xkb_state_update_mask(kb_state.get(),
+                        static_cast<xkb_mod_mask_t>(event.state & 0xff), static_cast<xkb_mod_mask_t>(event.state >> 8), event.detail,
+                        static_cast<xkb_layout_index_t>(event.x), static_cast<xkb_layout_index_t>(event.y), event.width);
+                continue;
+            case EventType::keyboard_changed:
+                if (event.detail == kb_device_id) {
+                    reload_keymap();
+                }
+                continue;
+            default:
+                break;
+        }
+        // while a replay drives the window, what the user does live must not mix into it
+        if (replay && is_input_event(event.type)) { continue; }
+        if (recorder) { recorder->record(frame_index, input_clock_ns(), event, keysym); }
+        handle_event(event, keysym);
+    }
+}
+void Window::handle_event(const WindowEvent& event, u32 keysym) {
+    switch (event.type) {
+        case EventType::key_press:
+            keys.press(keysym);
+            break;
+        case EventType::key_release:
+            keys.release(keysym);
+            break;
+        case EventType::configure:
+            attributes.position.x = static_cast<u32>(event.x);
+            attributes.position.y = static_cast<u32>(event.y);
+            if (event.width != attributes.dimensions.x || event.height != attributes.dimensions.y) {
+                attributes.dimensions.x = event.width;
+                attributes.dimensions.y = event.height;
+                resize_pending = true;
             }
-        } break;
+            break;
+        case EventType::expose:
+            // another window moved over ours or it was uncovered, nothing about it changed
+            damaged = true;
+            exposes++;
+            break;
+        case EventType::button_press:
+        case EventType::button_release:
+        case EventType::motion:
+            pointer.handle(event);
+            break;
+        case EventType::focus_out:
+            // a release while another window has focus never reaches us
+            pointer.invalidate();
+            break;
+        case EventType::close_requested:
+            close_requested = true;
+            break;
+        case EventType::focus_in:
+        case EventType::keyboard_state:
+        case EventType::keyboard_changed:
+            break;
     }
 }
+auto Window::wait_fd() const -> i32 {
+    if (input_thread) { return input_thread->ready_fd(); }
+    return x_connection ? xcb_get_file_descriptor(x_connection.get()) : -1;
+}
+auto Window::has_pending_input() -> bool {
+    if (replay && !replay->finished()) { return true; }
+    if (input_thread) { return !input_thread->queue().empty(); }
+    if (!x_connection) { return false; }
+    // events xcb read off the socket while waiting for a reply never make the fd readable again
+    if (!peeked) { peeked.reset(xcb_poll_for_queued_event(x_connection.get())); }
+    return peeked != nullptr;
+}
 bool Window::should_close() {
-    return false;
+    return close_requested || (replay && replay->finished());
 }
 }
@@ -0,0 +1,70 @@
+#include <nce/window_events.hxx>
+
+namespace window {
+    auto decode_event(const xcb_generic_event_t& event, const EventFilter& filter) -> std::optional<WindowEvent> {
+        const xcb_window_t window = filter.window;
+        if (filter.xkb_first_event != 0 && event.response_type == filter.xkb_first_event) {
+            // every XKB event shares one response type, the XKB event type is the second byte
+            switch (event.pad0) {
+                case XCB_XKB_STATE_NOTIFY: {
+                    const auto& state = reinterpret_cast<const xcb_xkb_state_notify_event_t&>(event);
+                    return WindowEvent{EventType::keyboard_state, state.lockedMods, static_cast<u16>(state.baseMods | state.latchedMods << 8), state.time,
+                        state.baseGroup, state.latchedGroup, state.lockedGroup};
+                }
+                case XCB_XKB_NEW_KEYBOARD_NOTIFY: {
+                    const auto& keyboard = reinterpret_cast<const xcb_xkb_new_keyboard_notify_event_t&>(event);
+                    return WindowEvent{EventType::keyboard_changed, keyboard.deviceID, 0, keyboard.time};
+                }
+                case XCB_XKB_MAP_NOTIFY: {
+                    const auto& map = reinterpret_cast<const xcb_xkb_map_notify_event_t&>(event);
+                    return WindowEvent{EventType::keyboard_changed, map.deviceID, 0, map.time};
+                }
+            }
+            return std::nullopt;
+        }
+        switch (event.response_type & ~0x80) {
+            case XCB_KEY_PRESS:
+            case XCB_KEY_RELEASE: {
+                const auto& key = reinterpret_cast<const xcb_key_press_event_t&>(event);
+                if (key.event != window) { return std::nullopt; }
+                EventType type = (event.response_type & ~0x80) == XCB_KEY_PRESS ? EventType::key_press : EventType::key_release;
+                return WindowEvent{type, key.detail, key.state, key.time, key.event_x, key.event_y};
+            }
+            case XCB_BUTTON_PRESS:
+            case XCB_BUTTON_RELEASE: {
+                const auto& button = reinterpret_cast<const xcb_button_press_event_t&>(event);
+                if (button.event != window) { return std::nullopt; }
+                EventType type = (event.response_type & ~0x80) == XCB_BUTTON_PRESS ? EventType::button_press : EventType::button_release;
+                return WindowEvent{type, button.detail, button.state, button.time, button.event_x, button.event_y};
+            }
+            case XCB_MOTION_NOTIFY: {
+                const auto& motion = reinterpret_cast<const xcb_motion_notify_event_t&>(event);
+                if (motion.event != window) { return std::nullopt; }
+                return WindowEvent{EventType::motion, motion.detail, motion.state, motion.time, motion.event_x, motion.event_y};
+            }
+            case XCB_CONFIGURE_NOTIFY: {
+                const auto& configure = reinterpret_cast<const xcb_configure_notify_event_t&>(event);
+                if (configure.window != window) { return std::nullopt; }
+                return WindowEvent{EventType::configure, 0, 0, 0, configure.x, configure.y, configure.width, configure.height};
+            }
+            case XCB_EXPOSE: {
+                const auto& expose = reinterpret_cast<const xcb_expose_event_t&>(event);
+                if (expose.window != window) { return std::nullopt; }
+                return WindowEvent{EventType::expose, 0, 0, 0, static_cast<i16>(expose.x), static_cast<i16>(expose.y), expose.width, expose.height};
+            }
+            case XCB_FOCUS_IN:
+            case XCB_FOCUS_OUT: {
+                const auto& focus = reinterpret_cast<const xcb_focus_in_event_t&>(event);
+                if (focus.event != window) { return std::nullopt; }
+                return WindowEvent{(event.response_type & ~0x80) == XCB_FOCUS_IN ? EventType::focus_in : EventType::focus_out};
+            }
+            case XCB_CLIENT_MESSAGE: {
+                const auto& message = reinterpret_cast<const xcb_client_message_event_t&>(event);
+                if (message.window != window || filter.wm_delete_window == XCB_ATOM_NONE) { return std::nullopt; }
+                if (message.type != filter.wm_protocols || message.format != 32 || message.data.data32[0] != filter.wm_delete_window) { return std::nullopt; }
+                return WindowEvent{EventType::close_requested, 0, 0, message.data.data32[1]};
+            }
+        }
+        return std::nullopt;
+    }
+}
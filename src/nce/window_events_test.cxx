@@ -0,0 +1,265 @@
+#include <catch2/catch_test_macros.hpp>
+#include <nce/window_events.hxx>
+
+#include <deque>
+
+
+namespace {
+    constexpr xcb_window_t WINDOW = 0x2a00001;
+    constexpr xcb_window_t OTHER_WINDOW = 0x2a00002;
+    constexpr u8 XKB_FIRST_EVENT = 85;
+    constexpr xcb_atom_t WM_PROTOCOLS = 301;
+    constexpr xcb_atom_t WM_DELETE_WINDOW = 302;
+    constexpr window::EventFilter FILTER{WINDOW, XKB_FIRST_EVENT, WM_PROTOCOLS, WM_DELETE_WINDOW};
+
+    /// @brief A malloc'ed X event, freed by pump_events like one from xcb_poll_for_event.
+    template<typename T> auto make_event(u8 response_type, const T& fields) -> xcb_generic_event_t* {
+        static_assert(sizeof(T) <= sizeof(xcb_generic_event_t) + 4);
+        auto* event = static_cast<T*>(std::calloc(1, sizeof(xcb_generic_event_t) + 4));
+        *event = fields;
+        event->response_type = response_type;
+        return reinterpret_cast<xcb_generic_event_t*>(event);
+    }
+
+    auto key(u8 type, u8 keycode, u32 time, xcb_window_t window = WINDOW) -> xcb_generic_event_t* {
+        xcb_key_press_event_t event{};
+        event.detail = keycode;
+        event.time = time;
+        event.event = window;
+        event.event_x = 10;
+        event.event_y = 20;
+        event.state = XCB_MOD_MASK_SHIFT;
+        return make_event(type, event);
+    }
+    auto motion(u32 time, i16 x, i16 y) -> xcb_generic_event_t* {
+        xcb_motion_notify_event_t event{};
+        event.time = time;
+        event.event = WINDOW;
+        event.event_x = x;
+        event.event_y = y;
+        return make_event(XCB_MOTION_NOTIFY, event);
+    }
+    auto configure(i16 x, i16 y, u16 width, u16 height) -> xcb_generic_event_t* {
+        xcb_configure_notify_event_t event{};
+        event.event = WINDOW;
+        event.window = WINDOW;
+        event.x = x;
+        event.y = y;
+        event.width = width;
+        event.height = height;
+        return make_event(XCB_CONFIGURE_NOTIFY, event);
+    }
+    auto expose(u16 width, u16 height) -> xcb_generic_event_t* {
+        xcb_expose_event_t event{};
+        event.window = WINDOW;
+        event.width = width;
+        event.height = height;
+        return make_event(XCB_EXPOSE, event);
+    }
+
+    auto client_message(xcb_atom_t type, xcb_atom_t protocol, u32 time) -> xcb_generic_event_t* {
+        xcb_client_message_event_t event{};
+        event.format = 32;
+        event.window = WINDOW;
+        event.type = type;
+        event.data.data32[0] = protocol;
+        event.data.data32[1] = time;
+        return make_event(XCB_CLIENT_MESSAGE, event);
+    }
+
+    /// @brief Pending events of a fake connection, popped in order like xcb_poll_for_event.
+    struct FakeConnection {
+        std::deque<xcb_generic_event_t*> pending;
+        ~FakeConnection() { for (auto* event : pending) { std::free(event); } }
+        auto next() -> xcb_generic_event_t* {
+            if (pending.empty()) { return nullptr; }
+            auto* event = pending.front();
+            pending.pop_front();
+            return event;
+        }
+    };
+}
+
+TEST_CASE( "X events decode into window events", "[window_events]" ) {
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> press(key(XCB_KEY_PRESS, 38, 1000));
+    auto decoded = window::decode_event(*press, FILTER);
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->type == window::EventType::key_press);
+    REQUIRE(decoded->detail == 38);
+    REQUIRE(decoded->time == 1000);
+    REQUIRE(decoded->state == XCB_MOD_MASK_SHIFT);
+    REQUIRE(decoded->x == 10);
+    REQUIRE(decoded->y == 20);
+
+    // synthetic events sent with SendEvent have the top bit set
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> sent(key(XCB_KEY_RELEASE | 0x80, 38, 1001));
+    REQUIRE(window::decode_event(*sent, FILTER)->type == window::EventType::key_release);
+
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> moved(configure(5, 6, 1280, 720));
+    decoded = window::decode_event(*moved, FILTER);
+    REQUIRE(decoded->type == window::EventType::configure);
+    REQUIRE(decoded->width == 1280);
+    REQUIRE(decoded->height == 720);
+    REQUIRE(decoded->x == 5);
+
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> other(key(XCB_KEY_PRESS, 38, 1000, OTHER_WINDOW));
+    REQUIRE_FALSE(window::decode_event(*other, FILTER).has_value());
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> unhandled(make_event(XCB_PROPERTY_NOTIFY, xcb_property_notify_event_t{}));
+    REQUIRE_FALSE(window::decode_event(*unhandled, FILTER).has_value());
+}
+
+TEST_CASE( "XKB events decode by their XKB type", "[window_events]" ) {
+    xcb_xkb_state_notify_event_t state{};
+    state.xkbType = XCB_XKB_STATE_NOTIFY;
+    state.baseMods = XCB_MOD_MASK_SHIFT;
+    state.latchedMods = XCB_MOD_MASK_CONTROL;
+    state.lockedMods = XCB_MOD_MASK_LOCK;
+    state.baseGroup = 1;
+    state.lockedGroup = 2;
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> state_event(make_event(XKB_FIRST_EVENT, state));
+    auto decoded = window::decode_event(*state_event, FILTER);
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->type == window::EventType::keyboard_state);
+    REQUIRE(decoded->state == (XCB_MOD_MASK_SHIFT | XCB_MOD_MASK_CONTROL << 8));
+    REQUIRE(decoded->detail == XCB_MOD_MASK_LOCK);
+    REQUIRE(decoded->x == 1);
+    REQUIRE(decoded->width == 2);
+
+    xcb_xkb_new_keyboard_notify_event_t keyboard{};
+    keyboard.xkbType = XCB_XKB_NEW_KEYBOARD_NOTIFY;
+    keyboard.deviceID = 3;
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> keyboard_event(make_event(XKB_FIRST_EVENT, keyboard));
+    REQUIRE(window::decode_event(*keyboard_event, FILTER)->type == window::EventType::keyboard_changed);
+
+    xcb_xkb_map_notify_event_t map{};
+    map.xkbType = XCB_XKB_MAP_NOTIFY;
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> map_event(make_event(XKB_FIRST_EVENT, map));
+    REQUIRE(window::decode_event(*map_event, FILTER)->type == window::EventType::keyboard_changed);
+
+    // without XKB selected the same response type is not special
+    REQUIRE_FALSE(window::decode_event(*state_event, window::EventFilter{WINDOW, 0}).has_value());
+}
+
+TEST_CASE( "WM_DELETE_WINDOW decodes into a close request", "[window_events]" ) {
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> close(client_message(WM_PROTOCOLS, WM_DELETE_WINDOW, 4242));
+    auto decoded = window::decode_event(*close, FILTER);
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->type == window::EventType::close_requested);
+    REQUIRE(decoded->time == 4242);
+
+    // other protocols and other client messages are not a close
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> ping(client_message(WM_PROTOCOLS, 303, 4243));
+    REQUIRE_FALSE(window::decode_event(*ping, FILTER).has_value());
+    std::unique_ptr<xcb_generic_event_t, CFreeDeleter> other(client_message(304, WM_DELETE_WINDOW, 4244));
+    REQUIRE_FALSE(window::decode_event(*other, FILTER).has_value());
+    // before the atoms are known nothing matches
+    REQUIRE_FALSE(window::decode_event(*close, window::EventFilter{WINDOW, XKB_FIRST_EVENT}).has_value());
+}
+
+TEST_CASE( "A burst of 10k events is drained in one call", "[window_events]" ) {
+    constexpr u32 BURST = 10000;
+    FakeConnection connection;
+    u32 handled = 0;
+    for (u32 i = 0; i < BURST; i++) {
+        switch (i % 8) {
+            case 0: connection.pending.push_back(key(XCB_KEY_PRESS, 38, i)); break;
+            case 1: connection.pending.push_back(key(XCB_KEY_RELEASE, 38, i)); break;
+            case 2: connection.pending.push_back(key(XCB_KEY_PRESS, 38, i, OTHER_WINDOW)); continue;
+            case 3: connection.pending.push_back(make_event(XCB_PROPERTY_NOTIFY, xcb_property_notify_event_t{})); continue;
+            case 4: connection.pending.push_back(configure(0, 0, 1280, static_cast<u16>(i))); break;
+            case 5: connection.pending.push_back(expose(1280, 720)); break;
+            default: connection.pending.push_back(motion(i, static_cast<i16>(i % 1000), 7)); break;
+        }
+        handled++;
+    }
+
+    window::EventRing ring;
+    std::vector<window::WindowEvent> seen;
+    auto stats = window::pump_events(ring, FILTER, [&] { return connection.next(); }, [&](window::EventRing& batch) {
+            while (!batch.empty()) { seen.push_back(batch.pop()); }
+            });
+
+    REQUIRE(connection.pending.empty());
+    REQUIRE(stats.received == BURST);
+    REQUIRE(stats.processed == handled);
+    REQUIRE(seen.size() == handled);
+    REQUIRE(stats.max_depth == window::EventRing::CAPACITY);
+    REQUIRE(stats.batches == (handled + window::EventRing::CAPACITY - 1) / window::EventRing::CAPACITY);
+    REQUIRE(ring.empty());
+    // arrival order survives the ring wrapping around
+    u32 last_time = 0;
+    for (const auto& event : seen) {
+        if (event.type == window::EventType::key_press || event.type == window::EventType::motion) {
+            REQUIRE(event.time >= last_time);
+            last_time = event.time;
+        }
+    }
+
+    // nothing pending is a no-op
+    stats = window::pump_events(ring, FILTER, [&] { return connection.next(); }, [](window::EventRing&) { FAIL("no batch expected"); });
+    REQUIRE(stats.received == 0);
+    REQUIRE(stats.batches == 0);
+}
+
+TEST_CASE( "The ring keeps FIFO order across wrap around", "[window_events]" ) {
+    window::EventRing ring;
+    for (u32 round = 0; round < 3; round++) {
+        for (u32 i = 0; i < window::EventRing::CAPACITY; i++) {
+            REQUIRE(ring.push(window::WindowEvent{window::EventType::motion, 0, 0, i}));
+        }
+        REQUIRE(ring.full());
+        REQUIRE_FALSE(ring.push(window::WindowEvent{window::EventType::motion}));
+        for (u32 i = 0; i < window::EventRing::CAPACITY / 2; i++) {
+            REQUIRE(ring.pop().time == i);
+        }
+        for (u32 i = 0; i < window::EventRing::CAPACITY / 2; i++) {
+            REQUIRE(ring.push(window::WindowEvent{window::EventType::motion, 0, 0, window::EventRing::CAPACITY + i}));
+        }
+        for (u32 i = window::EventRing::CAPACITY / 2; i < window::EventRing::CAPACITY * 3 / 2; i++) {
+            REQUIRE(ring.pop().time == i);
+        }
+        REQUIRE(ring.empty());
+    }
+}
+
+TEST_CASE( "Auto-repeat pairs are recognized", "[window_events]" ) {
+    window::WindowEvent release{window::EventType::key_release, 38, 0, 500};
+    REQUIRE(window::is_auto_repeat(release, window::WindowEvent{window::EventType::key_press, 38, 0, 500}));
+    REQUIRE_FALSE(window::is_auto_repeat(release, window::WindowEvent{window::EventType::key_press, 38, 0, 530}));
+    REQUIRE_FALSE(window::is_auto_repeat(release, window::WindowEvent{window::EventType::key_press, 39, 0, 500}));
+    REQUIRE_FALSE(window::is_auto_repeat(release, window::WindowEvent{window::EventType::motion, 38, 0, 500}));
+}
+
+TEST_CASE( "An auto-repeat pair on a full ring stays together", "[window_events]" ) {
+    FakeConnection connection;
+    // the release is the last event that fits, its press is the first of the next batch
+    for (u32 i = 0; i < window::EventRing::CAPACITY - 1; i++) {
+        connection.pending.push_back(motion(i, static_cast<i16>(i % 1000), 7));
+    }
+    connection.pending.push_back(key(XCB_KEY_RELEASE, 38, 5000));
+    connection.pending.push_back(key(XCB_KEY_PRESS, 38, 5000));
+    connection.pending.push_back(key(XCB_KEY_RELEASE, 38, 5100));
+
+    window::EventRing ring;
+    std::vector<window::WindowEvent> keys;
+    std::vector<u32> batch_sizes;
+    // classifies like Window::process_events
+    auto stats = window::pump_events(ring, FILTER, [&] { return connection.next(); }, [&](window::EventRing& batch) {
+            batch_sizes.push_back(batch.size());
+            while (!batch.empty()) {
+                window::WindowEvent event = batch.pop();
+                if (event.type == window::EventType::key_release && !batch.empty() && window::is_auto_repeat(event, batch.front())) { continue; }
+                if (event.type != window::EventType::motion) { keys.push_back(event); }
+            }
+            });
+
+    REQUIRE(stats.processed == window::EventRing::CAPACITY + 2);
+    REQUIRE(batch_sizes == std::vector<u32>{window::EventRing::CAPACITY - 1, 3});
+    // the repeated press is the only one, the key only went up at the end
+    REQUIRE(keys.size() == 2);
+    REQUIRE(keys[0].type == window::EventType::key_press);
+    REQUIRE(keys[0].time == 5000);
+    REQUIRE(keys[1].type == window::EventType::key_release);
+    REQUIRE(keys[1].time == 5100);
+    REQUIRE(ring.empty());
+}
@@ -0,0 +1,19 @@
+#include <render_api/dispatch.hxx>
+
+namespace render_api {
+    auto InstanceDispatch::load(VkInstance instance, PFN_vkGetInstanceProcAddr get_proc_addr) -> InstanceDispatch {
+        InstanceDispatch dispatch{};
+#define RENDER_API_LOAD_FUNCTION(name) dispatch.name = reinterpret_cast<PFN_vk##name>(get_proc_addr(instance, "vk" #name));
+        RENDER_API_INSTANCE_FUNCTIONS(RENDER_API_LOAD_FUNCTION)
+#undef RENDER_API_LOAD_FUNCTION
+        return dispatch;
+    }
+
+    auto DeviceDispatch::load(const InstanceDispatch& instance, VkDevice device) -> DeviceDispatch {
+        DeviceDispatch dispatch{};
+#define RENDER_API_LOAD_FUNCTION(name) dispatch.name = reinterpret_cast<PFN_vk##name>(instance.GetDeviceProcAddr(device, "vk" #name));
+        RENDER_API_DEVICE_FUNCTIONS(RENDER_API_LOAD_FUNCTION)
+#undef RENDER_API_LOAD_FUNCTION
+        return dispatch;
+    }
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <render_api/dispatch.hxx>
+#include <render_api/result.hxx>
+
+/**
+ *  Per-call overhead of the loader trampolines against the device dispatch table.
+ *  Needs a Vulkan device, so it is not registered with ctest. Run it on lavapipe with
+ *      VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json ./dispatch_bench
+ */
+
+namespace {
+    constexpr u32 COMMANDS_PER_RUN = 10000;
+
+    struct Headless {
+        VkInstance instance = VK_NULL_HANDLE;
+        VkDevice device = VK_NULL_HANDLE;
+        VkCommandPool command_pool = VK_NULL_HANDLE;
+        VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+        VkPipelineLayout pipeline_layout = VK_NULL_HANDLE;
+
+        ~Headless() {
+            if (device) {
+                vkDestroyPipelineLayout(device, pipeline_layout, nullptr);
+                vkDestroyCommandPool(device, command_pool, nullptr);
+                vkDestroyDevice(device, nullptr);
+            }
+            if (instance) { vkDestroyInstance(instance, nullptr); }
+        }
+    };
+
+    /// @brief Instance and device without a surface, a CPU device such as lavapipe is preferred.
+    auto create_headless(Headless& headless) -> bool {
+        VkApplicationInfo application_info{};
+        application_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        application_info.apiVersion = VK_API_VERSION_1_3;
+        VkInstanceCreateInfo instance_info{};
+        instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instance_info.pApplicationInfo = &application_info;
+        if (vkCreateInstance(&instance_info, nullptr, &headless.instance) != VK_SUCCESS) { return false; }
+
+        u32 device_count = 0;
+        vkEnumeratePhysicalDevices(headless.instance, &device_count, nullptr);
+        std::vector<VkPhysicalDevice> devices(device_count);
+        vkEnumeratePhysicalDevices(headless.instance, &device_count, devices.data());
+        if (devices.empty()) { return false; }
+        VkPhysicalDevice physical_device = devices.front();
+        for (VkPhysicalDevice candidate : devices) {
+            VkPhysicalDeviceProperties properties{};
+            vkGetPhysicalDeviceProperties(candidate, &properties);
+            if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) { physical_device = candidate; }
+        }
+
+        const f32 queue_priority = 1.0f;
+        VkDeviceQueueCreateInfo queue_info{};
+        queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queue_info.queueFamilyIndex = 0;
+        queue_info.queueCount = 1;
+        queue_info.pQueuePriorities = &queue_priority;
+        VkDeviceCreateInfo device_info{};
+        device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        device_info.queueCreateInfoCount = 1;
+        device_info.pQueueCreateInfos = &queue_info;
+        if (vkCreateDevice(physical_device, &device_info, nullptr, &headless.device) != VK_SUCCESS) { return false; }
+
+        VkCommandPoolCreateInfo pool_info{};
+        pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        pool_info.queueFamilyIndex = 0;
+        render_api::Result result = vkCreateCommandPool(headless.device, &pool_info, nullptr, &headless.command_pool);
+        VKE_RESULT_CRASH(result, "Failed to create command pool");
+
+        VkCommandBufferAllocateInfo alloc_info{};
+        alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        alloc_info.commandPool = headless.command_pool;
+        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        alloc_info.commandBufferCount = 1;
+        result = vkAllocateCommandBuffers(headless.device, &alloc_info, &headless.command_buffer);
+        VKE_RESULT_CRASH(result, "Failed to allocate command buffer");
+
+        VkPushConstantRange push_constant_range{VK_SHADER_STAGE_VERTEX_BIT, 0, 64};
+        VkPipelineLayoutCreateInfo layout_info{};
+        layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layout_info.pushConstantRangeCount = 1;
+        layout_info.pPushConstantRanges = &push_constant_range;
+        result = vkCreatePipelineLayout(headless.device, &layout_info, nullptr, &headless.pipeline_layout);
+        VKE_RESULT_CRASH(result, "Failed to create pipeline layout");
+        return true;
+    }
+}
+
+TEST_CASE( "Command recording through the loader and the dispatch table", "[!benchmark][dispatch]" ) {
+    Headless headless;
+    if (!create_headless(headless)) {
+        SKIP("no Vulkan device");
+    }
+    auto instance = render_api::InstanceDispatch::load(headless.instance);
+    auto table = render_api::DeviceDispatch::load(instance, headless.device);
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VkViewport viewport{0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f};
+    VkRect2D scissor{{0, 0}, {1280, 720}};
+    std::array<f32, 16> push_constants{};
+    VkCommandBuffer command_buffer = headless.command_buffer;
+    VkPipelineLayout layout = headless.pipeline_layout;
+
+    // the same three commands per iteration, only the call path differs
+    BENCHMARK("loader trampolines") {
+        vkResetCommandBuffer(command_buffer, 0);
+        vkBeginCommandBuffer(command_buffer, &begin_info);
+        for (u32 i = 0; i < COMMANDS_PER_RUN; i++) {
+            vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+            vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+            vkCmdPushConstants(command_buffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push_constants), push_constants.data());
+        }
+        return vkEndCommandBuffer(command_buffer);
+    };
+    BENCHMARK("device dispatch table") {
+        table.ResetCommandBuffer(command_buffer, 0);
+        table.BeginCommandBuffer(command_buffer, &begin_info);
+        for (u32 i = 0; i < COMMANDS_PER_RUN; i++) {
+            table.CmdSetViewport(command_buffer, 0, 1, &viewport);
+            table.CmdSetScissor(command_buffer, 0, 1, &scissor);
+            table.CmdPushConstants(command_buffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(push_constants), push_constants.data());
+        }
+        return table.EndCommandBuffer(command_buffer);
+    };
+}
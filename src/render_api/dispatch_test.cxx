@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+#include <render_api/dispatch.hxx>
+
+#include <string>
+#include <string_view>
+
+
+namespace {
+    // stand-ins for driver entry points, only their addresses matter
+    void instance_entry() {}
+    void device_a_entry() {}
+    void device_b_entry() {}
+
+    auto device_a = reinterpret_cast<VkDevice>(std::uintptr_t{0x10});
+    std::vector<std::string> requested;
+
+    auto get_device_proc_addr(VkDevice device, const char* name) -> PFN_vkVoidFunction {
+        requested.emplace_back(name);
+        // the swapchain extension was not enabled on this device
+        if (std::string_view(name) == "vkQueuePresentKHR") { return nullptr; }
+        return device == device_a ? device_a_entry : device_b_entry;
+    }
+    auto get_instance_proc_addr([[maybe_unused]] VkInstance instance, const char* name) -> PFN_vkVoidFunction {
+        requested.emplace_back(name);
+        if (std::string_view(name) == "vkGetDeviceProcAddr") {
+            return reinterpret_cast<PFN_vkVoidFunction>(get_device_proc_addr);
+        }
+        return instance_entry;
+    }
+    auto address(auto function) -> PFN_vkVoidFunction { return reinterpret_cast<PFN_vkVoidFunction>(function); }
+}
+
+TEST_CASE( "Instance functions resolve through vkGetInstanceProcAddr", "[dispatch]" ) {
+    requested.clear();
+    auto instance = render_api::InstanceDispatch::load(VK_NULL_HANDLE, get_instance_proc_addr);
+    REQUIRE(address(instance.CreateDevice) == instance_entry);
+    REQUIRE(address(instance.GetPhysicalDeviceProperties) == instance_entry);
+    REQUIRE(address(instance.GetDeviceProcAddr) == address(get_device_proc_addr));
+    REQUIRE(std::ranges::find(requested, "vkGetPhysicalDeviceSurfaceSupportKHR") != requested.end());
+    // every name keeps the vk prefix the driver expects
+    REQUIRE(std::ranges::all_of(requested, [](const std::string& name) { return name.starts_with("vk"); }));
+}
+
+TEST_CASE( "Every device gets its own table", "[dispatch]" ) {
+    auto instance = render_api::InstanceDispatch::load(VK_NULL_HANDLE, get_instance_proc_addr);
+    requested.clear();
+    auto a = render_api::DeviceDispatch::load(instance, device_a);
+    auto b = render_api::DeviceDispatch::load(instance, reinterpret_cast<VkDevice>(std::uintptr_t{0x20}));
+    REQUIRE(requested.size() % 2 == 0);
+    REQUIRE(std::ranges::find(requested, "vkCmdDrawIndexedIndirectCount") != requested.end());
+
+    REQUIRE(address(a.CmdBindPipeline) == device_a_entry);
+    REQUIRE(address(a.QueueSubmit2) == device_a_entry);
+    REQUIRE(address(b.CmdBindPipeline) == device_b_entry);
+    // unavailable functions stay empty instead of pointing at the loader
+    REQUIRE(a.QueuePresentKHR == nullptr);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+/**
+ *  @brief Function tables resolved straight from the driver.
+ *  Calls through the loader's exported vk* symbols go through a trampoline that looks up the
+ *  dispatch table of the handle on every call. These tables hold the ICD entry points instead,
+ *  one table per instance or device, so several devices can coexist.
+ *
+ *  The lists below generate the struct members and their loading code. A function whose version
+ *  or extension was not enabled is left nullptr.
+ */
+#define RENDER_API_INSTANCE_FUNCTIONS(X) \
+    X(DestroyInstance) \
+    X(EnumeratePhysicalDevices) \
+    X(EnumerateDeviceExtensionProperties) \
+    X(GetPhysicalDeviceProperties) \
+    X(GetPhysicalDeviceFeatures) \
+    X(GetPhysicalDeviceFeatures2) \
+    X(GetPhysicalDeviceFormatProperties) \
+    X(GetPhysicalDeviceMemoryProperties) \
+    X(GetPhysicalDeviceMemoryProperties2) \
+    X(GetPhysicalDeviceQueueFamilyProperties) \
+    X(GetPhysicalDeviceSurfaceSupportKHR) \
+    X(GetPhysicalDeviceSurfaceCapabilitiesKHR) \
+    X(GetPhysicalDeviceSurfaceFormatsKHR) \
+    X(GetPhysicalDeviceSurfacePresentModesKHR) \
+    X(DestroySurfaceKHR) \
+    X(CreateDevice) \
+    X(GetDeviceProcAddr)
+
+/// @brief Everything a frame calls: synchronization, submission, presentation and command recording.
+#define RENDER_API_DEVICE_FUNCTIONS(X) \
+    X(DestroyDevice) \
+    X(GetDeviceQueue) \
+    X(DeviceWaitIdle) \
+    X(WaitForFences) \
+    X(ResetFences) \
+    X(GetSemaphoreCounterValue) \
+    X(AcquireNextImageKHR) \
+    X(QueueSubmit2) \
+    X(QueuePresentKHR) \
+    X(ResetCommandBuffer) \
+    X(BeginCommandBuffer) \
+    X(EndCommandBuffer) \
+    X(AllocateDescriptorSets) \
+    X(ResetDescriptorPool) \
+    X(UpdateDescriptorSets) \
+    X(GetQueryPoolResults) \
+    X(InvalidateMappedMemoryRanges) \
+    X(CmdPipelineBarrier2) \
+    X(CmdResetQueryPool) \
+    X(CmdWriteTimestamp2) \
+    X(CmdFillBuffer) \
+    X(CmdCopyBuffer) \
+    X(CmdCopyImageToBuffer) \
+    X(CmdBeginRendering) \
+    X(CmdEndRendering) \
+    X(CmdBindPipeline) \
+    X(CmdBindDescriptorSets) \
+    X(CmdBindVertexBuffers) \
+    X(CmdBindIndexBuffer) \
+    X(CmdPushConstants) \
+    X(CmdSetViewport) \
+    X(CmdSetScissor) \
+    X(CmdDispatch) \
+    X(CmdDrawIndexed) \
+    X(CmdDrawIndexedIndirectCount)
+
+namespace render_api {
+
+#define RENDER_API_DECLARE_FUNCTION(name) PFN_vk##name name = nullptr;
+
+struct InstanceDispatch {
+    RENDER_API_INSTANCE_FUNCTIONS(RENDER_API_DECLARE_FUNCTION)
+
+    /// @brief Resolve every instance level function of `instance`, `get_proc_addr` is the loader's unless testing.
+    [[nodiscard]] static auto load(VkInstance instance, PFN_vkGetInstanceProcAddr get_proc_addr = vkGetInstanceProcAddr) -> InstanceDispatch;
+};
+
+struct DeviceDispatch {
+    RENDER_API_DEVICE_FUNCTIONS(RENDER_API_DECLARE_FUNCTION)
+
+    /// @brief Resolve every device level function of `device` through vkGetDeviceProcAddr, skipping the loader.
+    [[nodiscard]] static auto load(const InstanceDispatch& instance, VkDevice device) -> DeviceDispatch;
+};
+
+#undef RENDER_API_DECLARE_FUNCTION
+
+}
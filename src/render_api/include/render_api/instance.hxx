@@ -7,6 +7,7 @@
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_xcb.h>
 #include <render_api/deleters.hxx>
+#include <render_api/dispatch.hxx>
 
 namespace render_api {
 
@@ -22,6 +23,7 @@ namespace render_api {
 
     struct Instance {
         std::unique_ptr<VkInstance_T, VKEInstanceDeleter> instance;
+        InstanceDispatch dispatch; ///< InstanceDispatch::load(instance) once it was created
     };
 }
 
@@ -1,11 +1,13 @@
-#version 450
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uint fragTextureIndex;
 
 layout(location = 0) out vec4 outColor;
-layout(binding = 1) uniform sampler2D texSampler;
+layout(set = 1, binding = 0) uniform sampler2D textures[];
 
 void main() {
-    outColor = texture(texSampler, fragTexCoord);
+    outColor = texture(textures[nonuniformEXT(fragTextureIndex)], fragTexCoord);
 }
@@ -1,10 +1,26 @@
-#version 450
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
 
-layout(binding = 0) uniform UniformBufferObject {
-    mat4 model;
+// rewritten only when the camera or the swapchain extent changes
+layout(set = 0, binding = 0) uniform CameraMatrices {
     mat4 view;
     mat4 proj;
-} ubo;
+} camera;
+
+struct ObjectData {
+    mat4 model;
+    uint texture_index;
+};
+
+layout(std430, set = 1, binding = 1) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+} object_buffers[];
+
+layout(push_constant) uniform DrawPushConstants {
+    mat4 model;
+    uint object_buffer;
+    uint object_id;
+} draw;
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
@@ -12,9 +28,13 @@ layout(location = 2) in vec2 inTexCoord;
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureIndex;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    // firstInstance of indirect draws is the object index, direct draws push it instead
+    ObjectData object = object_buffers[draw.object_buffer].objects[draw.object_id + gl_InstanceIndex];
+    gl_Position = camera.proj * camera.view * draw.model * object.model * vec4(inPosition, 1.0);
     fragColor = inColor;
     fragTexCoord = inTexCoord;
+    fragTextureIndex = object.texture_index;
 }